@@ -149,6 +149,7 @@ typedef struct {
     int 	  outFile_crcsize;
     e_u32 	override_idx;
 	int		use_c_buffer;
+	struct mith_input_s *inFile_in; /* input file shared by all contexts */
 } cjpparam_t;
 
 /*******************************************************************************
@@ -108,6 +108,7 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include <stdlib.h> /* size_t */
 #include <string.h> /* strcmp, strcpy */
 #include "algo.h"
+#include "mith_workload.h"
 #if USE_PRESET
 /* Data files */
 #include "DavidAndDogs_bmp.h"
@@ -231,6 +232,12 @@ void *define_params_cjpeg(unsigned int idx, char *name, char *dataset) {
 	
     parse_dataset_cjpeg(dataset, params);
     init_files_cjpeg(params);	/* Create input and output RAM file */
+	/* the input is only read, so a file input is loaded once into a read only copy shared by all contexts */
+	if (!params->use_c_buffer && params->inFile_p!=NULL) {
+		params->inFile_in=mith_input_share(params->inFile_p,params->inFile_size);
+		th_free(params->inFile_p);
+		params->inFile_p=(e_u8 *)params->inFile_in->data;
+	}
     return params;
 }
 
@@ -337,7 +344,8 @@ int bmark_clean_cjpeg (void *in_params) {
     cjpparam_t	*params = (cjpparam_t *)in_params;
 
     if (params != NULL) {
-        if(!params->use_c_buffer && (params->inFile_p!=NULL)) th_free(params->inFile_p);
+        if(params->inFile_in!=NULL) mith_input_release(params->inFile_in);
+        else if(!params->use_c_buffer && (params->inFile_p!=NULL)) th_free(params->inFile_p);
         if(params->outFile_p!=NULL) th_free(params->outFile_p);
         th_free(params);
     }
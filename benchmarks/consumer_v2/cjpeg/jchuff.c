@@ -442,10 +442,10 @@ encode_one_block (working_state * state, JCOEFPTR block, int last_dc_val,
     temp = block[cjpeg_natural_order[k]];
     if (temp) {
       temps[nonzero_count] = temp;
-      iotas[nonzero_count] = zeros_count;
+      iotas[nonzero_count] = zero_count;
       nonzero_count += 1;
     } else {
-      zeros_count++;
+      zero_count++;
     }
   }
 #endif
@@ -56,6 +56,7 @@ list_head *core_list_insert_new(list_head *insert_point
 	, list_head *memblock_end, list_data *datablock_end);
 typedef ee_s32(*list_cmp)(list_data *a, list_data *b, core_results *res);
 list_head *core_list_mergesort(list_head *list, list_cmp cmp, core_results *res);
+static ee_u16 core_bench_list_soa(core_results *res, ee_s16 finder_idx);
 
 ee_s16 calc_func(ee_s16 *pdata, core_results *res) {
 	ee_s16 data=*pdata;
@@ -71,7 +72,7 @@ ee_s16 calc_func(ee_s16 *pdata, core_results *res) {
 			case 0:
 				if (dtype<0x22) /* set min period for bit corruption */
 					dtype=0x22;
-				retval=core_bench_state(res->size,(ee_u8 *)res->memblock[3],res->seed1,res->seed2,dtype,res->crc);
+				retval=core_bench_state(res->size,(ee_u8 *)res->memblock[3],res->seed1,res->seed2,dtype,res->crc,res->state_engine);
 				if (res->crcstate==0)
 					res->crcstate=retval;
 				break;
@@ -136,7 +137,10 @@ ee_u16 core_bench_list(core_results *res, ee_s16 finder_idx) {
 	list_data info;
 	ee_s16 i;
 
+	if (res->list_layout==LIST_LAYOUT_SOA)
+		return core_bench_list_soa(res,finder_idx);
 	info.idx=finder_idx;
+	info.data16=0;
 	/* find <find_num> values in the list, and change the list each time (reverse and cache if value found) */
 	for (i=0; i<find_num; i++) {
 		info.data16= (i & 0xff) ;
@@ -492,3 +496,306 @@ list_head *core_list_mergesort(list_head *list, list_cmp cmp, core_results *res)
 	return list;
 #endif
 }
+
+/* Topic: Index linked list
+	Alternate layout of the same list, selected with the -l1 dataset option.
+
+	Items are identified by their index in three arrays (next item, data and idx),
+	instead of list_head and list_data cells linked with pointers.
+	When the list is created, the items are placed in the arrays in the order of the sorted list.
+	Each call to <core_bench_list> returns the list to that order, so scans of the list
+	mostly walk through adjacent array elements, forward or backward.
+
+	The list operations are the same as for the pointer list, on the same items and in the
+	same order, including all calls to the compare functions, so all CRCs are the same.
+	Where the pointer list swaps info pointers, the data of the two items is swapped.
+*/
+
+/* Configuration: LIST_PREFETCH_AHEAD
+	Number of items ahead, in the direction the list is walked, to prefetch while scanning the list.
+	0 to disable.
+*/
+#ifndef LIST_PREFETCH_AHEAD
+#define LIST_PREFETCH_AHEAD 16
+#endif
+#if defined(__GNUC__) && LIST_PREFETCH_AHEAD
+#define LIST_PREFETCH(l,item,n) { \
+	ee_u32 ahead=(n)+((n)-(item))*LIST_PREFETCH_AHEAD; \
+	if (ahead<(l)->size) { \
+		__builtin_prefetch(&(l)->next[ahead]); \
+		__builtin_prefetch(&(l)->idx[ahead]); \
+	} \
+}
+#else
+#define LIST_PREFETCH(l,item,n)
+#endif
+
+typedef ee_s32(*list_soa_cmp)(list_soa *l, ee_u32 a, ee_u32 b, core_results *res);
+
+/* Function: cmp_complex_soa
+	<cmp_complex> for the index linked list.
+*/
+static ee_s32 cmp_complex_soa(list_soa *l, ee_u32 a, ee_u32 b, core_results *res) {
+	ee_s16 val1=calc_func(&(l->data16[a]),res);
+	ee_s16 val2=calc_func(&(l->data16[b]),res);
+	return val1 - val2;
+}
+
+/* Function: cmp_idx_soa
+	<cmp_idx> for the index linked list.
+*/
+static ee_s32 cmp_idx_soa(list_soa *l, ee_u32 a, ee_u32 b, core_results *res) {
+	if (res==NULL) {
+		l->data16[a] = (l->data16[a] & 0xff00) | (0x00ff & (l->data16[a]>>8));
+		l->data16[b] = (l->data16[b] & 0xff00) | (0x00ff & (l->data16[b]>>8));
+	}
+	return l->idx[a] - l->idx[b];
+}
+
+/* swap the data of two items */
+static void list_soa_swap(list_soa *l, ee_u32 a, ee_u32 b) {
+	ee_s16 tmp;
+	tmp=l->data16[a];
+	l->data16[a]=l->data16[b];
+	l->data16[b]=tmp;
+	tmp=l->idx[a];
+	l->idx[a]=l->idx[b];
+	l->idx[b]=tmp;
+}
+
+/* Function: core_list_find_soa
+	<core_list_find> for the index linked list.
+
+	Returns:
+	Found item, or LIST_NIL if not found.
+*/
+static ee_u32 core_list_find_soa(list_soa *l, ee_u32 item, list_data *info) {
+	ee_u32 *next=l->next, n;
+	if (info->idx>=0) {
+		ee_s16 *idx=l->idx;
+		while (item!=LIST_NIL && (idx[item] != info->idx)) {
+			n=next[item];
+			LIST_PREFETCH(l,item,n);
+			item=n;
+		}
+		return item;
+	} else {
+		ee_s16 *data16=l->data16;
+		while (item!=LIST_NIL && ((data16[item] & 0xff) != info->data16)) {
+			n=next[item];
+			LIST_PREFETCH(l,item,n);
+			item=n;
+		}
+		return item;
+	}
+}
+
+/* Function: core_list_reverse_soa
+	<core_list_reverse> for the index linked list.
+*/
+static ee_u32 core_list_reverse_soa(list_soa *l, ee_u32 item) {
+	ee_u32 *next=l->next, prev=LIST_NIL, tmp;
+	while (item!=LIST_NIL) {
+		tmp=next[item];
+		LIST_PREFETCH(l,item,tmp);
+		next[item]=prev;
+		prev=item;
+		item=tmp;
+	}
+	return prev;
+}
+
+/* Function: core_list_mergesort_soa
+	<core_list_mergesort> for the index linked list.
+	The same bottom up merges, on item indexes.
+*/
+static ee_u32 core_list_mergesort_soa(list_soa *l, ee_u32 list, list_soa_cmp cmp, core_results *res) {
+	ee_u32 *next=l->next;
+	ee_u32 p, q, e, tail;
+	ee_s32 insize, nmerges, psize, qsize, i;
+
+	insize = 1;
+	while (1) {
+		p = list;
+		list = LIST_NIL;
+		tail = LIST_NIL;
+		nmerges = 0;
+		while (p != LIST_NIL) {
+			nmerges++;
+			/* step `insize' places along from p */
+			q = p;
+			psize = 0;
+			for (i = 0; i < insize; i++) {
+				psize++;
+				q = next[q];
+				if (q == LIST_NIL) break;
+			}
+			qsize = insize;
+			/* merge the two lists */
+			while (psize > 0 || (qsize > 0 && q != LIST_NIL)) {
+				if (psize == 0) {
+					e = q; q = next[q]; qsize--;
+				} else if (qsize == 0 || q == LIST_NIL) {
+					e = p; p = next[p]; psize--;
+				} else if (cmp(l,p,q,res) <= 0) {
+					e = p; p = next[p]; psize--;
+				} else {
+					e = q; q = next[q]; qsize--;
+				}
+				if (tail != LIST_NIL)
+					next[tail] = e;
+				else
+					list = e;
+				tail = e;
+			}
+			p = q;
+		}
+		next[tail] = LIST_NIL;
+		if (nmerges <= 1)
+			return list;
+		insize *= 2;
+	}
+}
+
+/* Function: core_bench_list_soa
+	<core_bench_list> for the index linked list.
+*/
+static ee_u16 core_bench_list_soa(core_results *res, ee_s16 finder_idx) {
+	ee_u16 retval=0;
+	ee_u16 found=0,missed=0;
+	list_soa *l=&res->soa;
+	ee_u32 *next=l->next;
+	ee_s16 *data16=l->data16;
+	ee_u32 list=l->head;
+	ee_s16 find_num=res->seed3;
+	ee_u32 this_find, finder, remover, modified;
+	list_data info;
+	ee_s16 i;
+
+	info.idx=finder_idx;
+	info.data16=0;
+	/* find <find_num> values in the list, and change the list each time (reverse and cache if value found) */
+	for (i=0; i<find_num; i++) {
+		info.data16= (i & 0xff) ;
+		this_find=core_list_find_soa(l,list,&info);
+		list=core_list_reverse_soa(l,list);
+		if (this_find==LIST_NIL) {
+			missed++;
+			retval+=(data16[next[list]] >> 8) & 1;
+		}
+		else {
+			found++;
+			if (data16[this_find] & 0x1) /* use found value */
+				retval+=(data16[this_find] >> 9) & 1;
+			/* and cache next item at the head of the list (if any) */
+			if (next[this_find] != LIST_NIL) {
+				finder = next[this_find];
+				next[this_find] = next[finder];
+				next[finder] = next[list];
+				next[list] = finder;
+			}
+		}
+		if (info.idx>=0)
+			info.idx++;
+	}
+	retval+=found*4-missed;
+	/* sort the list by data content and remove one item */
+	if (finder_idx>0)
+		list=core_list_mergesort_soa(l,list,cmp_complex_soa,res);
+	modified=next[list];
+	remover=next[modified];
+	list_soa_swap(l,modified,remover);
+	next[modified]=next[remover];
+	next[remover]=LIST_NIL;
+	/* CRC data content of list from location of index N forward, and then undo remove */
+	finder=core_list_find_soa(l,list,&info);
+	if (finder==LIST_NIL)
+		finder=next[list];
+	while (finder!=LIST_NIL) {
+		retval=crc16(data16[list],retval);
+		finder=next[finder];
+	}
+	modified=next[list];
+	list_soa_swap(l,remover,modified);
+	next[remover]=next[modified];
+	next[modified]=remover;
+	/* sort the list by index, in effect returning the list to original state */
+	list=core_list_mergesort_soa(l,list,cmp_idx_soa,NULL);
+	/* CRC data content of list */
+	finder=next[list];
+	while (finder!=LIST_NIL) {
+		retval=crc16(data16[list],retval);
+		finder=next[finder];
+	}
+	return retval;
+}
+
+/* Function: core_list_init_soa
+	Initialize the index linked list with the same items as <core_list_init>.
+
+	The items are created in list order in a scratch copy of the arrays, sorted by idx,
+	and then copied to the arrays in sorted order.
+	The arrays and the scratch copy take 16 bytes per item,
+	which fits in the memory block sized for the pointer list.
+
+	Parameters:
+	blksize - Number of list items the memory block was sized for.
+	memblock - Pointer to memory block.
+	seed - 	Actual values chosen depend on the seed parameter.
+	l - The list.
+*/
+void core_list_init_soa(ee_u32 blksize, void *memblock, ee_s16 seed, list_soa *l) {
+	ee_u32 size=blksize;
+	/* core_list_init has room for the head, the tail and size-3 items */
+	ee_u32 items=(size>=3) ? size-3 : 0;
+	ee_u32 n=(size>=3) ? items+2 : 1;
+	ee_u32 i, pos, item;
+	list_soa tmp;
+	char *mem=(char *)align_mem(memblock);
+
+	l->head=0;
+	l->size=n;
+	l->next=(ee_u32 *)mem;
+	tmp.next=l->next+n;
+	l->data16=(ee_s16 *)(tmp.next+n);
+	l->idx=l->data16+n;
+	tmp.data16=l->idx+n;
+	tmp.idx=tmp.data16+n;
+	tmp.size=n;
+
+	/* the head, items inserted after the head, most recent first, and the tail */
+	tmp.idx[0]=0x0000;
+	tmp.data16[0]=(ee_s16)0x8080;
+	for (pos=1; pos<=items; pos++) {
+		ee_u32 ii=items-pos;
+		ee_u16 datpat=((ee_u16)(seed^ii) & 0xf);
+		ee_u16 dat=(datpat<<3) | (ii&0x7); /* alternate between algorithms */
+		tmp.data16[pos]=(dat<<8) | dat;
+	}
+	if (n>1) {
+		tmp.idx[n-1]=0x7fff;
+		tmp.data16[n-1]=(ee_s16)0xffff;
+	}
+	for (pos=0; pos<n; pos++)
+		tmp.next[pos]=pos+1;
+	tmp.next[n-1]=LIST_NIL;
+	/* and now index the list so we know initial seed order of the list */
+	i=1;
+	for (pos=1; pos+1<n; pos++) {
+		if (i<size/5) /* first 20% of the list in order */
+			tmp.idx[pos]=i++;
+		else {
+			ee_u16 pat=(ee_u16)(i++ ^ seed); /* get a pseudo random number */
+			tmp.idx[pos]=0x3fff & (((i & 0x07) << 8) | pat); /* make sure the mixed items end up after the ones in sequence */
+		}
+	}
+	item=core_list_mergesort_soa(&tmp,0,cmp_idx_soa,NULL);
+	/* place the items in sorted order */
+	for (pos=0; pos<n; pos++) {
+		l->data16[pos]=tmp.data16[item];
+		l->idx[pos]=tmp.idx[item];
+		l->next[pos]=pos+1;
+		item=tmp.next[item];
+	}
+	l->next[n-1]=LIST_NIL;
+}
@@ -30,13 +30,21 @@ Topic: Description
 
 	The actual values for A and B must be derived based on input that is not available at compile time.
 */
-ee_s16 matrix_test(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, MATDAT val);
+ee_s16 matrix_test(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, MATDAT val, ee_u32 engine);
 ee_s16 matrix_sum(ee_u32 N, MATRES *C, MATDAT clipval);
 void matrix_mul_const(ee_u32 N, MATRES *C, MATDAT *A, MATDAT val);
 void matrix_mul_vect(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B);
 void matrix_mul_matrix(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B);
 void matrix_mul_matrix_bitextract(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B);
 void matrix_add_const(ee_u32 N, MATDAT *A, MATDAT val);
+/* multiply kernels of an engine, see <core_matrix_engine> */
+typedef struct mat_kernels_s {
+	const char *name;
+	void (*mul_vect)(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B);
+	void (*mul_matrix)(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B);
+	void (*mul_matrix_bitextract)(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B);
+} mat_kernels;
+static const mat_kernels *matrix_kernels(ee_u32 engine);
 
 #define matrix_test_next(x) (x+1)
 #define matrix_clip(x,y) ((y) ? (x) & 0x0ff : (x) & 0x0ffff)
@@ -82,7 +90,7 @@ ee_u16 core_bench_matrix(mat_params *p, ee_s16 seed, ee_u16 crc) {
 	MATDAT *B=p->B;
 	MATDAT val=(MATDAT)seed;
 
-	crc=crc16(matrix_test(N,C,A,B,val),crc);
+	crc=crc16(matrix_test(N,C,A,B,val,p->engine),crc);
 
 	return crc;
 }
@@ -95,6 +103,7 @@ ee_u16 core_bench_matrix(mat_params *p, ee_s16 seed, ee_u16 crc) {
 	C - memory for result matrix.
 	A - input matrix
 	B - operator matrix (not changed during operations)
+	engine - engine of the multiply kernels
 
 	Returns:
 	A CRC value that captures all results calculated in the function.
@@ -111,7 +120,8 @@ ee_u16 core_bench_matrix(mat_params *p, ee_s16 seed, ee_u16 crc) {
 
 	After the last step, matrix A is back to original contents.
 */
-ee_s16 matrix_test(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, MATDAT val) {
+ee_s16 matrix_test(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, MATDAT val, ee_u32 engine) {
+	const mat_kernels *k=matrix_kernels(engine);
 	ee_u16 crc=0;
 	MATDAT clipval=matrix_big(val);
 
@@ -124,17 +134,17 @@ ee_s16 matrix_test(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, MATDAT val) {
 #if CORE_DEBUG
 	printmatC(C,N,"matrix_mul_const");
 #endif
-	matrix_mul_vect(N,C,A,B);
+	k->mul_vect(N,C,A,B);
 	crc=crc16(matrix_sum(N,C,clipval),crc);
 #if CORE_DEBUG
 	printmatC(C,N,"matrix_mul_vect");
 #endif
-	matrix_mul_matrix(N,C,A,B);
+	k->mul_matrix(N,C,A,B);
 	crc=crc16(matrix_sum(N,C,clipval),crc);
 #if CORE_DEBUG
 	printmatC(C,N,"matrix_mul_matrix");
 #endif
-	matrix_mul_matrix_bitextract(N,C,A,B);
+	k->mul_matrix_bitextract(N,C,A,B);
 	crc=crc16(matrix_sum(N,C,clipval),crc);
 #if CORE_DEBUG
 	printmatC(C,N,"matrix_mul_matrix_bitextract");
@@ -194,6 +204,7 @@ ee_u32 core_init_matrix(ee_u32 blksize, void *memblk, ee_s32 seed, mat_params *p
 	p->B=B;
 	p->C=(MATRES *)align_mem(B+N*N);
 	p->N=N;
+	p->engine=core_matrix_engine();
 #if CORE_DEBUG
 	printmat(A,N,"A");
 	printmat(B,N,"B");
@@ -304,3 +315,492 @@ void matrix_mul_matrix_bitextract(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B) {
 		}
 	}
 }
+
+/* Topic: SIMD engines
+	Tiled versions of <matrix_mul_vect>, <matrix_mul_matrix> and <matrix_mul_matrix_bitextract>
+	built on 16 bit multiply accumulate instructions.
+
+	Sums of products are kept in 32 bits and wrap like the reference loops, 
+	so the order of the additions does not change the results and crcmatrix stays the same.
+
+	x86 engines (pmaddwd, or vpdpwssd for vnni) multiply two consecutive k of a row of A 
+	with the interleaved rows k and k+1 of B, so a vector covers a block of columns of C 
+	without transposing B. Two rows of C are done together, and the k loop is split 
+	in blocks of MATRIX_TILE_K so the block of B stays in the cache for all the rows.
+	Only the low 12 bits of a product are used by the bit extract, 
+	so its products are done in 16 bits (pmullw) and the extracted terms summed in 16 bits 
+	for up to MATRIX_BITX_K values of k before they are added to the 32 bit sums.
+	Columns left over by an engine are done by the next narrower one, then by plain loops.
+	The upper halves of the registers are cleared before that, legacy sse code is slow
+	while they are in use.
+
+	rvv uses widening multiply accumulate (vwmacc, vwmaccu) on a row of B at a time, 
+	and a widening multiply with a reduction for <matrix_mul_vect>.
+*/
+#define MATRIX_ENGINE_NONE		0
+#define MATRIX_ENGINE_SSE2		1
+#define MATRIX_ENGINE_AVX2		2
+#define MATRIX_ENGINE_AVX512	3
+#define MATRIX_ENGINE_VNNI		4
+#define MATRIX_ENGINE_RVV		5
+#define MATRIX_ENGINE_MAX		5
+
+#ifndef MATRIX_TILE_K
+#define MATRIX_TILE_K 256
+#endif
+/* 16 bit sums of up to 34 terms of at most 15*127 do not overflow */
+#define MATRIX_BITX_K 32
+
+#if CORE_MATRIX_SIMD && MATDAT_INT && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIX_X86 1
+#include <immintrin.h>
+#else
+#define MATRIX_X86 0
+#endif
+#if CORE_MATRIX_SIMD && MATDAT_INT && defined(USE_RVV) && USE_RVV
+#define MATRIX_RVV 1
+#else
+#define MATRIX_RVV 0
+#endif
+
+#if MATRIX_X86
+/* plain loops for the columns or elements an engine did not do */
+static ee_s32 matrix_dot_ref(const MATDAT *a, const MATDAT *b, ee_u32 n) {
+	ee_u32 j, sum=0;
+	for (j=0; j<n; j++)
+		sum+=(ee_u32)((MATRES)a[j] * (MATRES)b[j]);
+	return (ee_s32)sum;
+}
+static ee_u32 matrix_mm_cols_ref(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, ee_u32 j0) {
+	ee_u32 i,j,k;
+	for (i=0; i<N; i++) {
+		for (j=j0; j<N; j++) {
+			C[i*N+j]=0;
+			for(k=0;k<N;k++)
+				C[i*N+j]+=(MATRES)A[i*N+k] * (MATRES)B[k*N+j];
+		}
+	}
+	return N;
+}
+static ee_u32 matrix_bx_cols_ref(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, ee_u32 j0) {
+	ee_u32 i,j,k;
+	for (i=0; i<N; i++) {
+		for (j=j0; j<N; j++) {
+			C[i*N+j]=0;
+			for(k=0;k<N;k++) {
+				MATRES tmp=(MATRES)A[i*N+k] * (MATRES)B[k*N+j];
+				C[i*N+j]+=bit_extract(tmp,2,4)*bit_extract(tmp,5,7);
+			}
+		}
+	}
+	return N;
+}
+
+/* a0 in the low half, so it multiplies row k of B in the interleaved rows */
+#define MATRIX_PAIR(a0,a1)	((ee_s32)(((ee_u32)(ee_u16)(a1)<<16) | (ee_u32)(ee_u16)(a0)))
+
+/* dot product of a and b, n elements */
+#define MATRIX_DOT_BODY(narrow) { \
+	vi_t acc; \
+	ee_u32 j; \
+	ee_u32 sum; \
+	if (n<M_W) \
+		return narrow(a,b,n); \
+	acc=M_ZERO(); \
+	for (j=0; j+M_W<=n; j+=M_W) \
+		acc=M_MADD(acc,M_LOAD(a+j),M_LOAD(b+j)); \
+	sum=(ee_u32)M_HSUM(acc); \
+	if (j==n) \
+		return (ee_s32)sum; \
+	M_ZEROUPPER(); \
+	return (ee_s32)(sum + (ee_u32)narrow(a+j,b+j,n-j)); \
+}
+
+/* columns from j0 in blocks of M_W, returns the value of the narrower engine for the rest */
+#define MATRIX_MM_COLS_BODY(narrow) { \
+	ee_u32 i,j,k,kb,ke; \
+	ee_u32 jn=j0+((N-j0)/M_W)*M_W; \
+	vi_t z; \
+	if (jn==j0) \
+		return narrow(N,C,A,B,j0); \
+	z=M_ZERO(); \
+	for (kb=0; kb<N; kb=ke) { \
+		ke=(N-kb>MATRIX_TILE_K) ? kb+MATRIX_TILE_K : N; \
+		for (j=j0; j<jn; j+=M_W) { \
+			for (i=0; i<N; i+=2) { \
+				const MATDAT *a0=A+i*N, *a1=(i+1<N) ? a0+N : a0; \
+				vi_t lo0=z, hi0=z, lo1=z, hi1=z; \
+				for (k=kb; k+1<ke; k+=2) { \
+					vi_t b0=M_LOAD(B+k*N+j), b1=M_LOAD(B+(k+1)*N+j); \
+					vi_t bl=M_UNPACKLO16(b0,b1), bh=M_UNPACKHI16(b0,b1); \
+					vi_t p0=M_SET1_32(MATRIX_PAIR(a0[k],a0[k+1])); \
+					vi_t p1=M_SET1_32(MATRIX_PAIR(a1[k],a1[k+1])); \
+					lo0=M_MADD(lo0,bl,p0); hi0=M_MADD(hi0,bh,p0); \
+					lo1=M_MADD(lo1,bl,p1); hi1=M_MADD(hi1,bh,p1); \
+				} \
+				if (k<ke) { /* odd N, the last k is paired with a 0 */ \
+					vi_t b0=M_LOAD(B+k*N+j); \
+					vi_t bl=M_UNPACKLO16(b0,z), bh=M_UNPACKHI16(b0,z); \
+					vi_t p0=M_SET1_32(MATRIX_PAIR(a0[k],0)); \
+					vi_t p1=M_SET1_32(MATRIX_PAIR(a1[k],0)); \
+					lo0=M_MADD(lo0,bl,p0); hi0=M_MADD(hi0,bh,p0); \
+					lo1=M_MADD(lo1,bl,p1); hi1=M_MADD(hi1,bh,p1); \
+				} \
+				M_STORE_PAIRS(C+i*N+j,lo0,hi0,kb); \
+				if (i+1<N) \
+					M_STORE_PAIRS(C+(i+1)*N+j,lo1,hi1,kb); \
+			} \
+		} \
+	} \
+	if (jn==N) \
+		return N; \
+	M_ZEROUPPER(); \
+	return narrow(N,C,A,B,jn); \
+}
+
+/* bit_extract(p,2,4)*bit_extract(p,5,7) of each 16 bit product */
+#define MATRIX_BITX(p)	M_MULLO16(M_AND(M_SRLI16(p,2),m15),M_AND(M_SRLI16(p,5),m127))
+#define MATRIX_BX_COLS_BODY(narrow) { \
+	ee_u32 i,j,k,kb,ke,kc; \
+	ee_u32 jn=j0+((N-j0)/M_W)*M_W; \
+	vi_t z, m15, m127; \
+	if (jn==j0) \
+		return narrow(N,C,A,B,j0); \
+	z=M_ZERO(); m15=M_SET1_16(0xf); m127=M_SET1_16(0x7f); \
+	for (kb=0; kb<N; kb=ke) { \
+		ke=(N-kb>MATRIX_TILE_K) ? kb+MATRIX_TILE_K : N; \
+		for (j=j0; j<jn; j+=M_W) { \
+			for (i=0; i<N; i+=2) { \
+				const MATDAT *a0=A+i*N, *a1=(i+1<N) ? a0+N : a0; \
+				vi_t lo0=z, hi0=z, lo1=z, hi1=z; \
+				for (k=kb; k<ke; ) { \
+					vi_t s0=z, s1=z; \
+					kc=(ke-k>MATRIX_BITX_K) ? k+MATRIX_BITX_K : ke; \
+					for (; k<kc; k++) { \
+						vi_t b=M_LOAD(B+k*N+j); \
+						vi_t p0=M_MULLO16(b,M_SET1_16(a0[k])), p1=M_MULLO16(b,M_SET1_16(a1[k])); \
+						s0=M_ADD16(s0,MATRIX_BITX(p0)); \
+						s1=M_ADD16(s1,MATRIX_BITX(p1)); \
+					} \
+					lo0=M_ADD32(lo0,M_UNPACKLO16(s0,z)); hi0=M_ADD32(hi0,M_UNPACKHI16(s0,z)); \
+					lo1=M_ADD32(lo1,M_UNPACKLO16(s1,z)); hi1=M_ADD32(hi1,M_UNPACKHI16(s1,z)); \
+				} \
+				M_STORE_PAIRS(C+i*N+j,lo0,hi0,kb); \
+				if (i+1<N) \
+					M_STORE_PAIRS(C+(i+1)*N+j,lo1,hi1,kb); \
+			} \
+		} \
+	} \
+	if (jn==N) \
+		return N; \
+	M_ZEROUPPER(); \
+	return narrow(N,C,A,B,jn); \
+}
+
+/* the functions of an engine, sfx is the engine and nsfx the next narrower one */
+#define MATRIX_ENGINE_FUNCS(attr,sfx,nsfx) \
+attr static ee_s32 matrix_dot_##sfx(const MATDAT *a, const MATDAT *b, ee_u32 n) \
+	MATRIX_DOT_BODY(matrix_dot_##nsfx) \
+attr static ee_u32 matrix_mm_cols_##sfx(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, ee_u32 j0) \
+	MATRIX_MM_COLS_BODY(matrix_mm_cols_##nsfx) \
+attr static ee_u32 matrix_bx_cols_##sfx(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B, ee_u32 j0) \
+	MATRIX_BX_COLS_BODY(matrix_bx_cols_##nsfx) \
+static void matrix_mul_vect_##sfx(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B) { \
+	ee_u32 i; \
+	for (i=0; i<N; i++) \
+		C[i]=matrix_dot_##sfx(A+i*N,B,N); \
+} \
+static void matrix_mul_matrix_##sfx(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B) { \
+	matrix_mm_cols_##sfx(N,C,A,B,0); \
+} \
+static void matrix_mul_matrix_bitextract_##sfx(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B) { \
+	matrix_bx_cols_##sfx(N,C,A,B,0); \
+}
+
+/* sse2 engine, 8 columns */
+#define vi_t				__m128i
+#define M_W					8
+#define M_ZERO()			_mm_setzero_si128()
+#define M_LOAD(p)			_mm_loadu_si128((const __m128i *)(p))
+#define M_SET1_32(x)		_mm_set1_epi32(x)
+#define M_SET1_16(x)		_mm_set1_epi16(x)
+#define M_UNPACKLO16(x,y)	_mm_unpacklo_epi16(x,y)
+#define M_UNPACKHI16(x,y)	_mm_unpackhi_epi16(x,y)
+#define M_MADD(acc,x,y)		_mm_add_epi32(acc,_mm_madd_epi16(x,y))
+#define M_ADD32(x,y)		_mm_add_epi32(x,y)
+#define M_ADD16(x,y)		_mm_add_epi16(x,y)
+#define M_MULLO16(x,y)		_mm_mullo_epi16(x,y)
+#define M_SRLI16(x,n)		_mm_srli_epi16(x,n)
+#define M_AND(x,y)			_mm_and_si128(x,y)
+#define M_HSUM(x)			matrix_hsum_sse2(x)
+#define M_ZEROUPPER()
+/* the unpacked halves are already in column order */
+#define M_STORE_PAIRS(c,lo,hi,kb) { \
+	vi_t o0=lo, o1=hi; \
+	if (kb) { \
+		o0=M_ADD32(o0,M_LOAD(c)); \
+		o1=M_ADD32(o1,M_LOAD((c)+4)); \
+	} \
+	_mm_storeu_si128((__m128i *)(c),o0); \
+	_mm_storeu_si128((__m128i *)((c)+4),o1); \
+}
+__attribute__((target("sse2"))) static inline ee_s32 matrix_hsum_sse2(__m128i x) {
+	x=_mm_add_epi32(x,_mm_shuffle_epi32(x,0x4e));
+	x=_mm_add_epi32(x,_mm_shuffle_epi32(x,0xb1));
+	return _mm_cvtsi128_si32(x);
+}
+MATRIX_ENGINE_FUNCS(__attribute__((target("sse2"))),sse2,ref)
+#undef vi_t
+#undef M_W
+#undef M_ZERO
+#undef M_LOAD
+#undef M_SET1_32
+#undef M_SET1_16
+#undef M_UNPACKLO16
+#undef M_UNPACKHI16
+#undef M_MADD
+#undef M_ADD32
+#undef M_ADD16
+#undef M_MULLO16
+#undef M_SRLI16
+#undef M_AND
+#undef M_HSUM
+#undef M_ZEROUPPER
+#undef M_STORE_PAIRS
+
+/* avx2 engine, 16 columns. unpack works within 128 bit lanes, 
+	so lo has columns 0-3 and 8-11, hi has 4-7 and 12-15 */
+#define vi_t				__m256i
+#define M_W					16
+#define M_ZERO()			_mm256_setzero_si256()
+#define M_LOAD(p)			_mm256_loadu_si256((const __m256i *)(p))
+#define M_SET1_32(x)		_mm256_set1_epi32(x)
+#define M_SET1_16(x)		_mm256_set1_epi16(x)
+#define M_UNPACKLO16(x,y)	_mm256_unpacklo_epi16(x,y)
+#define M_UNPACKHI16(x,y)	_mm256_unpackhi_epi16(x,y)
+#define M_MADD(acc,x,y)		_mm256_add_epi32(acc,_mm256_madd_epi16(x,y))
+#define M_ADD32(x,y)		_mm256_add_epi32(x,y)
+#define M_ADD16(x,y)		_mm256_add_epi16(x,y)
+#define M_MULLO16(x,y)		_mm256_mullo_epi16(x,y)
+#define M_SRLI16(x,n)		_mm256_srli_epi16(x,n)
+#define M_AND(x,y)			_mm256_and_si256(x,y)
+#define M_HSUM(x)			matrix_hsum_sse2(_mm_add_epi32(_mm256_castsi256_si128(x),_mm256_extracti128_si256(x,1)))
+#define M_ZEROUPPER()		_mm256_zeroupper()
+#define M_STORE_PAIRS(c,lo,hi,kb) { \
+	vi_t o0=_mm256_permute2x128_si256(lo,hi,0x20), o1=_mm256_permute2x128_si256(lo,hi,0x31); \
+	if (kb) { \
+		o0=M_ADD32(o0,M_LOAD(c)); \
+		o1=M_ADD32(o1,M_LOAD((c)+8)); \
+	} \
+	_mm256_storeu_si256((__m256i *)(c),o0); \
+	_mm256_storeu_si256((__m256i *)((c)+8),o1); \
+}
+MATRIX_ENGINE_FUNCS(__attribute__((target("avx2"))),avx2,sse2)
+#undef M_MADD
+#undef M_HSUM
+#undef M_ZEROUPPER
+#undef M_STORE_PAIRS
+#undef vi_t
+#undef M_W
+#undef M_ZERO
+#undef M_LOAD
+#undef M_SET1_32
+#undef M_SET1_16
+#undef M_UNPACKLO16
+#undef M_UNPACKHI16
+#undef M_ADD32
+#undef M_ADD16
+#undef M_MULLO16
+#undef M_SRLI16
+#undef M_AND
+
+/* avx512 engines, 32 columns. lo has columns 0-3, 8-11, 16-19 and 24-27 */
+#define vi_t				__m512i
+#define M_W					32
+#define M_ZERO()			_mm512_setzero_si512()
+#define M_LOAD(p)			_mm512_loadu_si512((const void *)(p))
+#define M_SET1_32(x)		_mm512_set1_epi32(x)
+#define M_SET1_16(x)		_mm512_set1_epi16(x)
+#define M_UNPACKLO16(x,y)	_mm512_unpacklo_epi16(x,y)
+#define M_UNPACKHI16(x,y)	_mm512_unpackhi_epi16(x,y)
+#define M_ADD32(x,y)		_mm512_add_epi32(x,y)
+#define M_ADD16(x,y)		_mm512_add_epi16(x,y)
+#define M_MULLO16(x,y)		_mm512_mullo_epi16(x,y)
+#define M_SRLI16(x,n)		_mm512_srli_epi16(x,n)
+#define M_AND(x,y)			_mm512_and_si512(x,y)
+#define M_HSUM(x)			_mm512_reduce_add_epi32(x)
+#define M_ZEROUPPER()		_mm256_zeroupper()
+#define M_STORE_PAIRS(c,lo,hi,kb) { \
+	vi_t o0=_mm512_permutex2var_epi64(lo,_mm512_setr_epi64(0,1,8,9,2,3,10,11),hi); \
+	vi_t o1=_mm512_permutex2var_epi64(lo,_mm512_setr_epi64(4,5,12,13,6,7,14,15),hi); \
+	if (kb) { \
+		o0=M_ADD32(o0,M_LOAD(c)); \
+		o1=M_ADD32(o1,M_LOAD((c)+16)); \
+	} \
+	_mm512_storeu_si512((void *)(c),o0); \
+	_mm512_storeu_si512((void *)((c)+16),o1); \
+}
+#define M_MADD(acc,x,y)		_mm512_add_epi32(acc,_mm512_madd_epi16(x,y))
+MATRIX_ENGINE_FUNCS(__attribute__((target("avx512f,avx512bw"))),avx512,avx2)
+#undef M_MADD
+/* vpdpwssd adds the pairs to the sums in one instruction, without saturation */
+#define M_MADD(acc,x,y)		_mm512_dpwssd_epi32(acc,x,y)
+MATRIX_ENGINE_FUNCS(__attribute__((target("avx512f,avx512bw,avx512vnni"))),vnni,avx2)
+#undef M_MADD
+#undef M_HSUM
+#undef M_ZEROUPPER
+#undef M_STORE_PAIRS
+#undef vi_t
+#undef M_W
+#undef M_ZERO
+#undef M_LOAD
+#undef M_SET1_32
+#undef M_SET1_16
+#undef M_UNPACKLO16
+#undef M_UNPACKHI16
+#undef M_ADD32
+#undef M_ADD16
+#undef M_MULLO16
+#undef M_SRLI16
+#undef M_AND
+#endif /* MATRIX_X86 */
+
+#if MATRIX_RVV
+static void matrix_mul_vect_rvv(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B) {
+	ee_u32 i,j;
+	size_t vl;
+	for (i=0; i<N; i++) {
+		vint32m1_t sum=__riscv_vmv_s_x_i32m1(0,1);
+		for (j=0; j<N; j+=vl) {
+			vl=__riscv_vsetvl_e16m2(N-j);
+			vint16m2_t a=__riscv_vle16_v_i16m2((const int16_t *)A+i*N+j,vl);
+			vint16m2_t b=__riscv_vle16_v_i16m2((const int16_t *)B+j,vl);
+			sum=__riscv_vredsum_vs_i32m4_i32m1(__riscv_vwmul_vv_i32m4(a,b,vl),sum,vl);
+		}
+		C[i]=__riscv_vmv_x_s_i32m1_i32(sum);
+	}
+}
+/* a block of columns of a row of C, one row of B at a time */
+static void matrix_mul_matrix_rvv(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B) {
+	ee_u32 i,j,k,kb,ke;
+	size_t vl;
+	for (kb=0; kb<N; kb=ke) {
+		ke=(N-kb>MATRIX_TILE_K) ? kb+MATRIX_TILE_K : N;
+		for (j=0; j<N; j+=vl) {
+			vl=__riscv_vsetvl_e16m2(N-j);
+			for (i=0; i<N; i++) {
+				vint32m4_t acc=kb ? __riscv_vle32_v_i32m4((const int32_t *)C+i*N+j,vl) : __riscv_vmv_v_x_i32m4(0,vl);
+				for (k=kb; k<ke; k++)
+					acc=__riscv_vwmacc_vx_i32m4(acc,A[i*N+k],__riscv_vle16_v_i16m2((const int16_t *)B+k*N+j,vl),vl);
+				__riscv_vse32_v_i32m4((int32_t *)C+i*N+j,acc,vl);
+			}
+		}
+	}
+}
+static void matrix_mul_matrix_bitextract_rvv(ee_u32 N, MATRES *C, MATDAT *A, MATDAT *B) {
+	ee_u32 i,j,k,kb,ke;
+	size_t vl;
+	for (kb=0; kb<N; kb=ke) {
+		ke=(N-kb>MATRIX_TILE_K) ? kb+MATRIX_TILE_K : N;
+		for (j=0; j<N; j+=vl) {
+			vl=__riscv_vsetvl_e16m2(N-j);
+			for (i=0; i<N; i++) {
+				vuint32m4_t acc=kb ? __riscv_vle32_v_u32m4((const uint32_t *)C+i*N+j,vl) : __riscv_vmv_v_x_u32m4(0,vl);
+				for (k=kb; k<ke; k++) {
+					vuint16m2_t p=__riscv_vmul_vx_u16m2(__riscv_vle16_v_u16m2((const uint16_t *)B+k*N+j,vl),(uint16_t)A[i*N+k],vl);
+					vuint16m2_t x=__riscv_vand_vx_u16m2(__riscv_vsrl_vx_u16m2(p,2,vl),0xf,vl);
+					vuint16m2_t y=__riscv_vand_vx_u16m2(__riscv_vsrl_vx_u16m2(p,5,vl),0x7f,vl);
+					acc=__riscv_vwmaccu_vv_u32m4(acc,x,y,vl);
+				}
+				__riscv_vse32_v_u32m4((uint32_t *)C+i*N+j,acc,vl);
+			}
+		}
+	}
+}
+#endif /* MATRIX_RVV */
+
+static const mat_kernels matrix_engines[MATRIX_ENGINE_MAX+1]={
+	{"none",matrix_mul_vect,matrix_mul_matrix,matrix_mul_matrix_bitextract},
+#if MATRIX_X86
+	{"sse2",matrix_mul_vect_sse2,matrix_mul_matrix_sse2,matrix_mul_matrix_bitextract_sse2},
+	{"avx2",matrix_mul_vect_avx2,matrix_mul_matrix_avx2,matrix_mul_matrix_bitextract_avx2},
+	{"avx512",matrix_mul_vect_avx512,matrix_mul_matrix_avx512,matrix_mul_matrix_bitextract_avx512},
+	{"avx512vnni",matrix_mul_vect_vnni,matrix_mul_matrix_vnni,matrix_mul_matrix_bitextract_vnni},
+#else
+	{NULL},{NULL},{NULL},{NULL},
+#endif
+#if MATRIX_RVV
+	{"rvv",matrix_mul_vect_rvv,matrix_mul_matrix_rvv,matrix_mul_matrix_bitextract_rvv},
+#else
+	{NULL},
+#endif
+};
+static const mat_kernels *matrix_kernels(ee_u32 engine) {
+	if (engine>MATRIX_ENGINE_MAX || matrix_engines[engine].name==NULL)
+		engine=MATRIX_ENGINE_NONE;
+	return &matrix_engines[engine];
+}
+
+/* Function: core_matrix_engine
+	Select the engine of the matrix multiply kernels.
+	
+	Returns:
+	The widest engine up to <CORE_MATRIX_SIMD> that the processor supports.
+*/
+ee_u32 core_matrix_engine(void) {
+	ee_u32 engine=MATRIX_ENGINE_NONE;
+#if MATRIX_X86
+	__builtin_cpu_init();
+	if (CORE_MATRIX_SIMD>=MATRIX_ENGINE_VNNI && __builtin_cpu_supports("avx512vnni") &&
+		__builtin_cpu_supports("avx512bw"))
+		engine=MATRIX_ENGINE_VNNI;
+	else if (CORE_MATRIX_SIMD>=MATRIX_ENGINE_AVX512 && __builtin_cpu_supports("avx512bw"))
+		engine=MATRIX_ENGINE_AVX512;
+	else if (CORE_MATRIX_SIMD>=MATRIX_ENGINE_AVX2 && __builtin_cpu_supports("avx2"))
+		engine=MATRIX_ENGINE_AVX2;
+	else if (__builtin_cpu_supports("sse2"))
+		engine=MATRIX_ENGINE_SSE2;
+#elif MATRIX_RVV
+	engine=MATRIX_ENGINE_RVV;
+#endif
+	return engine;
+}
+const char *core_matrix_engine_name(ee_u32 engine) {
+	return matrix_kernels(engine)->name;
+}
+
+/* Function: core_matrix_sweep
+	Matrix size / throughput curve.
+	Time <matrix_test> for matrix sizes from 4 up to maxn, in steps of about 1.5x,
+	and print the memory used and the multiply accumulate rate for each size.
+	Each size is repeated for at least 0.1 seconds.
+*/
+void core_matrix_sweep(char *name, ee_u32 maxn, ee_s32 seed) {
+	ee_u32 n, step=0;
+	size_t tps=th_ticks_per_sec();
+	th_printf("-- %s:matrix(engine)=%s\n",name,core_matrix_engine_name(core_matrix_engine()));
+	for (n=4; n<=maxn; n=(step++ & 1) ? n*4/3 : n*3/2) {
+		mat_params mp;
+		ee_u32 bytes=n*n*(2*sizeof(MATDAT)+sizeof(MATRES));
+		void *mem=th_malloc(bytes+16);
+		size_t start, ticks;
+		ee_u32 reps=0;
+		double macs;
+		if (mem==NULL) {
+			th_printf("-- %s:matrix%u(bytes)=%u not available\n",name,n,bytes);
+			break;
+		}
+		core_init_matrix(bytes,mem,seed,&mp,n);
+		start=th_signal_now();
+		do {
+			matrix_test(n,mp.C,mp.A,mp.B,(MATDAT)(seed+reps),mp.engine);
+			reps++;
+			ticks=th_signal_now()-start;
+		} while (ticks<tps/10);
+		/* the two matrix products, the vector product and the product with a constant */
+		macs=((double)n*n*n*2+(double)n*n*2)*reps;
+		th_printf("-- %s:matrix%u(bytes)=%u\n",name,n,bytes);
+		th_printf("-- %s:matrix%u(MMAC/s)=%8g\n",name,n,macs*tps/(double)(ticks ? ticks : 1)*1e-6);
+		th_free(mem);
+	}
+}
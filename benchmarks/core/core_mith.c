@@ -19,6 +19,7 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include "th_cfg.h"
 #include "th_lib.h"
 #include "th_rand.h" /* initialize a random data vector */
+#include "mith_workload.h"
 #include "coremark.h"
 #include "core_mith.h"
 
@@ -32,6 +33,16 @@ core_params presets_core[] = {
 	{0x33,0x33,0x33,10,512,4,100 ,0,NULL,2,
 	{0x3d49,0x5b1,0x7eb,0xd135}}
 ,
+	/* cache footprints for mixed workloads : L1 resident, L2 sized and memory bound list */
+	{0x3415,0x3415,0x66,64,2048,16,2000 ,0,NULL,3,
+	{0xe040,0x464c,0xdf4a,0x2d33}}
+,
+	{0x3415,0x3415,0x66,8192,16384,32,4 ,0,NULL,4,
+	{0x1ed8,0xdbbf,0xaa66,0x2fe0}}
+,
+	{0x3415,0x3415,0x66,262144,2048,9,1 ,0,NULL,5,
+	{0x1721,0xf095,0x2cfb,0x1721}}
+,
 
 };
 
@@ -56,22 +67,35 @@ void *bmark_fini_core(void *in_params);
 
 /* benchmark function declarations */
 void *iterate(void *pres);
+static void core_init_results(core_params *p, core_results *res);
+
+#if (MULTITHREAD>1)
+/* accumulated timings of the parallel runs of all contexts */
+typedef struct core_stats_s {
+	char name[MITH_MAX_NAME];
+	e_u32 threads;
+	e_u32 iterations;
+	CORE_TICKS thread_ticks[MULTITHREAD];
+	CORE_TICKS run_ticks;
+	CORE_TICKS single_ticks;	/* iterate on one thread alone, measured once */
+	e_u32 runs;
+	e_u16 crc;
+	al_mutex_t lock;
+} core_stats;
+#endif
 
 extern volatile e_s32 seed1_volatile;
 extern volatile e_s32 seed2_volatile;
 extern volatile e_s32 seed3_volatile;
 extern volatile e_s32 seed4_volatile;
 extern volatile e_s32 seed5_volatile;
-volatile e_u32 list_items=0;
-volatile e_u32 state_size=0;
-volatile e_u32 matrix_n=0;
-volatile e_u32 total_data_size=0;
-volatile e_u32 mem_req[32];
 volatile ee_u32 time_multiplier;
 
 void *define_params_core(unsigned int idx, char *name, char *dataset) {
     core_params *params;
 	e_s32 data_index=idx;
+	e_u32 matrix_sweep=0;
+	e_u32 state_engine=CORE_STATE_TOKEN;
 
 	/* parameter setup */
 	params=(core_params *)th_malloc(sizeof(core_params));
@@ -102,25 +126,61 @@ void *define_params_core(unsigned int idx, char *name, char *dataset) {
 		th_parse_buf_flag_unsigned(dataset,"-b",&params->s2);
 		th_parse_buf_flag_unsigned(dataset,"-c",&params->s3);
 		th_parse_buf_flag_unsigned(dataset,"-i",&params->iterations);
+		th_parse_buf_flag_unsigned(dataset,"-l",&params->list_layout);
+		th_parse_buf_flag_unsigned(dataset,"-R",&matrix_sweep);
+		th_parse_buf_flag_unsigned(dataset,"-e",&state_engine);
+	}
+	params->threads=default_num_contexts;
+	if (pgo_training_run==0)
+		th_parse_buf_flag_unsigned(dataset,"-T",&params->threads);
+	if (params->list_layout>LIST_LAYOUT_SOA)
+		th_exit( THE_FAILURE, "Unknown list layout %d %s:%d", params->list_layout,__FILE__,__LINE__ );
+	if (params->threads<1 || params->threads>MULTITHREAD)
+		th_exit( THE_FAILURE, "Threads must be 1 to %d %s:%d", MULTITHREAD,__FILE__,__LINE__ );
+	params->team=NULL;
+	params->stats=NULL;
+#if (MULTITHREAD>1)
+	if (params->threads>1) {
+		params->stats=(core_stats *)th_calloc(1,sizeof(core_stats));
+		if (params->stats==NULL)
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+		th_strncpy(params->stats->name,name,MITH_MAX_NAME-1);
+		params->stats->threads=params->threads;
+		params->stats->iterations=params->iterations;
+		al_mutex_init(&params->stats->lock);
 	}
+#endif
 	/* setup data for memory alloc and init */
 	params->results->iterations=params->iterations;
 	params->results->seed1=params->s1;
 	params->results->seed2=params->s2;
 	params->results->seed3=params->s3;
-	state_size=params->ss;
-	list_items=params->li;
-	matrix_n=params->mn;
-	
-	mem_req[ID_STATE]=state_size+PADDING/3;
-	mem_req[ID_LIST]=((16+sizeof(struct list_data_s))*(list_items+2))+PADDING/3;
-	mem_req[ID_MATRIX]=((matrix_n)*(matrix_n)*(2*sizeof(MATDAT) + sizeof(MATRES)))+PADDING/3;
-	total_data_size=mem_req[ID_STATE] + mem_req[ID_LIST] + mem_req[ID_MATRIX];
-	params->results->size=state_size;
+	params->results->list_layout=params->list_layout;
+	params->results->state_engine=core_state_engine(state_engine);
+	/* sizes are kept in the params of each item, so items with different sizes can share a workload */
+	params->mem_req[ID_STATE]=params->ss+PADDING/3;
+	params->mem_req[ID_LIST]=((16+sizeof(struct list_data_s))*(params->li+2))+PADDING/3;
+	params->mem_req[ID_MATRIX]=((params->mn)*(params->mn)*(2*sizeof(MATDAT) + sizeof(MATRES)))+PADDING/3;
+	params->size=params->mem_req[ID_STATE] + params->mem_req[ID_LIST] + params->mem_req[ID_MATRIX];
+	params->results->size=params->ss;
 	params->results->err=0;
-	params->size=total_data_size;
 	
 	check_data_types();
+	/* matrix size / throughput report, up to -R<size> */
+	if (matrix_sweep)
+		core_matrix_sweep(name,matrix_sweep,(ee_s32)params->s1 | (((ee_s32)params->s2) << 16));
+#if (MULTITHREAD>1)
+	/* the one thread rate for the scaling efficiency, measured once here so it is not part of 
+		the workload time. iterate changes the data, so it runs on a copy of its own */
+	if (params->stats!=NULL) {
+		core_results single;
+		th_memcpy(&single,params->results,sizeof(core_results));
+		core_init_results(params,&single);
+		iterate(&single);
+		params->stats->single_ticks=single.ticks;
+		th_free(single.memblock[0]);
+	}
+#endif
 
 	return params;
 }
@@ -130,11 +190,61 @@ int bmark_clean_core(void *in_params) {
 	core_params *params=(core_params *)in_params;
 	if (in_params==NULL)
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
+#if (MULTITHREAD>1)
+	if (params->stats!=NULL) {
+		core_stats *st=params->stats;
+		if (st->runs>0 && st->run_ticks>0) {
+			e_f64 tps=(e_f64)th_ticks_per_sec();
+			e_f64 iters=(e_f64)st->iterations*(e_f64)st->runs;
+			e_f64 rate=iters*st->threads/((e_f64)st->run_ticks/tps);
+			e_u32 t;
+			for (t=0; t<st->threads; t++)
+				if (st->thread_ticks[t]>0)
+					th_printf("-- %s:thread%u(iterations/sec)=%8g\n",st->name,t,iters/((e_f64)st->thread_ticks[t]/tps));
+			th_printf("-- %s:threads(iterations/sec)=%8g\n",st->name,rate);
+			if (st->single_ticks>0) {
+				e_f64 single=(e_f64)st->iterations/((e_f64)st->single_ticks/tps);
+				th_printf("-- %s:single(iterations/sec)=%8g\n",st->name,single);
+				th_printf("-- %s:threads(efficiency)=%8g\n",st->name,rate/(single*st->threads));
+			}
+			th_printf("-- %s:threads(crc)=0x%04x\n",st->name,st->crc);
+		}
+		al_mutex_destroy(&st->lock);
+		th_free(st);
+	}
+#endif
 	th_free(params->results);
 	th_free(params);
 	return 1;
 }
 
+/* allocate the memory of one thread and initialize its data */
+static void core_init_results(core_params *p, core_results *res) {
+	res->memblock[0]=th_malloc(p->size);
+	if ( res->memblock[0] == NULL )
+          th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	/* assign memory */
+	{
+		ee_u32 reserved=0;
+		int i;
+		for (i=0; i<3; i++) {
+			ee_u32 id=(1<<(ee_u32)i);
+			res->memblock[i+1]=(char *)(res->memblock[0])+reserved;
+			reserved+=p->mem_req[id];
+		}
+	}
+	/* init data structures */
+	{
+		if (p->list_layout==LIST_LAYOUT_SOA)
+			core_list_init_soa(p->li,res->memblock[1],res->seed1,&(res->soa));
+		else
+			res->list=core_list_init(p->li,res->memblock[1],res->seed1);
+		core_init_matrix(p->mem_req[ID_MATRIX], res->memblock[2], (ee_s32)res->seed1 | (((ee_s32)res->seed2) << 16), &(res->mat), p->mn );
+		core_init_state(p->ss,res->seed1,res->memblock[3]);
+	}
+	res->ticks=0;
+}
+
 void *bmark_init_core(void *in_params) {
 	core_params *params=(core_params *)in_params;
     core_params *p;
@@ -146,27 +256,25 @@ void *bmark_init_core(void *in_params) {
 	th_memcpy(p,params,sizeof(core_params));
 	/* alloc memory */
 	p->results=(core_results *)th_malloc(sizeof(core_results));
-	th_memcpy(p->results,params->results,sizeof(core_results));
-	p->results->memblock[0]=th_malloc(params->size);
-	if ( p->results->memblock[0] == NULL )
+	if ( p->results == NULL )
           th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
-	/* assign memory */
-	{
-		ee_u32 reserved=0;
-		int i;
-		for (i=0; i<3; i++) {
-			ee_u32 id=(1<<(ee_u32)i);
-			p->results->memblock[i+1]=(char *)(p->results->memblock[0])+reserved;
-			reserved+=mem_req[id];
+	th_memcpy(p->results,params->results,sizeof(core_results));
+	core_init_results(p,p->results);
+#if (MULTITHREAD>1)
+	/* every thread works on its own copy of the same data */
+	if (p->threads>1) {
+		e_u32 t;
+		p->team=(core_results *)th_malloc(sizeof(core_results)*(p->threads-1));
+		if ( p->team == NULL )
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+		for (t=0; t<p->threads-1; t++) {
+			th_memcpy(&(p->team[t]),params->results,sizeof(core_results));
+			core_init_results(p,&(p->team[t]));
 		}
+		p->run_ticks=0;
+		p->runs=0;
 	}
-	/* init data structures */
-	{
-		ee_u32 per_item=16+sizeof(struct list_data_s); /* to accomodate systems with 64b pointers, and make sure same code is executed, set max list elements */
-		p->results->list=core_list_init(p->li,p->results->memblock[1],p->results->seed1);
-		core_init_matrix(mem_req[ID_MATRIX], p->results->memblock[2], (ee_s32)p->results->seed1 | (((ee_s32)p->results->seed2) << 16), &(p->results->mat), p->mn );
-		core_init_state(p->ss,p->results->seed1,p->results->memblock[3]);
-	}
+#endif
 	
 	return p;
 }
@@ -176,6 +284,25 @@ void *bmark_fini_core(void *in_params) {
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
 	params=(core_params *)in_params;
 
+#if (MULTITHREAD>1)
+	if (params->team!=NULL) {
+		core_stats *st=params->stats;
+		e_u32 t;
+		if (params->runs>0) {
+			al_mutex_lock(&st->lock);
+			st->thread_ticks[0]+=params->results->ticks;
+			for (t=1; t<params->threads; t++)
+				st->thread_ticks[t]+=params->team[t-1].ticks;
+			st->run_ticks+=params->run_ticks;
+			st->runs+=params->runs;
+			st->crc=params->crc_threads;
+			al_mutex_unlock(&st->lock);
+		}
+		for (t=0; t<params->threads-1; t++)
+			th_free(params->team[t].memblock[0]);
+		th_free(params->team);
+	}
+#endif
 	if ( params->results->memblock[0] != NULL )
 		th_free(params->results->memblock[0]);
 	th_free(params->results);
@@ -190,6 +317,27 @@ void *t_run_test_core(struct TCDef *tcdef,void *in_params) {
 	int i,j;
 	
 	tcdef->expected_CRC=0;
+#if (MULTITHREAD>1)
+	/* parallel mode : thread 0 is the calling thread, the crc of all threads is combined in thread order */
+	if (p->threads>1) {
+		CORE_TICKS start=th_signal_now();
+		e_u32 t;
+		for (t=1; t<p->threads; t++) {
+			p->team[t-1].port.sub_item_id=t;
+			if (core_start_parallel(&(p->team[t-1]))!=0)
+				th_exit( THE_FAILURE, "Cannot start thread %d %s:%d", t,__FILE__,__LINE__ );
+		}
+		iterate(p->results);
+		for (t=1; t<p->threads; t++)
+			if (core_stop_parallel(&(p->team[t-1]))!=0)
+				th_exit( THE_FAILURE, "Cannot join thread %d %s:%d", t,__FILE__,__LINE__ );
+		p->run_ticks+=th_signal_now()-start;
+		p->runs++;
+		p->crc_threads=crcu16(p->results->crc,0);
+		for (t=1; t<p->threads; t++)
+			p->crc_threads=crcu16(p->team[t-1].crc,p->crc_threads);
+	} else
+#endif
 	iterate(p->results);
 		
 	if (p->gen_ref)
@@ -238,6 +386,20 @@ int bmark_verify_core(void *in_params) {
 			p->results->err++;
 		}
 	}
+#if (MULTITHREAD>1)
+	/* all threads work on the same data */
+	if (p->team!=NULL) {
+		e_u32 t;
+		for (t=1; t<p->threads; t++) {
+			core_results *r=&(p->team[t-1]);
+			if (r->crclist!=p->results->crclist || r->crcmatrix!=p->results->crcmatrix ||
+				r->crcstate!=p->results->crcstate || r->crc!=p->results->crc) {
+				ee_printf("[%u]ERROR! thread %u crc 0x%04x - should be 0x%04x\n",p->data_id,t,r->crc,p->results->crc);
+				p->results->err++;
+			}
+		}
+	}
+#endif
 	if (p->results->err>0) {
 		ee_printf(" - Sizes: %d/%d/%d:%d\n",p->li,p->mn,p->ss,p->results->size);
 		ee_printf(" - Seeds: 0x%x/0x%x/0x%x\n",p->s1,p->s2,p->s3);
@@ -250,6 +412,7 @@ void *iterate(void *pres) {
 	ee_u16 crc;
 	core_results *res=(core_results *)pres;
 	ee_u32 iterations=res->iterations;
+	CORE_TICKS start=th_signal_now();
 	res->crc=0;
 	res->crclist=0;
 	res->crcmatrix=0;
@@ -262,5 +425,6 @@ void *iterate(void *pres) {
 		res->crc=crcu16(crc,res->crc);
 		if (i==0) res->crclist=res->crc;
 	}
+	res->ticks+=th_signal_now()-start;
 	return NULL;
 }
\ No newline at end of file
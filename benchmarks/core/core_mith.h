@@ -24,6 +24,15 @@ typedef struct core_params_s {
 	int data_id;
 	e_u16 crc[4];
 	e_u32 size;
+	e_u32 list_layout;
+	e_u32 mem_req[ALL_ALGORITHMS_MASK+1];	/* memory for each algorithm, indexed by ID */
+	/* parallel mode, see <t_run_test_core> */
+	e_u32 threads;
+	core_results *team;		/* results and memory of threads 1 to threads-1 */
+	CORE_TICKS run_ticks;	/* time of the parallel runs of this context */
+	e_u32 runs;
+	e_u16 crc_threads;		/* crc of all threads, in thread order */
+	struct core_stats_s *stats;
 } core_params;
 
 extern ee_u16 *list_known_crc;
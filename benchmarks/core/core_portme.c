@@ -85,10 +85,7 @@ void portable_free(void *p) {
 #endif
 #define EE_TICKS_PER_SEC (NSECS_PER_SEC / TIMER_RES_DIVIDER)
 
-/** Using MITH for timing */
-static char *mith_msg="NA - MITH VERSION!\n";
-
-ee_u32 default_num_contexts=MULTITHREAD;
+ee_u32 default_num_contexts=1;
 
 void portable_init(core_portable *p, int *argc, char *argv[])
 {
@@ -106,12 +103,27 @@ void portable_fini(core_portable *p)
 	p->portable_id=0;
 }
 
+#if (MULTITHREAD>1)
+/* Function: core_start_parallel
+	Start a thread running iterate on res, placed according to res->port.sub_item_id.
+	
+	Returns:
+	0 on success.
+*/
 ee_u8 core_start_parallel(core_results *res) {
-	th_printf(mith_msg);
-	return 0;
+	mith_textend tex;
+	al_item_textend(&tex,res->port.sub_item_id);
+	return (ee_u8)(al_thread_create_ex(&(res->port.thread),iterate,(void *)res,&tex)!=0);
 }
+/* Function: core_stop_parallel
+	Wait for the thread started by <core_start_parallel> on res.
+	
+	Returns:
+	0 on success.
+*/
 ee_u8 core_stop_parallel(core_results *res) {
-	th_printf(mith_msg);
-	return 0;
+	void *retval;
+	return (ee_u8)(al_thread_join(res->port.thread,&retval)!=0);
 }
+#endif
 
@@ -129,19 +129,23 @@ typedef size_t ee_size_t;
 	Define for parallel execution 
 	
 	Valid values:
-	1 - only one context (default).
-	N>1 - will execute N copies in parallel.
+	1 - only one context.
+	N>1 - will execute up to N copies in parallel (default 64).
 	
 	Note: 
 	If this flag is defined to more then 1, an implementation for launching parallel contexts must be defined.
 	
 	Two sample implementations are provided. Use <USE_PTHREAD> or <USE_FORK> to enable them.
 	
+	The MITH version starts them with the al_smp threads API in <core_portme.c>. 
+	Here N is only the largest thread count accepted by the -T dataset option, 
+	the number of threads used is still one unless -T or <default_num_contexts> asks for more.
+	
 	It is valid to have a different implementation of <core_start_parallel> and <core_end_parallel> in <core_portme.c>,
 	to fit a particular architecture. 
 */
 #ifndef MULTITHREAD
-#define MULTITHREAD 1
+#define MULTITHREAD 64
 #endif
 
 /* Configuration: USE_PTHREAD
@@ -214,6 +218,7 @@ typedef size_t ee_size_t;
 /* Variable: default_num_contexts
 	Number of contexts to spawn in multicore context.
 	Override this global value to change number of contexts used.
+	The MITH version uses it when there is no -T dataset option.
 	
 	Note:
 	This value may not be set higher then the <MULTITHREAD> define.
@@ -230,6 +235,7 @@ extern ee_u32 default_num_contexts;
 typedef struct CORE_PORTABLE_S {
 #if (MULTITHREAD>1)
 	al_thread_t thread;
+	ee_u32 sub_item_id;	/* thread index within the team, for affinity */
 #endif /* MULTITHREAD>1 */
 	ee_u8	portable_id;
 } core_portable;
@@ -27,6 +27,9 @@ void fill_state_table();
 #define core_state_transition_switch core_state_transition
 #endif
 enum CORE_STATE core_state_transition( ee_u8 **instr , ee_u32 *transition_count);
+static void fill_state_scan(void);
+static void core_state_scan(ee_u8 *memblock, ee_u32 blksize, ee_u32 *final_counts, 
+		ee_u32 *transition_count, ee_u32 engine);
 
 /*
 Topic: Description
@@ -47,6 +50,7 @@ Topic: Description
 	Benchmark function
 
 	Go over the input twice, once direct, and once after introducing some corruption. 
+	With engine other than CORE_STATE_TOKEN, each pass is done by <core_state_scan>.
 */
 
 
@@ -55,7 +59,7 @@ Topic: Description
 
 
 ee_u16 core_bench_state(ee_u32 blksize, ee_u8 *memblock, 
-		ee_s16 seed1, ee_s16 seed2, ee_s16 step, ee_u16 crc) 
+		ee_s16 seed1, ee_s16 seed2, ee_s16 step, ee_u16 crc, ee_u32 engine) 
 {
 	ee_u32 final_counts[NUM_CORE_STATES];
 	ee_u32 track_counts[NUM_CORE_STATES];
@@ -70,7 +74,9 @@ ee_u16 core_bench_state(ee_u32 blksize, ee_u8 *memblock,
 		final_counts[i]=track_counts[i]=0;
 	}
 	/* run the state machine over the input */
-	while (*p!=0) {
+	if (engine!=CORE_STATE_TOKEN)
+		core_state_scan(memblock,blksize,final_counts,track_counts,engine);
+	else while (*p!=0) {
 		enum CORE_STATE fstate=core_state_transition(&p,track_counts);
 		final_counts[fstate]++;
 #if CORE_DEBUG
@@ -88,7 +94,9 @@ ee_u16 core_bench_state(ee_u32 blksize, ee_u8 *memblock,
 	}
 	p=memblock;
 	/* run the state machine over the input again */
-	while (*p!=0) {
+	if (engine!=CORE_STATE_TOKEN)
+		core_state_scan(memblock,blksize,final_counts,track_counts,engine);
+	else while (*p!=0) {
 		enum CORE_STATE fstate=core_state_transition(&p,track_counts);
 		final_counts[fstate]++;
 #if CORE_DEBUG
@@ -351,3 +359,391 @@ enum CORE_STATE core_state_transition_table( ee_u8 **instr , ee_u32 *transition_
        *instr=str;
        return state;
 }
+
+/* Topic: Scan engine
+	Selected with the -e1 dataset option, gives the same transition_count and final counts 
+	as <core_state_transition_switch> over the whole input.
+
+	The input is split in blocks of STATE_BLOCK bytes, and each block is first classified
+	into character classes (digit, sign, dot, exponent, comma, end, other).
+	x86 engines look up the low and high nibbles of 16, 32 or 64 bytes at once with pshufb,
+	and the class is the index of the one bit left in both lookups. rvv does the same with vrgather.
+	The classes of two bytes are then combined into one index (pmaddubsw).
+
+	The DFA then advances over pairs of classes with one lookup each, without branches.
+	It restarts at CORE_START after a comma or an invalid input like the calls of 
+	<core_state_transition> do. Each (state, class pair) step is counted, 
+	and the counts are turned into transition counts at the end.
+
+	Since every comma brings the DFA back to CORE_START, the input up to the first 0 is split 
+	after commas into STATE_STREAMS parts that are run interleaved, so the lookups of one part 
+	overlap with the others instead of waiting on each other.
+	Bytes past the end of the state memory are classified a byte at a time.
+*/
+#define STATE_CLS_OTHER		0
+#define STATE_CLS_DIGIT		1
+#define STATE_CLS_SIGN		2
+#define STATE_CLS_DOT		3
+#define STATE_CLS_EXP		4
+#define STATE_CLS_COMMA		5
+#define STATE_CLS_END		6	/* also used past the end of a part, leaves the state as is */
+#define STATE_NUM_CLS		8
+#define STATE_NUM_PAIRS		(STATE_NUM_CLS*STATE_NUM_CLS)
+#define STATE_BLOCK			64
+#define STATE_STREAMS		4	/* <core_state_scan> has one STATE_STEP per part */
+
+/* classifiers of the scan engine */
+#define STATE_SCAN_TABLE	CORE_STATE_SCAN
+#define STATE_SCAN_SSSE3	2
+#define STATE_SCAN_AVX2		3
+#define STATE_SCAN_AVX512	4
+#define STATE_SCAN_RVV		5
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATE_X86 1
+#include <immintrin.h>
+#else
+#define STATE_X86 0
+#endif
+#if defined(USE_RVV) && USE_RVV
+#define STATE_RVV 1
+#else
+#define STATE_RVV 0
+#endif
+
+static ee_u8 state_class[MAX_TRANS];
+static ee_u8 state_next[NUM_CORE_STATES*STATE_NUM_CLS];
+/* next state after a pair of classes, as the offset of its row in the pair tables */
+static ee_u16 state_next2[NUM_CORE_STATES*STATE_NUM_PAIRS];
+/* a character of each class before comma, to look up <state_tables> */
+static const ee_u8 state_class_char[STATE_CLS_COMMA]={'x','0','+','.','e'};
+
+/* nibble lookups: one bit per class, the byte keeps the bit set in both */
+static const ee_u8 state_lo_nibble[16]={1,1,1,1,1,1|8,1,1,1,1,0,2,0,2,4,0};
+static const ee_u8 state_hi_nibble[16]={0,0,2|4,1,8,0,8,0,0,0,0,0,0,0,0,0};
+static const ee_u8 state_bit_class[16]={STATE_CLS_OTHER,STATE_CLS_DIGIT,STATE_CLS_SIGN,0,STATE_CLS_DOT,0,0,0,STATE_CLS_EXP};
+
+static void fill_state_scan(void) {
+	ee_u32 c, s, k;
+	for (c=0; c<MAX_TRANS; c++) {
+		if (ee_isdigit((ee_u8)c))
+			k=STATE_CLS_DIGIT;
+		else if (c=='+' || c=='-')
+			k=STATE_CLS_SIGN;
+		else if (c=='.')
+			k=STATE_CLS_DOT;
+		else if (c=='e' || c=='E')
+			k=STATE_CLS_EXP;
+		else if (c==',')
+			k=STATE_CLS_COMMA;
+		else if (c==0)
+			k=STATE_CLS_END;
+		else
+			k=STATE_CLS_OTHER;
+		state_class[c]=(ee_u8)k;
+	}
+	for (s=0; s<NUM_CORE_STATES; s++) {
+		for (k=0; k<STATE_NUM_CLS; k++) {
+			ee_u8 next=(ee_u8)s;
+			if (k<STATE_CLS_COMMA)
+				next=state_tables[(s*MAX_TRANS) + state_class_char[k]];
+			else if (k==STATE_CLS_COMMA)
+				next=CORE_START;
+			/* a new input starts after an invalid one */
+			state_next[s*STATE_NUM_CLS+k]=(next==CORE_INVALID) ? CORE_START : next;
+		}
+	}
+	for (s=0; s<NUM_CORE_STATES; s++)
+		for (k=0; k<STATE_NUM_PAIRS; k++)
+			state_next2[s*STATE_NUM_PAIRS+k]=STATE_NUM_PAIRS *
+				state_next[state_next[s*STATE_NUM_CLS+k/STATE_NUM_CLS]*STATE_NUM_CLS + k%STATE_NUM_CLS];
+}
+
+/* classify one byte at a time, bytes from len on are in the end class */
+static void state_classify_table(const ee_u8 *in, ee_u16 *pair, ee_u32 len) {
+	ee_u32 i;
+	for (i=0; i<STATE_BLOCK; i+=2) {
+		ee_u32 c0=(i<len) ? state_class[in[i]] : STATE_CLS_END;
+		ee_u32 c1=(i+1<len) ? state_class[in[i+1]] : STATE_CLS_END;
+		pair[i/2]=(ee_u16)(c0*STATE_NUM_CLS+c1);
+	}
+}
+
+#if STATE_X86
+#define STATE_CLASSIFY_BODY { \
+	const vi_t lo_t=S_TABLE(state_lo_nibble), hi_t=S_TABLE(state_hi_nibble); \
+	const vi_t bit_t=S_TABLE(state_bit_class), m0f=S_SET1(0x0f); \
+	const vi_t comma=S_SET1(','), zero=S_SET1(0); \
+	const vi_t kcomma=S_SET1(STATE_CLS_COMMA), kend=S_SET1(STATE_CLS_END); \
+	const vi_t kpair=S_SET1_16(STATE_NUM_CLS | (1<<8)); \
+	ee_u32 i; \
+	for (i=0; i<STATE_BLOCK; i+=S_W) { \
+		vi_t c=S_LOAD(in+i); \
+		vi_t bits=S_AND(S_SHUF(lo_t,S_AND(c,m0f)),S_SHUF(hi_t,S_AND(S_SRLI16(c,4),m0f))); \
+		vi_t k=S_SHUF(bit_t,bits); \
+		k=S_OR(k,S_AND(S_CMPEQ(c,comma),kcomma)); \
+		k=S_OR(k,S_AND(S_CMPEQ(c,zero),kend)); \
+		S_STORE(pair+i/2,S_MADDUBS(k,kpair)); \
+	} \
+}
+
+#define vi_t			__m128i
+#define S_W				16
+#define S_TABLE(t)		_mm_loadu_si128((const __m128i *)(t))
+#define S_LOAD(p)		_mm_loadu_si128((const __m128i *)(p))
+#define S_STORE(p,x)	_mm_storeu_si128((__m128i *)(p),x)
+#define S_SET1(x)		_mm_set1_epi8(x)
+#define S_SET1_16(x)	_mm_set1_epi16(x)
+#define S_MADDUBS(x,y)	_mm_maddubs_epi16(x,y)
+#define S_AND(x,y)		_mm_and_si128(x,y)
+#define S_OR(x,y)		_mm_or_si128(x,y)
+#define S_SHUF(t,x)		_mm_shuffle_epi8(t,x)
+#define S_SRLI16(x,n)	_mm_srli_epi16(x,n)
+#define S_CMPEQ(x,y)	_mm_cmpeq_epi8(x,y)
+__attribute__((target("ssse3"))) static void state_classify_ssse3(const ee_u8 *in, ee_u16 *pair) 
+	STATE_CLASSIFY_BODY
+#undef vi_t
+#undef S_W
+#undef S_TABLE
+#undef S_LOAD
+#undef S_STORE
+#undef S_SET1
+#undef S_SET1_16
+#undef S_MADDUBS
+#undef S_AND
+#undef S_OR
+#undef S_SHUF
+#undef S_SRLI16
+#undef S_CMPEQ
+
+/* pshufb works within 128 bit lanes, so the tables are repeated in each lane */
+#define vi_t			__m256i
+#define S_W				32
+#define S_TABLE(t)		_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(t)))
+#define S_LOAD(p)		_mm256_loadu_si256((const __m256i *)(p))
+#define S_STORE(p,x)	_mm256_storeu_si256((__m256i *)(p),x)
+#define S_SET1(x)		_mm256_set1_epi8(x)
+#define S_SET1_16(x)	_mm256_set1_epi16(x)
+#define S_MADDUBS(x,y)	_mm256_maddubs_epi16(x,y)
+#define S_AND(x,y)		_mm256_and_si256(x,y)
+#define S_OR(x,y)		_mm256_or_si256(x,y)
+#define S_SHUF(t,x)		_mm256_shuffle_epi8(t,x)
+#define S_SRLI16(x,n)	_mm256_srli_epi16(x,n)
+#define S_CMPEQ(x,y)	_mm256_cmpeq_epi8(x,y)
+__attribute__((target("avx2"))) static void state_classify_avx2(const ee_u8 *in, ee_u16 *pair) 
+	STATE_CLASSIFY_BODY
+#undef vi_t
+#undef S_W
+#undef S_TABLE
+#undef S_LOAD
+#undef S_STORE
+#undef S_SET1
+#undef S_SET1_16
+#undef S_MADDUBS
+#undef S_AND
+#undef S_OR
+#undef S_SHUF
+#undef S_SRLI16
+#undef S_CMPEQ
+
+/* the whole block in one vector, compares give masks for the comma and end classes */
+__attribute__((target("avx512f,avx512bw"))) static void state_classify_avx512(const ee_u8 *in, ee_u16 *pair) {
+	const __m512i lo_t=_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)state_lo_nibble));
+	const __m512i hi_t=_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)state_hi_nibble));
+	const __m512i bit_t=_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)state_bit_class));
+	const __m512i m0f=_mm512_set1_epi8(0x0f);
+	__m512i c=_mm512_loadu_si512((const void *)in);
+	__m512i bits=_mm512_and_si512(_mm512_shuffle_epi8(lo_t,_mm512_and_si512(c,m0f)),
+		_mm512_shuffle_epi8(hi_t,_mm512_and_si512(_mm512_srli_epi16(c,4),m0f)));
+	__m512i k=_mm512_shuffle_epi8(bit_t,bits);
+	k=_mm512_mask_mov_epi8(k,_mm512_cmpeq_epi8_mask(c,_mm512_set1_epi8(',')),_mm512_set1_epi8(STATE_CLS_COMMA));
+	k=_mm512_mask_mov_epi8(k,_mm512_cmpeq_epi8_mask(c,_mm512_setzero_si512()),_mm512_set1_epi8(STATE_CLS_END));
+	_mm512_storeu_si512((void *)pair,_mm512_maddubs_epi16(k,_mm512_set1_epi16(STATE_NUM_CLS | (1<<8))));
+}
+#endif /* STATE_X86 */
+
+#if STATE_RVV
+/* needs VLEN of at least 128 for the 16 entry tables */
+static void state_classify_rvv(const ee_u8 *in, ee_u16 *pair) {
+	vuint8m1_t lo_t=__riscv_vle8_v_u8m1(state_lo_nibble,16);
+	vuint8m1_t hi_t=__riscv_vle8_v_u8m1(state_hi_nibble,16);
+	vuint8m1_t bit_t=__riscv_vle8_v_u8m1(state_bit_class,16);
+	ee_u32 i;
+	size_t vl;
+	for (i=0; i<STATE_BLOCK; i+=vl) {
+		vl=__riscv_vsetvl_e8m1(STATE_BLOCK-i);
+		vuint8m1_t c=__riscv_vle8_v_u8m1(in+i,vl);
+		vuint8m1_t bits=__riscv_vand_vv_u8m1(
+			__riscv_vrgather_vv_u8m1(lo_t,__riscv_vand_vx_u8m1(c,0x0f,vl),vl),
+			__riscv_vrgather_vv_u8m1(hi_t,__riscv_vsrl_vx_u8m1(c,4,vl),vl),vl);
+		vuint8m1_t k=__riscv_vrgather_vv_u8m1(bit_t,bits,vl);
+		k=__riscv_vmerge_vxm_u8m1(k,STATE_CLS_COMMA,__riscv_vmseq_vx_u8m1_b8(c,',',vl),vl);
+		k=__riscv_vmerge_vxm_u8m1(k,STATE_CLS_END,__riscv_vmseq_vx_u8m1_b8(c,0,vl),vl);
+		/* vl is even, the two classes of a pair are the bytes of a 16 bit element */
+		vuint16m1_t w=__riscv_vreinterpret_v_u8m1_u16m1(k);
+		w=__riscv_vor_vv_u16m1(__riscv_vsll_vx_u16m1(__riscv_vand_vx_u16m1(w,0xff,vl/2),3,vl/2),
+			__riscv_vsrl_vx_u16m1(w,8,vl/2),vl/2);
+		__riscv_vse16_v_u16m1(pair+i/2,w,vl/2);
+	}
+}
+#endif /* STATE_RVV */
+
+/* Function: core_state_engine
+	Select the engine of the state machine benchmark.
+	The tables of the scan engine are built here, once, before any context runs.
+
+	Returns:
+	CORE_STATE_TOKEN for <core_state_transition>, otherwise the widest classifier of the 
+	scan engine the processor supports.
+*/
+ee_u32 core_state_engine(ee_u32 engine) {
+	static ee_u8 scan_ready=0;
+	if (engine==CORE_STATE_TOKEN)
+		return CORE_STATE_TOKEN;
+	if (!scan_ready) {
+		fill_state_table();
+		fill_state_scan();
+		scan_ready=1;
+	}
+	engine=STATE_SCAN_TABLE;
+#if STATE_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512bw"))
+		engine=STATE_SCAN_AVX512;
+	else if (__builtin_cpu_supports("avx2"))
+		engine=STATE_SCAN_AVX2;
+	else if (__builtin_cpu_supports("ssse3"))
+		engine=STATE_SCAN_SSSE3;
+#elif STATE_RVV
+	engine=STATE_SCAN_RVV;
+#endif
+	return engine;
+}
+
+/* advance part j by one pair, the rows stay in registers */
+#define STATE_STEP(j) { \
+	ee_u32 idx=row##j + pair[j][pos]; \
+	pairs[j][idx]++; \
+	row##j=state_next2[idx]; \
+}
+
+/* Function: core_state_scan
+	Run the state machine over the whole input with the scan engine,
+	adding to final_counts and transition_count like the calls of <core_state_transition> would.
+*/
+static void core_state_scan(ee_u8 *memblock, ee_u32 blksize, ee_u32 *final_counts, 
+		ee_u32 *transition_count, ee_u32 engine) {
+	ee_u32 pairs[STATE_STREAMS][NUM_CORE_STATES*STATE_NUM_PAIRS];
+	ee_u32 steps[NUM_CORE_STATES*STATE_NUM_CLS];
+	ee_u16 pair[STATE_STREAMS][STATE_BLOCK/2];
+	ee_u32 start[STATE_STREAMS+1], row[STATE_STREAMS];
+	/* offsets of the rows of the current states */
+	ee_u32 row0=CORE_START*STATE_NUM_PAIRS, row1=row0, row2=row0, row3=row0;
+	ee_u32 len=(ee_u32)th_strlen((const char *)memblock);
+	ee_u32 off, pos, s, k, j;
+
+	/* each part but the first starts after a comma, in CORE_START */
+	start[0]=0;
+	for (j=1; j<STATE_STREAMS; j++) {
+		start[j]=len/STATE_STREAMS*j;
+		if (start[j]<start[j-1])
+			start[j]=start[j-1];
+		while (start[j]<len && memblock[start[j]]!=',')
+			start[j]++;
+		if (start[j]<len)
+			start[j]++;
+	}
+	start[STATE_STREAMS]=len;
+
+	th_memset(pairs,0,sizeof(pairs));
+	for (off=0; off<len; off+=STATE_BLOCK) {
+		ee_u32 busy=0;
+		for (j=0; j<STATE_STREAMS; j++) {
+			ee_u8 *in=memblock+start[j]+off;
+			ee_u32 n=0;
+			if (start[j]+off<start[j+1])
+				n=start[j+1]-start[j]-off;
+			if (n>STATE_BLOCK)
+				n=STATE_BLOCK;
+			if (n && start[j]+off+STATE_BLOCK<=blksize) switch (engine) {
+#if STATE_X86
+				case STATE_SCAN_SSSE3:
+					state_classify_ssse3(in,pair[j]);
+					break;
+				case STATE_SCAN_AVX2:
+					state_classify_avx2(in,pair[j]);
+					break;
+				case STATE_SCAN_AVX512:
+					state_classify_avx512(in,pair[j]);
+					break;
+#endif
+#if STATE_RVV
+				case STATE_SCAN_RVV:
+					state_classify_rvv(in,pair[j]);
+					break;
+#endif
+				default:
+					state_classify_table(in,pair[j],n);
+					break;
+			} else
+				state_classify_table(in,pair[j],n);
+			/* past the end of the part */
+			if (n & 1)
+				pair[j][n/2]=(pair[j][n/2] & ~(STATE_NUM_CLS-1)) | STATE_CLS_END;
+			for (pos=(n+1)/2; pos<STATE_BLOCK/2; pos++)
+				pair[j][pos]=STATE_CLS_END*STATE_NUM_CLS + STATE_CLS_END;
+			busy|=n;
+		}
+		if (busy==0)
+			break;
+		for (pos=0; pos<STATE_BLOCK/2; pos++) {
+			STATE_STEP(0);
+			STATE_STEP(1);
+			STATE_STEP(2);
+			STATE_STEP(3);
+		}
+	}
+	/* the parts that end after a comma are back in CORE_START */
+	row[0]=row0;
+	row[1]=row1;
+	row[2]=row2;
+	row[3]=row3;
+	for (j=0; j<STATE_STREAMS; j++)
+		if (row[j]!=CORE_START*STATE_NUM_PAIRS)
+			final_counts[row[j]/STATE_NUM_PAIRS]++;
+
+	/* split the pairs */
+	th_memset(steps,0,sizeof(steps));
+	for (s=0; s<NUM_CORE_STATES; s++) {
+		for (k=0; k<STATE_NUM_PAIRS; k++) {
+			ee_u32 n=0;
+			for (j=0; j<STATE_STREAMS; j++)
+				n+=pairs[j][s*STATE_NUM_PAIRS+k];
+			if (n==0)
+				continue;
+			steps[s*STATE_NUM_CLS + k/STATE_NUM_CLS]+=n;
+			steps[state_next[s*STATE_NUM_CLS + k/STATE_NUM_CLS]*STATE_NUM_CLS + k%STATE_NUM_CLS]+=n;
+		}
+	}
+	/* the counts of <core_state_transition_switch> for each step */
+	for (s=0; s<NUM_CORE_STATES; s++) {
+		for (k=0; k<STATE_CLS_END; k++) {
+			ee_u32 n=steps[s*STATE_NUM_CLS+k];
+			ee_u8 next;
+			if (n==0)
+				continue;
+			if (k==STATE_CLS_COMMA) {
+				transition_count[s]+=n;
+				final_counts[s]+=n;
+				continue;
+			}
+			next=state_tables[(s*MAX_TRANS) + state_class_char[k]];
+			if (next!=s && s!=CORE_SCIENTIFIC)
+				transition_count[s]+=n;
+			if (next==CORE_INVALID) {
+				transition_count[CORE_INVALID]+=n;
+				final_counts[CORE_INVALID]+=n;
+			}
+		}
+	}
+}
@@ -58,9 +58,6 @@ ee_s32 get_seed_32(int i) {
 		case 6:
 			retval=0;
 			break;
-		case 7:
-			retval=total_data_size;
-			break;
 		default:
 			retval=0;
 			break;
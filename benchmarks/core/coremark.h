@@ -92,6 +92,22 @@ typedef struct list_head_s {
 	struct list_data_s *info;
 } list_head;
 
+/* index linked list, the same list as arrays indexed by item (see <core_list_init_soa>) */
+#define LIST_NIL 0xffffffff
+typedef struct list_soa_s {
+	ee_u32 head;
+	ee_u32 size;	/* number of items */
+	ee_u32 *next;	/* index of the next item, LIST_NIL at the end */
+	ee_s16 *data16;
+	ee_s16 *idx;
+} list_soa;
+
+/* Configuration: LIST_LAYOUT_*
+	Layout of the list, selected with the -l dataset option.
+*/
+#define LIST_LAYOUT_POINTER 0
+#define LIST_LAYOUT_SOA 1
+
 
 /*matrix benchmark related stuff */
 #define MATDAT_INT 1
@@ -103,11 +119,26 @@ typedef ee_f16 MATDAT;
 typedef ee_f32 MATRES;
 #endif
 
+/* Configuration: CORE_MATRIX_SIMD
+	Widest SIMD engine the matrix multiply kernels may use, see <core_matrix_engine>.
+	
+	Valid values:
+	0 - only the reference loops (default), so results compare with other CoreMark-PRO builds.
+	1 - sse2, 2 - avx2, 3 - avx512bw, 4 - avx512 vnni.
+	Any value above 0 selects rvv when built with USE_RVV.
+	
+	The widest engine up to this value that the processor supports is used at run time.
+*/
+#ifndef CORE_MATRIX_SIMD
+#define CORE_MATRIX_SIMD 0
+#endif
+
 typedef struct MAT_PARAMS_S {
 	int N;
 	MATDAT *A;
 	MATDAT *B;
 	MATRES *C;
+	ee_u32 engine;
 } mat_params;
 
 /* state machine related stuff */
@@ -124,6 +155,14 @@ typedef enum CORE_STATE {
 	NUM_CORE_STATES
 } core_state_e ;
 
+/* Engines of the state machine benchmark, see <core_state_engine>.
+	CORE_STATE_TOKEN - one call of core_state_transition per input (default).
+	CORE_STATE_SCAN - classify blocks of input with SIMD shuffles, and advance over pairs of classes
+		with one table lookup, in parts of the input split after commas that run interleaved.
+*/
+#define CORE_STATE_TOKEN	0
+#define CORE_STATE_SCAN		1
+
 		
 /* Helper structure to hold results */
 typedef struct RESULTS_S {
@@ -136,7 +175,11 @@ typedef struct RESULTS_S {
 	ee_u32 iterations;		/* Number of iterations to execute */
 	ee_u32	execs;		/* Bitmask of operations to execute */
 	struct list_head_s *list;
+	ee_u32	list_layout;	/* LIST_LAYOUT_POINTER uses list, LIST_LAYOUT_SOA uses soa */
+	list_soa soa;
 	mat_params mat;
+	ee_u32	state_engine;	/* CORE_STATE_TOKEN, or a scan engine from core_state_engine */
+	CORE_TICKS	ticks;		/* time spent in iterate, summed over the calls */
 	/* outputs */
 	ee_u16	crc;
 	ee_u16	crclist;
@@ -156,21 +199,20 @@ ee_u8 core_stop_parallel(core_results *res);
 
 /* list benchmark functions */
 list_head *core_list_init(ee_u32 blksize, list_head *memblock, ee_s16 seed);
+void core_list_init_soa(ee_u32 blksize, void *memblock, ee_s16 seed, list_soa *l);
 ee_u16 core_bench_list(core_results *res, ee_s16 finder_idx);
 
 /* state benchmark functions */
 void core_init_state(ee_u32 size, ee_s16 seed, ee_u8 *p);
 ee_u16 core_bench_state(ee_u32 blksize, ee_u8 *memblock, 
-		ee_s16 seed1, ee_s16 seed2, ee_s16 step, ee_u16 crc);
+		ee_s16 seed1, ee_s16 seed2, ee_s16 step, ee_u16 crc, ee_u32 engine);
+ee_u32 core_state_engine(ee_u32 engine);
 
 /* matrix benchmark functions */
 ee_u32 core_init_matrix(ee_u32 blksize, void *memblk, ee_s32 seed, mat_params *p, ee_u32 N);
 ee_u16 core_bench_matrix(mat_params *p, ee_s16 seed, ee_u16 crc);
-
-extern volatile ee_u32 list_items;
-extern volatile ee_u32 state_size;
-extern volatile ee_u32 matrix_n;
-extern volatile ee_u32 total_data_size;
-extern volatile ee_u32 mem_req[32];
+ee_u32 core_matrix_engine(void);
+const char *core_matrix_engine_name(ee_u32 engine);
+void core_matrix_sweep(char *name, ee_u32 maxn, ee_s32 seed);
 
 #endif /* _COREMARK_H_ */
@@ -46,6 +46,9 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include "th_lib.h"
 #include "th_file.h"
 #include "ezxml.h"
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512BW__))
+#include <immintrin.h>
+#endif
 
 #define EZXML_WS   "\t\r\n "  // whitespace
 #define EZXML_ERRL 128        // maximum error string length
@@ -64,10 +67,121 @@ struct ezxml_root {       // additional data for the root tag
     char ***pi;           // processing instructions
     short standalone;     // non-zero if <?xml standalone="yes"?>
     char err[EZXML_ERRL]; // error string
+    struct ezxml_region *region; // region holding the whole tree, NULL if none
 };
 
 char *EZXML_NIL[] = { NULL }; // empty, null terminated array of strings
 
+// Region allocator for ezxml_parse_str_arena(). Blocks are carved from
+// chunks with a pointer bump and are never freed one by one. Each block
+// records its capacity, and blocks that have to move on realloc double it, so
+// text that keeps growing (e.g. content between child tags) is not copied on
+// every append. The region header lives in its first chunk, so destroying the
+// region releases the whole tree with one free per chunk, usually a single one.
+#define EZXML_REGION_MIN   (64 * 1024) // minimum size of the first chunk
+#define EZXML_REGION_RATIO 8           // first chunk size per byte of input
+#define EZXML_RALIGN(n)    (((n) + 15) & ~(size_t)15)
+#define EZXML_RHDR         EZXML_RALIGN(sizeof(size_t)) // block capacity header
+
+struct ezxml_chunk {
+    struct ezxml_chunk *next; // previous chunk
+    size_t size;              // bytes available for blocks
+    size_t used;              // bytes used by blocks
+};
+#define EZXML_CHUNK_DATA(c) ((char *)(c) + EZXML_RALIGN(sizeof(struct ezxml_chunk)))
+
+struct ezxml_region {
+    struct ezxml_chunk *head; // chunk blocks are allocated from
+    size_t next_size;         // size of the next chunk
+    char *last;               // last block allocated, can grow in place
+};
+
+// region used by all ezxml allocations while ezxml_parse_str_arena() runs
+static TH_THREAD_LOCAL struct ezxml_region *ezxml_cur_region;
+
+static void *ezxml_region_alloc(struct ezxml_region *r, size_t n)
+{
+    struct ezxml_chunk *c = r->head;
+    size_t need = EZXML_RHDR + EZXML_RALIGN(n);
+    char *p;
+
+    if (! c || c->used + need > c->size) { // start a new chunk
+        while (r->next_size < need) r->next_size *= 2;
+        c = th_malloc(EZXML_RALIGN(sizeof(struct ezxml_chunk)) + r->next_size);
+        if (! c) return NULL;
+        c->next = r->head;
+        c->size = r->next_size;
+        c->used = 0;
+        r->head = c;
+        r->next_size *= 2;
+    }
+    p = EZXML_CHUNK_DATA(c) + c->used;
+    *(size_t *)p = EZXML_RALIGN(n);
+    c->used += need;
+    return r->last = p + EZXML_RHDR;
+}
+
+static void *ezxml_region_realloc(struct ezxml_region *r, void *p, size_t n)
+{
+    struct ezxml_chunk *c = r->head;
+    size_t cap;
+    char *q;
+
+    if (! p) return ezxml_region_alloc(r, n);
+    cap = *(size_t *)((char *)p - EZXML_RHDR);
+    if (n <= cap) return p; // fits in the block
+    if (p == r->last && (char *)p + EZXML_RALIGN(n) <= EZXML_CHUNK_DATA(c) + c->size) {
+        *(size_t *)((char *)p - EZXML_RHDR) = EZXML_RALIGN(n); // last block, grow in place
+        c->used = ((char *)p - EZXML_CHUNK_DATA(c)) + EZXML_RALIGN(n);
+        return p;
+    }
+    if ((q = ezxml_region_alloc(r, (n < cap * 2) ? cap * 2 : n))) th_memcpy(q, p, cap);
+    return q;
+}
+
+static struct ezxml_region *ezxml_region_new(size_t size)
+{
+    struct ezxml_region tmp, *r;
+
+    tmp.head = NULL;
+    tmp.next_size = (size < EZXML_REGION_MIN) ? EZXML_REGION_MIN : size;
+    if (! (r = ezxml_region_alloc(&tmp, sizeof(struct ezxml_region)))) return NULL;
+    *r = tmp;
+    return r;
+}
+
+static void ezxml_region_destroy(struct ezxml_region *r)
+{
+    struct ezxml_chunk *c = r->head, *next;
+
+    for (; c; c = next) { // the region itself is in the last chunk
+        next = c->next;
+        th_free(c);
+    }
+}
+
+// allocation functions used by ezxml, from the current region if there is one
+static void *ezxml_malloc(size_t n)
+{
+    return (ezxml_cur_region) ? ezxml_region_alloc(ezxml_cur_region, n) : th_malloc(n);
+}
+
+static void *ezxml_realloc(void *p, size_t n)
+{
+    return (ezxml_cur_region) ? ezxml_region_realloc(ezxml_cur_region, p, n)
+                              : th_realloc(p, n);
+}
+
+static void ezxml_mfree(void *p)
+{
+    if (! ezxml_cur_region) th_free(p); // region memory is released with the region
+}
+
+static char *ezxml_strdup(const char *s)
+{
+    return th_strcpy(ezxml_malloc(th_strlen(s) + 1), s);
+}
+
 // returns the first child tag with the given name or NULL if not found
 ezxml_t ezxml_child(ezxml_t xml, const char *name)
 {
@@ -206,7 +320,7 @@ char *ezxml_decode(char *s, char **ent, char t)
             if (ent[b++]) { // found a match
                 if ((c = th_strlen(ent[b])) - 1 > (e = th_strchr(s, ';')) - s) {
                     l = (d = (s - r)) + c + th_strlen(e); // new length
-                    r = (r == m) ? th_strcpy(th_malloc(l), r) : th_realloc(r, l);
+                    r = (r == m) ? th_strcpy(ezxml_malloc(l), r) : ezxml_realloc(r, l);
                     e = th_strchr((s = r + d), ';'); // fix up pointers
                 }
 
@@ -256,10 +370,10 @@ void ezxml_char_content(ezxml_root_t root, char *s, size_t len, char t)
     if (! *(xml->txt)) xml->txt = s; // initial character content
     else { // allocate our own memory and make a copy
         xml->txt = (xml->flags & EZXML_TXTM) // allocate some space
-                   ? th_realloc(xml->txt, (l = th_strlen(xml->txt)) + len)
-                   : th_strcpy(th_malloc((l = th_strlen(xml->txt)) + len), xml->txt);
+                   ? ezxml_realloc(xml->txt, (l = th_strlen(xml->txt)) + len)
+                   : th_strcpy(ezxml_malloc((l = th_strlen(xml->txt)) + len), xml->txt);
         th_strcpy(xml->txt + l, s); // add new char content
-        if (s != m) th_free(s); // free s if it was malloced by ezxml_decode()
+        if (s != m) ezxml_mfree(s); // free s if it was malloced by ezxml_decode()
     }
 
     if (xml->txt != m) ezxml_set_flag(xml, EZXML_TXTM);
@@ -308,20 +422,20 @@ void ezxml_proc_inst(ezxml_root_t root, char *s, size_t len)
         return;
     }
 
-    if (! root->pi[0]) *(root->pi = th_malloc(sizeof(char **))) = NULL; //first pi
+    if (! root->pi[0]) *(root->pi = ezxml_malloc(sizeof(char **))) = NULL; //first pi
 
     while (root->pi[i] && th_strcmp(target, root->pi[i][0])) i++; // find target
     if (! root->pi[i]) { // new target
-        root->pi = th_realloc(root->pi, sizeof(char **) * (i + 2));
-        root->pi[i] = th_malloc(sizeof(char *) * 3);
+        root->pi = ezxml_realloc(root->pi, sizeof(char **) * (i + 2));
+        root->pi[i] = ezxml_malloc(sizeof(char *) * 3);
         root->pi[i][0] = target;
         root->pi[i][1] = (char *)(root->pi[i + 1] = NULL); // terminate pi list
-        root->pi[i][2] = th_strdup(""); // empty document position list
+        root->pi[i][2] = ezxml_strdup(""); // empty document position list
     }
 
     while (root->pi[i][j]) j++; // find end of instruction list for this target
-    root->pi[i] = th_realloc(root->pi[i], sizeof(char *) * (j + 3));
-    root->pi[i][j + 2] = th_realloc(root->pi[i][j + 1], j + 1);
+    root->pi[i] = ezxml_realloc(root->pi[i], sizeof(char *) * (j + 3));
+    root->pi[i][j + 2] = ezxml_realloc(root->pi[i][j + 1], j + 1);
     th_strcpy(root->pi[i][j + 2] + j - 1, (root->xml.name) ? ">" : "<");
     root->pi[i][j + 1] = NULL; // null terminate pi list for this target
     root->pi[i][j] = s; // set instruction
@@ -333,7 +447,7 @@ short ezxml_internal_dtd(ezxml_root_t root, char *s, size_t len)
     char q, *c, *t, *n = NULL, *v, **ent, **pe;
     int i, j;
     
-    pe = th_memcpy(th_malloc(sizeof(EZXML_NIL)), EZXML_NIL, sizeof(EZXML_NIL));
+    pe = th_memcpy(ezxml_malloc(sizeof(EZXML_NIL)), EZXML_NIL, sizeof(EZXML_NIL));
 
     for (s[len] = '\0'; s; ) {
         while (*s && *s != '<' && *s != '%') s++; // find next declaration
@@ -351,7 +465,7 @@ short ezxml_internal_dtd(ezxml_root_t root, char *s, size_t len)
             }
 
             for (i = 0, ent = (*c == '%') ? pe : root->ent; ent[i]; i++);
-            ent = th_realloc(ent, (i + 3) * sizeof(char *)); // space for next ent
+            ent = ezxml_realloc(ent, (i + 3) * sizeof(char *)); // space for next ent
             if (*c == '%') pe = ent;
             else root->ent = ent;
 
@@ -360,7 +474,7 @@ short ezxml_internal_dtd(ezxml_root_t root, char *s, size_t len)
             ent[i + 1] = ezxml_decode(v, pe, '%'); // set value
             ent[i + 2] = NULL; // null terminate entity list
             if (! ezxml_ent_ok(n, ent[i + 1], ent)) { // circular reference
-                if (ent[i + 1] != v) th_free(ent[i + 1]);
+                if (ent[i + 1] != v) ezxml_mfree(ent[i + 1]);
                 ezxml_err(root, v, "circular entity declaration &%s", n);
                 break;
             }
@@ -397,16 +511,16 @@ short ezxml_internal_dtd(ezxml_root_t root, char *s, size_t len)
                 else { ezxml_err(root, t, "malformed <!ATTLIST"); break; }
 
                 if (! root->attr[i]) { // new tag name
-                    root->attr = (! i) ? th_malloc(2 * sizeof(char **))
-                                       : th_realloc(root->attr,
+                    root->attr = (! i) ? ezxml_malloc(2 * sizeof(char **))
+                                       : ezxml_realloc(root->attr,
                                                  (i + 2) * sizeof(char **));
-                    root->attr[i] = th_malloc(2 * sizeof(char *));
+                    root->attr[i] = ezxml_malloc(2 * sizeof(char *));
                     root->attr[i][0] = t; // set tag name
                     root->attr[i][1] = (char *)(root->attr[i + 1] = NULL);
                 }
 
                 for (j = 1; root->attr[i][j]; j += 3); // find end of list
-                root->attr[i] = th_realloc(root->attr[i],
+                root->attr[i] = ezxml_realloc(root->attr[i],
                                         (j + 4) * sizeof(char *));
 
                 root->attr[i][j + 3] = NULL; // null terminate list
@@ -425,7 +539,7 @@ short ezxml_internal_dtd(ezxml_root_t root, char *s, size_t len)
         else if (*(s++) == '%' && ! root->standalone) break;
     }
 
-    th_free(pe);
+    ezxml_mfree(pe);
     return ! *root->err;
 }
 
@@ -440,7 +554,7 @@ char *ezxml_str2utf8(char **s, size_t *len)
 
     if (be == -1) return NULL; // not UTF-16
 
-    u = th_malloc(max);
+    u = ezxml_malloc(max);
     for (sl = 2; sl < *len - 1; sl += 2) {
         c = (be) ? (((*s)[sl] & 0xFF) << 8) | ((*s)[sl + 1] & 0xFF)  //UTF-16BE
                  : (((*s)[sl + 1] & 0xFF) << 8) | ((*s)[sl] & 0xFF); //UTF-16LE
@@ -450,7 +564,7 @@ char *ezxml_str2utf8(char **s, size_t *len)
             c = (((c & 0x3FF) << 10) | (d & 0x3FF)) + 0x10000;
         }
 
-        while (l + 6 > max) u = th_realloc(u, max += EZXML_BUFSIZE);
+        while (l + 6 > max) u = ezxml_realloc(u, max += EZXML_BUFSIZE);
         if (c < 0x80) u[l++] = c; // US-ASCII subset
         else { // multi-byte UTF-8 sequence
             for (b = 0, d = c; d; d /= 2) b++; // bits in c
@@ -459,7 +573,7 @@ char *ezxml_str2utf8(char **s, size_t *len)
             while (b) u[l++] = 0x80 | ((c >> (6 * --b)) & 0x3F); // payload
         }
     }
-    return *s = th_realloc(u, *len = l);
+    return *s = ezxml_realloc(u, *len = l);
 }
 
 // frees a tag attribute list
@@ -471,11 +585,11 @@ void ezxml_free_attr(char **attr) {
     while (attr[i]) i += 2; // find end of attribute list
     m = attr[i + 1]; // list of which names and values are malloced
     for (i = 0; m[i]; i++) {
-        if (m[i] & EZXML_NAMEM) th_free(attr[i * 2]);
-        if (m[i] & EZXML_TXTM) th_free(attr[(i * 2) + 1]);
+        if (m[i] & EZXML_NAMEM) ezxml_mfree(attr[i * 2]);
+        if (m[i] & EZXML_TXTM) ezxml_mfree(attr[(i * 2) + 1]);
     }
-    th_free(m);
-    th_free(attr);
+    ezxml_mfree(m);
+    ezxml_mfree(attr);
 }
 
 // parse the given xml string and return an ezxml structure
@@ -511,10 +625,10 @@ ezxml_t ezxml_parse_str(char *s, size_t len)
                 for (i = 0; (a = root->attr[i]) && th_strcmp(a[0], d); i++);
 
             for (l = 0; *s && *s != '/' && *s != '>'; l += 2) { // new attrib
-                attr = (l) ? th_realloc(attr, (l + 4) * sizeof(char *))
-                           : th_malloc(4 * sizeof(char *)); // allocate space
-                attr[l + 3] = (l) ? th_realloc(attr[l + 1], (l / 2) + 2)
-                                  : th_malloc(2); // mem for list of maloced vals
+                attr = (l) ? ezxml_realloc(attr, (l + 4) * sizeof(char *))
+                           : ezxml_malloc(4 * sizeof(char *)); // allocate space
+                attr[l + 3] = (l) ? ezxml_realloc(attr[l + 1], (l / 2) + 2)
+                                  : ezxml_malloc(2); // mem for list of maloced vals
                 th_strcpy(attr[l + 3] + (l / 2), " "); // value is not malloced
                 attr[l + 2] = NULL; // null terminate list
                 attr[l + 1] = ""; // temporary attribute value
@@ -611,6 +725,318 @@ ezxml_t ezxml_parse_str(char *s, size_t len)
     else return ezxml_err(root, d, "unclosed tag <%s>", root->cur->name);
 }
 
+// Structural character scanner for ezxml_parse_str_v(). Classifies a 64 byte
+// block at a time into a bitmask of the requested character classes,
+// in the style of simdjson, and returns the first match. The terminating null
+// is always part of the set. Only whole blocks before the end of the work area
+// are loaded, the rest is scanned one character at a time with a class table.
+#define EZXML_V_LT    0x001 // <
+#define EZXML_V_GT    0x002 // >
+#define EZXML_V_EQ    0x004 // =
+#define EZXML_V_SLASH 0x008 // /
+#define EZXML_V_QUOT  0x010 // "
+#define EZXML_V_APOS  0x020 // '
+#define EZXML_V_AMP   0x040 // &
+#define EZXML_V_SP    0x080 // space
+#define EZXML_V_TAB   0x100 // \t
+#define EZXML_V_NL    0x200 // \n
+#define EZXML_V_CR    0x400 // \r
+#define EZXML_V_WS    (EZXML_V_SP | EZXML_V_TAB | EZXML_V_NL | EZXML_V_CR)
+
+static const unsigned short ezxml_vclass[256] = {
+    ['<'] = EZXML_V_LT, ['>'] = EZXML_V_GT, ['='] = EZXML_V_EQ,
+    ['/'] = EZXML_V_SLASH, ['"'] = EZXML_V_QUOT, ['\''] = EZXML_V_APOS,
+    ['&'] = EZXML_V_AMP, [' '] = EZXML_V_SP, ['\t'] = EZXML_V_TAB,
+    ['\n'] = EZXML_V_NL, ['\r'] = EZXML_V_CR
+};
+
+// one character at a time, up to the terminating null
+static inline char *ezxml_vscan_tail(char *s, unsigned set)
+{
+    while (*s && ! (ezxml_vclass[(unsigned char)*s] & set)) s++;
+    return s;
+}
+
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512BW__))
+#define EZXML_VBLOCK 64
+typedef unsigned long long ezxml_vmask;
+#if defined(__AVX512BW__)
+#define EZXML_VCMP(set, bit, ch) \
+    if ((set) & (bit)) m |= _mm512_cmpeq_epi8_mask(c, _mm512_set1_epi8(ch))
+static inline ezxml_vmask ezxml_vblock(const char *p, unsigned set)
+{
+    __m512i c = _mm512_loadu_si512((const void *)p);
+    ezxml_vmask m = _mm512_cmpeq_epi8_mask(c, _mm512_setzero_si512());
+#elif defined(__AVX2__)
+#define EZXML_VCMP(set, bit, ch) \
+    if ((set) & (bit)) { \
+        __m256i k = _mm256_set1_epi8(ch); \
+        lo = _mm256_or_si256(lo, _mm256_cmpeq_epi8(c0, k)); \
+        hi = _mm256_or_si256(hi, _mm256_cmpeq_epi8(c1, k)); \
+    }
+static inline ezxml_vmask ezxml_vblock(const char *p, unsigned set)
+{
+    __m256i c0 = _mm256_loadu_si256((const __m256i *)p);
+    __m256i c1 = _mm256_loadu_si256((const __m256i *)(p + 32));
+    __m256i lo = _mm256_cmpeq_epi8(c0, _mm256_setzero_si256());
+    __m256i hi = _mm256_cmpeq_epi8(c1, _mm256_setzero_si256());
+    ezxml_vmask m;
+#else
+#define EZXML_VCMP(set, bit, ch) \
+    if ((set) & (bit)) { \
+        __m128i k = _mm_set1_epi8(ch); \
+        v0 = _mm_or_si128(v0, _mm_cmpeq_epi8(c0, k)); \
+        v1 = _mm_or_si128(v1, _mm_cmpeq_epi8(c1, k)); \
+        v2 = _mm_or_si128(v2, _mm_cmpeq_epi8(c2, k)); \
+        v3 = _mm_or_si128(v3, _mm_cmpeq_epi8(c3, k)); \
+    }
+static inline ezxml_vmask ezxml_vblock(const char *p, unsigned set)
+{
+    __m128i c0 = _mm_loadu_si128((const __m128i *)p);
+    __m128i c1 = _mm_loadu_si128((const __m128i *)(p + 16));
+    __m128i c2 = _mm_loadu_si128((const __m128i *)(p + 32));
+    __m128i c3 = _mm_loadu_si128((const __m128i *)(p + 48));
+    __m128i v0 = _mm_cmpeq_epi8(c0, _mm_setzero_si128());
+    __m128i v1 = _mm_cmpeq_epi8(c1, _mm_setzero_si128());
+    __m128i v2 = _mm_cmpeq_epi8(c2, _mm_setzero_si128());
+    __m128i v3 = _mm_cmpeq_epi8(c3, _mm_setzero_si128());
+    ezxml_vmask m;
+#endif
+    EZXML_VCMP(set, EZXML_V_LT, '<');
+    EZXML_VCMP(set, EZXML_V_GT, '>');
+    EZXML_VCMP(set, EZXML_V_EQ, '=');
+    EZXML_VCMP(set, EZXML_V_SLASH, '/');
+    EZXML_VCMP(set, EZXML_V_QUOT, '"');
+    EZXML_VCMP(set, EZXML_V_APOS, '\'');
+    EZXML_VCMP(set, EZXML_V_AMP, '&');
+    EZXML_VCMP(set, EZXML_V_SP, ' ');
+    EZXML_VCMP(set, EZXML_V_TAB, '\t');
+    EZXML_VCMP(set, EZXML_V_NL, '\n');
+    EZXML_VCMP(set, EZXML_V_CR, '\r');
+#if defined(__AVX512BW__)
+#elif defined(__AVX2__)
+    m = (unsigned)_mm256_movemask_epi8(lo) |
+        ((ezxml_vmask)(unsigned)_mm256_movemask_epi8(hi) << 32);
+#else
+    m = (unsigned)_mm_movemask_epi8(v0) |
+        ((ezxml_vmask)(unsigned)_mm_movemask_epi8(v1) << 16) |
+        ((ezxml_vmask)(unsigned)_mm_movemask_epi8(v2) << 32) |
+        ((ezxml_vmask)(unsigned)_mm_movemask_epi8(v3) << 48);
+#endif
+    return m;
+}
+#undef EZXML_VCMP
+
+// return the first character at or after s in the set, or the terminating null.
+// end is the end of the work area, nothing at or after it is read.
+static inline char *ezxml_vscan(char *s, char *end, unsigned set)
+{
+    ezxml_vmask m;
+
+    for (; s + EZXML_VBLOCK <= end; s += EZXML_VBLOCK)
+        if ((m = ezxml_vblock(s, set))) return s + __builtin_ctzll(m);
+    return ezxml_vscan_tail(s, set);
+}
+#else // portable version, one character at a time with the class table
+static inline char *ezxml_vscan(char *s, char *end, unsigned set)
+{
+    return ezxml_vscan_tail(s, set);
+}
+#endif
+
+// ezxml_decode() for ezxml_parse_str_v(). Strings without anything to decode
+// for type t are detected with one scan and returned as is.
+static char *ezxml_decode_v(char *s, char *end, char **ent, char t)
+{
+    unsigned set;
+
+    switch (t) {
+        case 'c': set = EZXML_V_CR; break;
+        case '&': set = EZXML_V_CR | EZXML_V_AMP; break;
+        case ' ': set = EZXML_V_CR | EZXML_V_AMP | EZXML_V_TAB | EZXML_V_NL; break;
+        default: return ezxml_decode(s, ent, t);
+    }
+    if (! *ezxml_vscan(s, end, set)) return s;
+    return ezxml_decode(s, ent, t);
+}
+
+// ezxml_char_content() for ezxml_parse_str_v()
+static void ezxml_char_content_v(ezxml_root_t root, char *s, size_t len, char t)
+{
+    ezxml_t xml = root->cur;
+    char *m = s;
+    size_t l;
+
+    if (! xml || ! xml->name || ! len) return; // sanity check
+
+    s[len] = '\0'; // null terminate text (calling functions anticipate this)
+    s = ezxml_decode_v(s, root->e, root->ent, t);
+    len = (s == m) ? len + 1 : th_strlen(s) + 1;
+
+    if (! *(xml->txt)) xml->txt = s; // initial character content
+    else { // allocate our own memory and make a copy
+        xml->txt = (xml->flags & EZXML_TXTM) // allocate some space
+                   ? ezxml_realloc(xml->txt, (l = th_strlen(xml->txt)) + len)
+                   : th_strcpy(ezxml_malloc((l = th_strlen(xml->txt)) + len), xml->txt);
+        th_strcpy(xml->txt + l, s); // add new char content
+        if (s != m) ezxml_mfree(s); // free s if it was malloced by ezxml_decode()
+    }
+
+    if (xml->txt != m) ezxml_set_flag(xml, EZXML_TXTM);
+}
+
+// Same as ezxml_parse_str(), but finds structural characters with
+// ezxml_vscan() instead of one character at a time, and grows attribute
+// arrays geometrically instead of once per attribute. Builds the same tree.
+ezxml_t ezxml_parse_str_v(char *s, size_t len)
+{
+    ezxml_root_t root = (ezxml_root_t)ezxml_new(NULL);
+    char q, e, *d, *m, **attr, **a = NULL; // initialize a to avoid compile warning
+    int l, i, j, cap;
+
+    root->m = s;
+    if (! len) return ezxml_err(root, NULL, "root tag missing");
+    root->u = ezxml_str2utf8(&s, &len); // convert utf-16 to utf-8
+    root->e = (root->s = s) + len; // record start and end of work area
+    
+    e = s[len - 1]; // save end char
+    s[len - 1] = '\0'; // turn end char into null terminator
+
+    s = ezxml_vscan(s, root->e, EZXML_V_LT); // find first tag
+    if (! *s) return ezxml_err(root, s, "root tag missing");
+
+    for (; ; ) {
+        attr = (char **)EZXML_NIL;
+        d = ++s;
+        
+        if (isalpha((int)(*s)) || *s == '_' || *s == ':' || *s < '\0') { // new tag
+            if (! root->cur)
+                return ezxml_err(root, d, "markup outside of root element");
+
+            s = ezxml_vscan(s, root->e, EZXML_V_WS | EZXML_V_SLASH | EZXML_V_GT);
+            while (isspace((int)(*s))) *(s++) = '\0'; // null terminate tag name
+  
+            if (*s && *s != '/' && *s != '>') // find tag in default attr list
+                for (i = 0; (a = root->attr[i]) && th_strcmp(a[0], d); i++);
+
+            for (l = 0, cap = 0, m = NULL; *s && *s != '/' && *s != '>'; l += 2) { // new attrib
+                if (l + 4 > cap) { // grow attr and the list of malloced vals
+                    cap = (cap) ? cap * 2 : 8;
+                    attr = (l) ? ezxml_realloc(attr, cap * sizeof(char *))
+                               : ezxml_malloc(cap * sizeof(char *));
+                    m = (l) ? ezxml_realloc(m, cap / 2) : ezxml_malloc(cap / 2);
+                }
+                attr[l + 3] = m; // mem for list of maloced vals
+                th_strcpy(attr[l + 3] + (l / 2), " "); // value is not malloced
+                attr[l + 2] = NULL; // null terminate list
+                attr[l + 1] = ""; // temporary attribute value
+                attr[l] = s; // set attribute name
+
+                s = ezxml_vscan(s, root->e, EZXML_V_WS | EZXML_V_EQ | EZXML_V_SLASH | EZXML_V_GT);
+                if (*s == '=' || isspace((int)(*s))) { 
+                    *(s++) = '\0'; // null terminate tag attribute name
+                    q = *(s += th_strspn(s, EZXML_WS "="));
+                    if (q == '"' || q == '\'') { // attribute value
+                        attr[l + 1] = ++s;
+                        s = ezxml_vscan(s, root->e, (q == '"') ? EZXML_V_QUOT : EZXML_V_APOS);
+                        if (*s) *(s++) = '\0'; // null terminate attribute val
+                        else {
+                            ezxml_free_attr(attr);
+                            return ezxml_err(root, d, "missing %c", q);
+                        }
+
+                        for (j = 1; a && a[j] && th_strcmp(a[j], attr[l]); j +=3);
+                        attr[l + 1] = ezxml_decode_v(attr[l + 1], root->e, root->ent, (a
+                                                     && a[j]) ? *a[j + 2] : ' ');
+                        if (attr[l + 1] < d || attr[l + 1] > s)
+                            attr[l + 3][l / 2] = EZXML_TXTM; // value malloced
+                    }
+                }
+                while (isspace((int)(*s))) s++;
+            }
+
+            if (*s == '/') { // self closing tag
+                *(s++) = '\0';
+                if ((*s && *s != '>') || (! *s && e != '>')) {
+                    if (l) ezxml_free_attr(attr);
+                    return ezxml_err(root, d, "missing >");
+                }
+                ezxml_open_tag(root, d, attr);
+                ezxml_close_tag(root, d, s);
+            }
+            else if ((q = *s) == '>' || (! *s && e == '>')) { // open tag
+                *s = '\0'; // temporarily null terminate tag name
+                ezxml_open_tag(root, d, attr);
+                *s = q;
+            }
+            else {
+                if (l) ezxml_free_attr(attr);
+                return ezxml_err(root, d, "missing >"); 
+            }
+        }
+        else if (*s == '/') { // close tag
+            s = ezxml_vscan(d = s + 1, root->e, EZXML_V_WS | EZXML_V_GT);
+            if (! (q = *s) && e != '>') return ezxml_err(root, d, "missing >");
+            *s = '\0'; // temporarily null terminate tag name
+            if (ezxml_close_tag(root, d, s)) return &root->xml;
+            if (isspace((int)(*s = q))) s += th_strspn(s, EZXML_WS);
+        }
+        else if (! th_strncmp(s, "!--", 3)) { // xml comment
+            if (! (s = th_strstr(s + 3, "--")) || (*(s += 2) != '>' && *s) ||
+                (! *s && e != '>')) return ezxml_err(root, d, "unclosed <!--");
+        }
+        else if (! th_strncmp(s, "![CDATA[", 8)) { // cdata
+            if ((s = th_strstr(s, "]]>")))
+                ezxml_char_content_v(root, d + 8, (s += 2) - d - 10, 'c');
+            else return ezxml_err(root, d, "unclosed <![CDATA[");
+        }
+        else if (! th_strncmp(s, "!DOCTYPE", 8)) { // dtd
+            for (l = 0; *s && ((! l && *s != '>') || (l && (*s != ']' || 
+                 *(s + th_strspn(s + 1, EZXML_WS) + 1) != '>')));
+                 l = (*s == '[') ? 1 : l) s += th_strcspn(s + 1, "[]>") + 1;
+            if (! *s && e != '>')
+                return ezxml_err(root, d, "unclosed <!DOCTYPE");
+            d = (l) ? th_strchr(d, '[') + 1 : d;
+            if (l && ! ezxml_internal_dtd(root, d, s++ - d)) return &root->xml;
+        }
+        else if (*s == '?') { // <?...?> processing instructions
+            do { s = th_strchr(s, '?'); } while (s && *(++s) && *s != '>');
+            if (! s || (! *s && e != '>')) 
+                return ezxml_err(root, d, "unclosed <?");
+            else ezxml_proc_inst(root, d + 1, s - d - 2);
+        }
+        else return ezxml_err(root, d, "unexpected <");
+        
+        if (! s || ! *s) break;
+        *s = '\0';
+        d = ++s;
+        if (*s && *s != '<') { // tag character content
+            s = ezxml_vscan(s, root->e, EZXML_V_LT);
+            if (*s) ezxml_char_content_v(root, d, s - d, '&');
+            else break;
+        }
+        else if (! *s) break;
+    }
+
+    if (! root->cur) return &root->xml;
+    else if (! root->cur->name) return ezxml_err(root, d, "root tag missing");
+    else return ezxml_err(root, d, "unclosed tag <%s>", root->cur->name);
+}
+
+// parse the given xml string into a tree allocated from a single region
+ezxml_t ezxml_parse_str_arena(char *s, size_t len, int vector)
+{
+    struct ezxml_region *r = ezxml_region_new(len * EZXML_REGION_RATIO);
+    ezxml_t xml;
+
+    if (! r) return NULL;
+    ezxml_cur_region = r;
+    xml = (vector) ? ezxml_parse_str_v(s, len) : ezxml_parse_str(s, len);
+    ezxml_cur_region = NULL;
+    ((ezxml_root_t)xml)->region = r;
+    return xml;
+}
+
 // Wrapper for ezxml_parse_str() that accepts a file stream. Reads the entire
 // stream into memory and then parses it. For xml files, use ezxml_parse_file()
 // or ezxml_parse_fd()
@@ -620,10 +1046,10 @@ ezxml_t ezxml_parse_fp(ee_FILE *fp)
     size_t l, len = 0;
     char *s;
 
-    if (! (s = th_malloc(EZXML_BUFSIZE))) return NULL;
+    if (! (s = ezxml_malloc(EZXML_BUFSIZE))) return NULL;
     do {
         len += (l = th_fread((s + len), 1, EZXML_BUFSIZE, fp));
-        if (l == EZXML_BUFSIZE) s = th_realloc(s, len + EZXML_BUFSIZE);
+        if (l == EZXML_BUFSIZE) s = ezxml_realloc(s, len + EZXML_BUFSIZE);
     } while (s && l == EZXML_BUFSIZE);
 
     if (! s) return NULL;
@@ -651,7 +1077,7 @@ char *ezxml_ampencode(const char *s, size_t len, char **dst, size_t *dlen,
     const char *e;
     
     for (e = s + len; s != e; s++) {
-        while (*dlen + 10 > *max) *dst = th_realloc(*dst, *max += EZXML_BUFSIZE);
+        while (*dlen + 10 > *max) *dst = ezxml_realloc(*dst, *max += EZXML_BUFSIZE);
 
         switch (*s) {
         case '\0': return *dst;
@@ -682,13 +1108,13 @@ char *ezxml_toxml_r(ezxml_t xml, char **s, size_t *len, size_t *max,
     *s = ezxml_ampencode(txt + start, xml->off - start, s, len, max, 0);
 
     while (*len + th_strlen(xml->name) + 4 > *max) // reallocate s
-        *s = th_realloc(*s, *max += EZXML_BUFSIZE);
+        *s = ezxml_realloc(*s, *max += EZXML_BUFSIZE);
 
     *len += th_sprintf(*s + *len, "<%s", xml->name); // open tag
     for (i = 0; xml->attr[i]; i += 2) { // tag attributes
         if (ezxml_attr(xml, xml->attr[i]) != xml->attr[i + 1]) continue;
         while (*len + th_strlen(xml->attr[i]) + 7 > *max) // reallocate s
-            *s = th_realloc(*s, *max += EZXML_BUFSIZE);
+            *s = ezxml_realloc(*s, *max += EZXML_BUFSIZE);
 
         *len += th_sprintf(*s + *len, " %s=\"", xml->attr[i]);
         ezxml_ampencode(xml->attr[i + 1], -1, s, len, max, 1);
@@ -700,7 +1126,7 @@ char *ezxml_toxml_r(ezxml_t xml, char **s, size_t *len, size_t *max,
         if (! attr[i][j + 1] || ezxml_attr(xml, attr[i][j]) != attr[i][j + 1])
             continue; // skip duplicates and non-values
         while (*len + th_strlen(attr[i][j]) + 7 > *max) // reallocate s
-            *s = th_realloc(*s, *max += EZXML_BUFSIZE);
+            *s = ezxml_realloc(*s, *max += EZXML_BUFSIZE);
 
         *len += th_sprintf(*s + *len, " %s=\"", attr[i][j]);
         ezxml_ampencode(attr[i][j + 1], -1, s, len, max, 1);
@@ -712,7 +1138,7 @@ char *ezxml_toxml_r(ezxml_t xml, char **s, size_t *len, size_t *max,
                       : ezxml_ampencode(xml->txt, -1, s, len, max, 0);  //data
     
     while (*len + th_strlen(xml->name) + 4 > *max) // reallocate s
-        *s = th_realloc(*s, *max += EZXML_BUFSIZE);
+        *s = ezxml_realloc(*s, *max += EZXML_BUFSIZE);
 
     *len += th_sprintf(*s + *len, "</%s>", xml->name); // close tag
 
@@ -728,10 +1154,10 @@ char *ezxml_toxml(ezxml_t xml)
     ezxml_t p = (xml) ? xml->parent : NULL, o = (xml) ? xml->ordered : NULL;
     ezxml_root_t root = (ezxml_root_t)xml;
     size_t len = 0, max = EZXML_BUFSIZE;
-    char *s = th_strcpy(th_malloc(max), ""), *t, *n;
+    char *s = th_strcpy(ezxml_malloc(max), ""), *t, *n;
     int i, j, k;
 
-    if (! xml || ! xml->name) return th_realloc(s, len + 1);
+    if (! xml || ! xml->name) return ezxml_realloc(s, len + 1);
     while (root->xml.parent) root = (ezxml_root_t)root->xml.parent; // root tag
 
     for (i = 0; ! p && root->pi[i]; i++) { // pre-root processing instructions
@@ -739,7 +1165,7 @@ char *ezxml_toxml(ezxml_t xml)
         for (j = 1; (n = root->pi[i][j]); j++) {
             if (root->pi[i][k][j - 1] == '>') continue; // not pre-root
             while (len + th_strlen(t = root->pi[i][0]) + th_strlen(n) + 7 > max)
-                s = th_realloc(s, max += EZXML_BUFSIZE);
+                s = ezxml_realloc(s, max += EZXML_BUFSIZE);
             len += th_sprintf(s + len, "<?%s%s%s?>\n", t, *n ? " " : "", n);
         }
     }
@@ -754,11 +1180,11 @@ char *ezxml_toxml(ezxml_t xml)
         for (j = 1; (n = root->pi[i][j]); j++) {
             if (root->pi[i][k][j - 1] == '<') continue; // not post-root
             while (len + th_strlen(t = root->pi[i][0]) + th_strlen(n) + 7 > max)
-                s = th_realloc(s, max += EZXML_BUFSIZE);
+                s = ezxml_realloc(s, max += EZXML_BUFSIZE);
             len += th_sprintf(s + len, "\n<?%s%s%s?>", t, *n ? " " : "", n);
         }
     }
-    return th_realloc(s, len + 1);
+    return ezxml_realloc(s, len + 1);
 }
 
 // th_free the memory allocated for the ezxml structure
@@ -769,36 +1195,40 @@ void ezxml_free(ezxml_t xml)
     char **a, *s;
 
     if (! xml) return;
+    if (! xml->parent && root->region) { // tree allocated from a region
+        ezxml_region_destroy(root->region);
+        return;
+    }
     ezxml_free(xml->child);
     ezxml_free(xml->ordered);
 
     if (! xml->parent) { // th_free root tag allocations
         for (i = 10; root->ent[i]; i += 2) // 0 - 9 are default entites (<>&"')
-            if ((s = root->ent[i + 1]) < root->s || s > root->e) th_free(s);
-        th_free(root->ent); // free list of general entities
+            if ((s = root->ent[i + 1]) < root->s || s > root->e) ezxml_mfree(s);
+        ezxml_mfree(root->ent); // free list of general entities
 
         for (i = 0; (a = root->attr[i]); i++) {
             for (j = 1; a[j++]; j += 2) // th_free malloced attribute values
-                if (a[j] && (a[j] < root->s || a[j] > root->e)) th_free(a[j]);
-            th_free(a);
+                if (a[j] && (a[j] < root->s || a[j] > root->e)) ezxml_mfree(a[j]);
+            ezxml_mfree(a);
         }
-        if (root->attr[0]) th_free(root->attr); // free default attribute list
+        if (root->attr[0]) ezxml_mfree(root->attr); // free default attribute list
 
         for (i = 0; root->pi[i]; i++) {
             for (j = 1; root->pi[i][j]; j++);
-            th_free(root->pi[i][j + 1]);
-            th_free(root->pi[i]);
+            ezxml_mfree(root->pi[i][j + 1]);
+            ezxml_mfree(root->pi[i]);
         }            
-        if (root->pi[0]) th_free(root->pi); // free processing instructions
+        if (root->pi[0]) ezxml_mfree(root->pi); // free processing instructions
 
-        if (root->len == -1) th_free(root->m); // malloced xml data
-        if (root->u) th_free(root->u); // utf8 conversion
+        if (root->len == -1) ezxml_mfree(root->m); // malloced xml data
+        if (root->u) ezxml_mfree(root->u); // utf8 conversion
     }
 
     ezxml_free_attr(xml->attr); // tag attributes
-    if ((xml->flags & EZXML_TXTM)) th_free(xml->txt); // character content
-    if ((xml->flags & EZXML_NAMEM)) th_free(xml->name); // tag name
-    th_free(xml);
+    if ((xml->flags & EZXML_TXTM)) ezxml_mfree(xml->txt); // character content
+    if ((xml->flags & EZXML_NAMEM)) ezxml_mfree(xml->name); // tag name
+    ezxml_mfree(xml);
 }
 
 // return parser error message or empty string if none
@@ -813,12 +1243,12 @@ ezxml_t ezxml_new(const char *name)
 {
     static char *ent[] = { "lt;", "&#60;", "gt;", "&#62;", "quot;", "&#34;",
                            "apos;", "&#39;", "amp;", "&#38;", NULL };
-    ezxml_root_t root = (ezxml_root_t)th_memset(th_malloc(sizeof(struct ezxml_root)), 
+    ezxml_root_t root = (ezxml_root_t)th_memset(ezxml_malloc(sizeof(struct ezxml_root)), 
                                              '\0', sizeof(struct ezxml_root));
     root->xml.name = (char *)name;
     root->cur = &root->xml;
     th_strcpy(root->err, root->xml.txt = "");
-    root->ent = th_memcpy(th_malloc(sizeof(ent)), ent, sizeof(ent));
+    root->ent = th_memcpy(ezxml_malloc(sizeof(ent)), ent, sizeof(ent));
     root->attr = root->pi = (char ***)(root->xml.attr = EZXML_NIL);
     return &root->xml;
 }
@@ -872,7 +1302,7 @@ ezxml_t ezxml_add_child(ezxml_t xml, const char *name, size_t off)
     ezxml_t child;
 
     if (! xml) return NULL;
-    child = (ezxml_t)th_memset(th_malloc(sizeof(struct ezxml)), '\0',
+    child = (ezxml_t)th_memset(ezxml_malloc(sizeof(struct ezxml)), '\0',
                             sizeof(struct ezxml));
     child->name = (char *)name;
     child->attr = EZXML_NIL;
@@ -885,7 +1315,7 @@ ezxml_t ezxml_add_child(ezxml_t xml, const char *name, size_t off)
 ezxml_t ezxml_set_txt(ezxml_t xml, const char *txt)
 {
     if (! xml) return NULL;
-    if (xml->flags & EZXML_TXTM) th_free(xml->txt); // existing txt was malloced
+    if (xml->flags & EZXML_TXTM) ezxml_mfree(xml->txt); // existing txt was malloced
     xml->flags &= ~EZXML_TXTM;
     xml->txt = (char *)txt;
     return xml;
@@ -902,30 +1332,30 @@ ezxml_t ezxml_set_attr(ezxml_t xml, const char *name, const char *value)
     if (! xml->attr[l]) { // not found, add as new attribute
         if (! value) return xml; // nothing to do
         if (xml->attr == EZXML_NIL) { // first attribute
-            xml->attr = th_malloc(4 * sizeof(char *));
-            xml->attr[1] = th_strdup(""); // empty list of malloced names/vals
+            xml->attr = ezxml_malloc(4 * sizeof(char *));
+            xml->attr[1] = ezxml_strdup(""); // empty list of malloced names/vals
         }
-        else xml->attr = th_realloc(xml->attr, (l + 4) * sizeof(char *));
+        else xml->attr = ezxml_realloc(xml->attr, (l + 4) * sizeof(char *));
 
         xml->attr[l] = (char *)name; // set attribute name
         xml->attr[l + 2] = NULL; // null terminate attribute list
-        xml->attr[l + 3] = th_realloc(xml->attr[l + 1],
+        xml->attr[l + 3] = ezxml_realloc(xml->attr[l + 1],
                                    (c = th_strlen(xml->attr[l + 1])) + 2);
         th_strcpy(xml->attr[l + 3] + c, " "); // set name/value as not malloced
         if (xml->flags & EZXML_DUP) xml->attr[l + 3][c] = EZXML_NAMEM;
     }
-    else if (xml->flags & EZXML_DUP) th_free((char *)name); // name was strduped
+    else if (xml->flags & EZXML_DUP) ezxml_mfree((char *)name); // name was strduped
 
     for (c = l; xml->attr[c]; c += 2); // find end of attribute list
-    if (xml->attr[c + 1][l / 2] & EZXML_TXTM) th_free(xml->attr[l + 1]); //old val
+    if (xml->attr[c + 1][l / 2] & EZXML_TXTM) ezxml_mfree(xml->attr[l + 1]); //old val
     if (xml->flags & EZXML_DUP) xml->attr[c + 1][l / 2] |= EZXML_TXTM;
     else xml->attr[c + 1][l / 2] &= ~EZXML_TXTM;
 
     if (value) xml->attr[l + 1] = (char *)value; // set attribute value
     else { // remove attribute
-        if (xml->attr[c + 1][l / 2] & EZXML_NAMEM) th_free(xml->attr[l]);
+        if (xml->attr[c + 1][l / 2] & EZXML_NAMEM) ezxml_mfree(xml->attr[l]);
         th_memmove(xml->attr + l, xml->attr + l + 2, (c - l + 2) * sizeof(char*));
-        xml->attr = th_realloc(xml->attr, (c + 2) * sizeof(char *));
+        xml->attr = ezxml_realloc(xml->attr, (c + 2) * sizeof(char *));
         th_memmove(xml->attr[c + 1] + (l / 2), xml->attr[c + 1] + (l / 2) + 1,
                 (c / 2) - (l / 2)); // fix list of which name/vals are malloced
     }
@@ -985,7 +1415,7 @@ int main(int argc, char **argv)
 
     xml = ezxml_parse_file(argv[1]);
     th_printf("%s\n", (s = ezxml_toxml(xml)));
-    th_free(s);
+    ezxml_mfree(s);
     i = th_fprintf(th_stderr, "%s", ezxml_error(xml));
     ezxml_free(xml);
     return (i) ? 1 : 0;
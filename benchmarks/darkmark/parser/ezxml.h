@@ -72,6 +72,16 @@ struct ezxml {
 // pass in the copy. Returns NULL on failure.
 ezxml_t ezxml_parse_str(char *s, size_t len);
 
+// Same as ezxml_parse_str(), but scans for structural characters a block of
+// 64 bytes at a time with SIMD compares when available.
+ezxml_t ezxml_parse_str_v(char *s, size_t len);
+
+// Same as ezxml_parse_str(), or ezxml_parse_str_v() if vector is non-zero,
+// but the tree, attribute lists and decoded text are allocated from a single
+// growable region owned by the root. ezxml_free() of the root releases it at
+// once. The tree should not be modified with the ezxml_set_* functions.
+ezxml_t ezxml_parse_str_arena(char *s, size_t len, int vector);
+
 // A wrapper for ezxml_parse_str() that accepts a file descriptor. First
 // attempts to mem map the file. Failing that, reads the file into memory.
 // Returns NULL on failure.
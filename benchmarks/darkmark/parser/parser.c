@@ -23,6 +23,7 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include "th_rand.h" /* initialize a random data vector */
 #include "th_types.h"
 
+#include "mith_workload.h"
 #include "ezxml.h"
 
 typedef struct parser_params_s {
@@ -34,6 +35,9 @@ typedef struct parser_params_s {
 	e_u16 parser_result;
 	char *filename;
 	e_s32 debug;
+	mith_input_t *xml_in; /* xml_buf shared by all contexts */
+	e_s32 tokenizer; /* 0 - ezxml_parse_str, 1 - SIMD tokenizer (ezxml_parse_str_v) */
+	e_s32 arena; /* if non zero, build the tree in a single region (ezxml_parse_str_arena) */
 } parser_params;
 
 //parser_params presets_parser[NUM_DATAS];
@@ -158,6 +162,8 @@ void *define_params_parser(unsigned int idx, char *name, char *dataset) {
 		th_parse_buf_flag(dataset,"-g",&params->gen_ref);
 		th_parse_buf_flag(dataset,"-d",&params->debug);
 		th_get_buf_flag(dataset,"-f=",&params->filename);
+		th_parse_buf_flag(dataset,"-m=",&params->tokenizer);
+		th_parse_buf_flag(dataset,"-a=",&params->arena);
 	}
 	if (params->filename) { /* file name defined, read into buf) */
 		ee_FILE *f=th_fopen(params->filename,"rb");
@@ -175,6 +181,13 @@ void *define_params_parser(unsigned int idx, char *name, char *dataset) {
 			rand_fini(r);
 		}
 	}
+	/* the input is only generated once, all contexts read the same copy */
+	if (params->xml_buf!=NULL) {
+		params->xml_in=mith_input_share(params->xml_buf,params->buf_len);
+		if (params->xml_buf!=default_xml)
+			th_free(params->xml_buf);
+		params->xml_buf=(char *)params->xml_in->data;
+	}
 	
 	return params;
 }
@@ -184,7 +197,9 @@ int bmark_clean_parser(void *in_params) {
 	parser_params *params=(parser_params *)in_params;
 	if (in_params==NULL)
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
-	if(params->xml_buf!=NULL)
+	if (params->xml_in!=NULL)
+		mith_input_release(params->xml_in);
+	else if (params->xml_buf!=NULL)
 		th_free(params->xml_buf);
 	th_free(params);
 	return 1;
@@ -199,11 +214,8 @@ void *bmark_init_parser(void *in_params) {
 	if ( myparams == NULL )
           th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	th_memcpy(myparams,params,sizeof(parser_params));
-	myparams->xml_buf=(char *)th_malloc(params->buf_len);
-	if (myparams->xml_buf==NULL)
-          th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
-		
-	th_memcpy(myparams->xml_buf,params->xml_buf,params->buf_len);
+	/* ezxml terminates tokens inside the buffer, so each execution needs a private view */
+	myparams->xml_buf=(char *)mith_input_private(params->xml_in);
 
 	return myparams;
 }
@@ -213,7 +225,7 @@ void *bmark_fini_parser(void *in_params) {
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
 	params=(parser_params *)in_params;
 	if (params->xml_buf)
-		th_free(params->xml_buf);
+		mith_input_private_free(params->xml_in,params->xml_buf);
 	
 	th_free(params);
 
@@ -227,7 +239,12 @@ void *t_run_test_parser(struct TCDef *tcdef,void *in_params) {
 	const char *scene;
 	tcdef->expected_CRC=0;
 	/* initial parser into tree */
-	top=ezxml_parse_str(params->xml_buf,params->buf_len);
+	if (params->arena)
+		top=ezxml_parse_str_arena(params->xml_buf,params->buf_len,params->tokenizer);
+	else if (params->tokenizer)
+		top=ezxml_parse_str_v(params->xml_buf,params->buf_len);
+	else
+		top=ezxml_parse_str(params->xml_buf,params->buf_len);
 	if (!top)
 		th_exit(THE_BAD_PTR,"Invalid XML\n");
 	/* get body element */
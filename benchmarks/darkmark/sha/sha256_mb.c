@@ -0,0 +1,396 @@
+/*
+(C) 2014 EEMBC(R).  All rights reserved.
+
+All EEMBC Benchmark Software are products of EEMBC
+and are provided under the terms of the EEMBC Benchmark License Agreements.
+The EEMBC Benchmark Software are proprietary intellectual properties of EEMBC and its Members
+and is protected under all applicable laws, including all applicable copyright laws.
+If you received this EEMBC Benchmark Software without having
+a currently effective EEMBC Benchmark License Agreement, you must discontinue use.
+Please refer to LICENSE.md for the specific license agreement that pertains to this Benchmark Software.
+*/
+
+/* File: benchmarks/darkmark/sha/sha256_mb.c
+	Multi buffer SHA-256.
+
+	Independent messages are hashed in parallel, one message per SIMD lane.
+	Each call to a compression backend runs one 64 byte block of every lane,
+	using a transposed layout where row i holds word i of all lanes.
+	When a message is done, the next pending message is started in the free lane.
+
+	Backends:
+	sse2 - 4 lanes, x86.
+	avx2 - 8 lanes, x86, selected at run time if the processor supports it.
+	avx512 - 16 lanes, x86, selected at run time if the processor supports it.
+	rvv - up to 16 lanes, RISC-V vector extension (USE_RVV).
+	generic - portable C, any number of lanes.
+
+	Define SHA_MB_NO_SIMD to only build the portable backend.
+*/
+#include "th_cfg.h"
+#include "th_lib.h"
+#include "shabench.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(SHA_MB_NO_SIMD)
+#define SHA_MB_X86 1
+#include <immintrin.h>
+#else
+#define SHA_MB_X86 0
+#endif
+#if defined(USE_RVV) && USE_RVV && !defined(SHA_MB_NO_SIMD)
+#define SHA_MB_RVV 1
+#else
+#define SHA_MB_RVV 0
+#endif
+
+#define SHA2_BLOCK_SIZE (64)
+
+static const e_u32 sha_mb_k[64] = {
+	0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+	0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+	0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+	0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+	0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+	0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+	0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
+};
+
+static const e_u32 sha_mb_iv[8] = {
+	0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19
+};
+
+/* transposed state and message block of all lanes */
+typedef e_u32 sha_mb_row[SHA_MB_MAX_LANES];
+typedef void (*sha_mb_compress_f)(sha_mb_row *st, sha_mb_row *msg, e_u32 lanes);
+
+/* Round functions on lane vectors, in terms of the V_ primitives defined by each backend */
+#define V_ROTR(x,n)  V_OR(V_SHR(x,n),V_SHL(x,32-(n)))
+#define V_SUM0(x)    V_XOR(V_XOR(V_ROTR(x, 2),V_ROTR(x,13)),V_ROTR(x,22))
+#define V_SUM1(x)    V_XOR(V_XOR(V_ROTR(x, 6),V_ROTR(x,11)),V_ROTR(x,25))
+#define V_SIG0(x)    V_XOR(V_XOR(V_ROTR(x, 7),V_ROTR(x,18)),V_SHR(x, 3))
+#define V_SIG1(x)    V_XOR(V_XOR(V_ROTR(x,17),V_ROTR(x,19)),V_SHR(x,10))
+#define V_CH(x,y,z)  V_XOR(z,V_AND(x,V_XOR(y,z)))
+#define V_MAJ(x,y,z) V_OR(V_AND(x,y),V_AND(z,V_OR(x,y)))
+
+/* One block for lanes [off,off+width) of st/msg.
+	The message schedule is kept in msg, so vector types do not need to be indexable. */
+#define SHA_MB_COMPRESS_BODY(vec_t) { \
+	vec_t a,b,c,d,e,f,g,h,t1,t2,wi; \
+	int i; \
+	a=V_LOAD(st[0]); b=V_LOAD(st[1]); c=V_LOAD(st[2]); d=V_LOAD(st[3]); \
+	e=V_LOAD(st[4]); f=V_LOAD(st[5]); g=V_LOAD(st[6]); h=V_LOAD(st[7]); \
+	for (i=0; i<64; i++) { \
+		if (i<16) { \
+			wi=V_LOAD(msg[i]); \
+		} else { \
+			wi=V_ADD(V_ADD(V_SIG1(V_LOAD(msg[(i-2)&15])),V_LOAD(msg[(i-7)&15])), \
+					 V_ADD(V_SIG0(V_LOAD(msg[(i-15)&15])),V_LOAD(msg[i&15]))); \
+			V_STORE(msg[i&15],wi); \
+		} \
+		t1=V_ADD(V_ADD(h,V_SUM1(e)),V_ADD(V_ADD(V_CH(e,f,g),V_SET1(sha_mb_k[i])),wi)); \
+		t2=V_ADD(V_SUM0(a),V_MAJ(a,b,c)); \
+		h=g; g=f; f=e; e=V_ADD(d,t1); \
+		d=c; c=b; b=a; a=V_ADD(t1,t2); \
+	} \
+	V_STORE(st[0],V_ADD(V_LOAD(st[0]),a)); V_STORE(st[1],V_ADD(V_LOAD(st[1]),b)); \
+	V_STORE(st[2],V_ADD(V_LOAD(st[2]),c)); V_STORE(st[3],V_ADD(V_LOAD(st[3]),d)); \
+	V_STORE(st[4],V_ADD(V_LOAD(st[4]),e)); V_STORE(st[5],V_ADD(V_LOAD(st[5]),f)); \
+	V_STORE(st[6],V_ADD(V_LOAD(st[6]),g)); V_STORE(st[7],V_ADD(V_LOAD(st[7]),h)); \
+}
+
+/* generic backend, one lane at a time */
+#define V_LOAD(p)     ((p)[off])
+#define V_STORE(p,x)  ((p)[off]=(x))
+#define V_ADD(x,y)    ((x)+(y))
+#define V_XOR(x,y)    ((x)^(y))
+#define V_AND(x,y)    ((x)&(y))
+#define V_OR(x,y)     ((x)|(y))
+#define V_SHR(x,n)    ((x)>>(n))
+#define V_SHL(x,n)    ((x)<<(n))
+#define V_SET1(k)     (k)
+static void sha256_mb_generic(sha_mb_row *st, sha_mb_row *msg, e_u32 lanes) {
+	e_u32 off;
+	for (off=0; off<lanes; off++)
+		SHA_MB_COMPRESS_BODY(e_u32)
+}
+#undef V_LOAD
+#undef V_STORE
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_SHR
+#undef V_SHL
+#undef V_SET1
+
+#if SHA_MB_X86
+/* sse2 backend, 4 lanes per vector */
+#define V_LOAD(p)     _mm_load_si128((const __m128i *)((p)+off))
+#define V_STORE(p,x)  _mm_store_si128((__m128i *)((p)+off),x)
+#define V_ADD(x,y)    _mm_add_epi32(x,y)
+#define V_XOR(x,y)    _mm_xor_si128(x,y)
+#define V_AND(x,y)    _mm_and_si128(x,y)
+#define V_OR(x,y)     _mm_or_si128(x,y)
+#define V_SHR(x,n)    _mm_srli_epi32(x,n)
+#define V_SHL(x,n)    _mm_slli_epi32(x,n)
+#define V_SET1(k)     _mm_set1_epi32((int)(k))
+__attribute__((target("sse2")))
+static void sha256_mb_sse2(sha_mb_row *st, sha_mb_row *msg, e_u32 lanes) {
+	e_u32 off;
+	for (off=0; off<lanes; off+=4)
+		SHA_MB_COMPRESS_BODY(__m128i)
+}
+#undef V_LOAD
+#undef V_STORE
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_SHR
+#undef V_SHL
+#undef V_SET1
+
+/* avx2 backend, 8 lanes per vector */
+#define V_LOAD(p)     _mm256_load_si256((const __m256i *)((p)+off))
+#define V_STORE(p,x)  _mm256_store_si256((__m256i *)((p)+off),x)
+#define V_ADD(x,y)    _mm256_add_epi32(x,y)
+#define V_XOR(x,y)    _mm256_xor_si256(x,y)
+#define V_AND(x,y)    _mm256_and_si256(x,y)
+#define V_OR(x,y)     _mm256_or_si256(x,y)
+#define V_SHR(x,n)    _mm256_srli_epi32(x,n)
+#define V_SHL(x,n)    _mm256_slli_epi32(x,n)
+#define V_SET1(k)     _mm256_set1_epi32((int)(k))
+__attribute__((target("avx2")))
+static void sha256_mb_avx2(sha_mb_row *st, sha_mb_row *msg, e_u32 lanes) {
+	e_u32 off;
+	for (off=0; off<lanes; off+=8)
+		SHA_MB_COMPRESS_BODY(__m256i)
+}
+#undef V_LOAD
+#undef V_STORE
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_SHR
+#undef V_SHL
+#undef V_SET1
+
+/* avx512 backend, 16 lanes per vector, with native rotates and ternary logic */
+#undef V_ROTR
+#undef V_CH
+#undef V_MAJ
+#define V_ROTR(x,n)   _mm512_ror_epi32(x,n)
+#define V_CH(x,y,z)   _mm512_ternarylogic_epi32(x,y,z,0xca)
+#define V_MAJ(x,y,z)  _mm512_ternarylogic_epi32(x,y,z,0xe8)
+#define V_LOAD(p)     _mm512_load_si512((const void *)((p)+off))
+#define V_STORE(p,x)  _mm512_store_si512((void *)((p)+off),x)
+#define V_ADD(x,y)    _mm512_add_epi32(x,y)
+#define V_XOR(x,y)    _mm512_xor_si512(x,y)
+#define V_SHR(x,n)    _mm512_srli_epi32(x,n)
+#define V_SET1(k)     _mm512_set1_epi32((int)(k))
+__attribute__((target("avx512f")))
+static void sha256_mb_avx512(sha_mb_row *st, sha_mb_row *msg, e_u32 lanes) {
+	e_u32 off;
+	for (off=0; off<lanes; off+=16)
+		SHA_MB_COMPRESS_BODY(__m512i)
+}
+#undef V_LOAD
+#undef V_STORE
+#undef V_ADD
+#undef V_XOR
+#undef V_SHR
+#undef V_SET1
+#undef V_ROTR
+#undef V_CH
+#undef V_MAJ
+#define V_ROTR(x,n)  V_OR(V_SHR(x,n),V_SHL(x,32-(n)))
+#define V_CH(x,y,z)  V_XOR(z,V_AND(x,V_XOR(y,z)))
+#define V_MAJ(x,y,z) V_OR(V_AND(x,y),V_AND(z,V_OR(x,y)))
+#endif /* SHA_MB_X86 */
+
+#if SHA_MB_RVV
+/* rvv backend, all lanes in one vector group */
+#define V_LOAD(p)     __riscv_vle32_v_u32m4((p)+off,vl)
+#define V_STORE(p,x)  __riscv_vse32_v_u32m4((p)+off,x,vl)
+#define V_ADD(x,y)    __riscv_vadd_vv_u32m4(x,y,vl)
+#define V_XOR(x,y)    __riscv_vxor_vv_u32m4(x,y,vl)
+#define V_AND(x,y)    __riscv_vand_vv_u32m4(x,y,vl)
+#define V_OR(x,y)     __riscv_vor_vv_u32m4(x,y,vl)
+#define V_SHR(x,n)    __riscv_vsrl_vx_u32m4(x,n,vl)
+#define V_SHL(x,n)    __riscv_vsll_vx_u32m4(x,n,vl)
+#define V_SET1(k)     __riscv_vmv_v_x_u32m4(k,vl)
+static void sha256_mb_rvv(sha_mb_row *st, sha_mb_row *msg, e_u32 lanes) {
+	e_u32 off;
+	size_t vl;
+	for (off=0; off<lanes; off+=vl) {
+		vl=__riscv_vsetvl_e32m4(lanes-off);
+		SHA_MB_COMPRESS_BODY(vuint32m4_t)
+	}
+}
+#undef V_LOAD
+#undef V_STORE
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_OR
+#undef V_SHR
+#undef V_SHL
+#undef V_SET1
+#endif /* SHA_MB_RVV */
+
+/* Function: sha2_mb_engine
+	Select the compression backend for the requested number of lanes.
+	Lanes must be a power of 2 up to SHA_MB_MAX_LANES.
+
+	Parameters:
+	lanes - number of messages hashed in parallel
+	simd - 0 to force the portable backend
+	name - if not NULL, set to the name of the selected backend
+*/
+static sha_mb_compress_f sha2_mb_engine(e_u32 lanes, e_u32 simd, const char **name) {
+	const char *n="generic";
+	sha_mb_compress_f f=sha256_mb_generic;
+	if (simd) {
+#if SHA_MB_X86
+		__builtin_cpu_init();
+		if (lanes>=16 && __builtin_cpu_supports("avx512f")) {
+			n="avx512"; f=sha256_mb_avx512;
+		} else if (lanes>=8 && __builtin_cpu_supports("avx2")) {
+			n="avx2"; f=sha256_mb_avx2;
+		} else if (lanes>=4) {
+			n="sse2"; f=sha256_mb_sse2;
+		}
+#elif SHA_MB_RVV
+		n="rvv"; f=sha256_mb_rvv;
+#endif
+	}
+	if (name)
+		*name=n;
+	return f;
+}
+
+/* Function: sha2_mb_default_lanes
+	Number of lanes of the widest backend available on this processor.
+*/
+e_u32 sha2_mb_default_lanes(void) {
+#if SHA_MB_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return 16;
+	if (__builtin_cpu_supports("avx2"))
+		return 8;
+	return 4;
+#elif SHA_MB_RVV
+	return SHA_MB_MAX_LANES;
+#else
+	return 4;
+#endif
+}
+
+/* Function: sha2_mb_engine_name
+	Name of the backend used for the given number of lanes.
+*/
+const char *sha2_mb_engine_name(e_u32 lanes, e_u32 simd) {
+	const char *name;
+	sha2_mb_engine(lanes,simd,&name);
+	return name;
+}
+
+/* per lane message being hashed */
+typedef struct sha_mb_lane_s {
+	const e_u8 *data;	/* start of message, for full blocks */
+	e_u32 full;			/* number of full blocks in the message */
+	e_u32 total;		/* number of blocks including padding */
+	e_u32 next;			/* next block to hash */
+	e_u8 *digest;		/* output, NULL if the lane is idle */
+	e_u8 tail[2*SHA2_BLOCK_SIZE];	/* last partial block with padding and length */
+} sha_mb_lane;
+
+static void sha_mb_store_be(e_u32 v, e_u8 *p) {
+	p[0]=(e_u8)(v>>24); p[1]=(e_u8)(v>>16); p[2]=(e_u8)(v>>8); p[3]=(e_u8)v;
+}
+
+/* start hashing a message on lane l */
+static void sha_mb_lane_start(sha_mb_lane *lane, sha_mb_row *st, e_u32 l, const e_u8 *data, e_u32 length, e_u8 *digest) {
+	e_u32 rem=length%SHA2_BLOCK_SIZE;
+	e_u32 tail_blocks=(rem+9>SHA2_BLOCK_SIZE) ? 2 : 1;
+	e_u32 i;
+	lane->data=data;
+	lane->full=length/SHA2_BLOCK_SIZE;
+	lane->total=lane->full+tail_blocks;
+	lane->next=0;
+	lane->digest=digest;
+	th_memset(lane->tail,0,sizeof(lane->tail));
+	th_memcpy(lane->tail,data+lane->full*SHA2_BLOCK_SIZE,rem);
+	lane->tail[rem]=0x80;
+	/* message length in bits, big endian 64b */
+	sha_mb_store_be(length>>29,&lane->tail[tail_blocks*SHA2_BLOCK_SIZE-8]);
+	sha_mb_store_be(length<<3,&lane->tail[tail_blocks*SHA2_BLOCK_SIZE-4]);
+	for (i=0; i<8; i++)
+		st[i][l]=sha_mb_iv[i];
+}
+
+/* Function: sha2_mb
+	Hash num independent messages, lanes of them at a time.
+
+	Parameters:
+	data - array of num messages
+	length - length of each message in bytes
+	digest - array of num output buffers of 32 bytes
+	num - number of messages
+	lanes - number of messages hashed in parallel (4, 8 or 16)
+	simd - 0 to force the portable backend
+*/
+void sha2_mb(e_u8 **data, e_u32 *length, e_u8 **digest, e_u32 num, e_u32 lanes, e_u32 simd) {
+	static const e_u8 idle_block[SHA2_BLOCK_SIZE]={0};
+	sha_mb_compress_f compress=sha2_mb_engine(lanes,simd,NULL);
+	sha_mb_lane lane[SHA_MB_MAX_LANES];
+	sha_mb_row *st,*msg;
+	e_u32 l,i,next_msg=0,active=0;
+
+	st=(sha_mb_row *)th_aligned_malloc(sizeof(sha_mb_row)*(8+16),64);
+	if (st==NULL)
+		th_exit(THE_OUT_OF_MEMORY,"Cannot Allocate Memory %s:%d", __FILE__,__LINE__);
+	msg=st+8;
+	th_memset(st,0,sizeof(sha_mb_row)*(8+16));
+	for (l=0; l<lanes; l++) {
+		lane[l].digest=NULL;
+		if (next_msg<num) {
+			sha_mb_lane_start(&lane[l],st,l,data[next_msg],length[next_msg],digest[next_msg]);
+			next_msg++;
+			active++;
+		}
+	}
+	while (active>0) {
+		/* transpose the next block of each lane into msg */
+		for (l=0; l<lanes; l++) {
+			const e_u8 *blk=idle_block;
+			if (lane[l].digest) {
+				if (lane[l].next<lane[l].full)
+					blk=lane[l].data+lane[l].next*SHA2_BLOCK_SIZE;
+				else
+					blk=lane[l].tail+(lane[l].next-lane[l].full)*SHA2_BLOCK_SIZE;
+			}
+			for (i=0; i<16; i++, blk+=4)
+				msg[i][l]=((e_u32)blk[0]<<24)|((e_u32)blk[1]<<16)|((e_u32)blk[2]<<8)|(e_u32)blk[3];
+		}
+		compress(st,msg,lanes);
+		/* retire finished messages, and start pending ones in the free lanes */
+		for (l=0; l<lanes; l++) {
+			if (lane[l].digest==NULL || ++lane[l].next<lane[l].total)
+				continue;
+			for (i=0; i<8; i++)
+				sha_mb_store_be(st[i][l],&lane[l].digest[i*4]);
+			lane[l].digest=NULL;
+			active--;
+			if (next_msg<num) {
+				sha_mb_lane_start(&lane[l],st,l,data[next_msg],length[next_msg],digest[next_msg]);
+				next_msg++;
+				active++;
+			}
+		}
+	}
+	th_aligned_free(st);
+}
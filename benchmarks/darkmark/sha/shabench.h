@@ -27,4 +27,24 @@ typedef struct sha_params_s {
 #define NUM_DATAS 3
 extern sha_params presets_sha[NUM_DATAS];
 
+/* multi buffer variant, hashes num_bufs prefixes of different length of a preset message */
+#define SHA_MB_MAX_LANES 16
+typedef struct shamb_params_s {
+	e_u32 size;
+	e_u32 num_bufs;
+	e_u32 lanes;
+	e_u32 simd;
+	e_u8 **data;
+	e_u32 *length;
+	e_u8 **digest;
+	e_u8 expected_digest[32];
+	e_u8 *ref_digest;	/* expected digest of each buffer, 32 bytes each */
+	e_u32 seed;
+	e_s32 gen_ref;
+} shamb_params;
+
+void sha2_mb(e_u8 **data, e_u32 *length, e_u8 **digest, e_u32 num, e_u32 lanes, e_u32 simd);
+const char *sha2_mb_engine_name(e_u32 lanes, e_u32 simd);
+e_u32 sha2_mb_default_lanes(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,229 @@
+/*
+(C) 2014 EEMBC(R).  All rights reserved.
+
+All EEMBC Benchmark Software are products of EEMBC
+and are provided under the terms of the EEMBC Benchmark License Agreements.
+The EEMBC Benchmark Software are proprietary intellectual properties of EEMBC and its Members
+and is protected under all applicable laws, including all applicable copyright laws.
+If you received this EEMBC Benchmark Software without having
+a currently effective EEMBC Benchmark License Agreement, you must discontinue use.
+Please refer to LICENSE.md for the specific license agreement that pertains to this Benchmark Software.
+*/
+
+/*************************
+** Multi buffer SHA-256.
+** Hash num_bufs independent buffers, lanes of them in parallel.
+** Buffer 0 holds a sha preset message, the others shorter prefixes of it,
+** so lanes finish at different blocks and are refilled while others are still hashing.
+** Buffer 0 is checked against the expected digest of the preset,
+** the others against the digest of the portable single buffer sha2.
+**
+*************************/
+#include "th_cfg.h"
+#include "th_lib.h"
+#include "th_rand.h" /* initialize a random data vector */
+#include "shabench.h"
+
+/* ======================================================================== */
+/*         Function Prototypes                            */
+/* ======================================================================== */
+/* file provides :
+define - select a sha preset, allocate num_bufs prefixes of the message and their reference digests.
+init -  allocate the digests for this context.
+run - hash all the messages.
+fini - dealloc the digests.
+verify - all digests must match their reference digest.
+clean - deallocate the messages.
+*/
+void *define_params_shamb(unsigned int idx, char *name, char *dataset);
+void *bmark_init_shamb(void *);
+void *t_run_test_shamb(struct TCDef *,void *);
+int bmark_clean_shamb(void *);
+int bmark_verify_shamb(void *in_params);
+void *bmark_fini_shamb(void *in_params);
+void sha2(e_u8* data, e_u32 length, e_u8* digest);
+
+void *define_params_shamb(unsigned int idx, char *name, char *dataset) {
+	shamb_params *params;
+	e_s32 data_index=idx;
+	e_u8 *msg;
+	e_u32 i;
+	char logbuf[128];
+
+	/* parameter setup */
+	params=(shamb_params *)th_malloc(sizeof(shamb_params));
+	if ( params == NULL )
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	th_memset(params,0,sizeof(shamb_params));
+
+	params->gen_ref=0;
+	params->seed=1835102827;
+	params->size=10;
+	params->num_bufs=2*SHA_MB_MAX_LANES;
+	params->lanes=sha2_mb_default_lanes();
+	params->simd=1;
+
+	if (pgo_training_run!=0) {
+		data_index=2;
+	}
+	th_parse_buf_flag(dataset,"-i",&data_index);
+	/* preset datasets */
+	if ((data_index>=0) && (data_index<NUM_DATAS)) {
+		params->size=presets_sha[data_index].size;
+		params->seed=presets_sha[data_index].seed;
+		th_memcpy(params->expected_digest,presets_sha[data_index].expected_digest,32);
+	}
+	/* command line overrides */
+	if (pgo_training_run==0) {
+		th_parse_buf_flag_unsigned(dataset,"-s",&params->seed);
+		th_parse_buf_flag(dataset,"-g",&params->gen_ref);
+		th_parse_buf_flag_unsigned(dataset,"-N",&params->size);
+		th_parse_buf_flag_unsigned(dataset,"-B",&params->num_bufs);
+		th_parse_buf_flag_unsigned(dataset,"-L",&params->lanes);
+		th_parse_buf_flag_unsigned(dataset,"-x",&params->simd);
+	}
+	if (params->lanes!=4 && params->lanes!=8 && params->lanes!=16)
+		th_exit( THE_BAD_SIZE, "Lanes must be 4, 8 or 16 %s:%d", __FILE__,__LINE__ );
+	if (params->num_bufs==0)
+		params->num_bufs=1;
+	th_sprintf(logbuf,"sha-mb: %d buffers, %d lanes, %s engine\n",params->num_bufs,params->lanes,
+		sha2_mb_engine_name(params->lanes,params->simd));
+	th_log(TH_INFO,logbuf);
+
+	/* setup the input data, each buffer is a separate copy of a prefix of the message,
+		from the whole message down to about half of it */
+	params->data=(e_u8 **)th_malloc(sizeof(e_u8 *)*params->num_bufs);
+	params->length=(e_u32 *)th_malloc(sizeof(e_u32)*params->num_bufs);
+	params->ref_digest=(e_u8 *)th_malloc(32*params->num_bufs);
+	if (params->data==NULL || params->length==NULL || params->ref_digest==NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	msg=random_u8_vector(params->size,params->seed);
+	for (i=0; i<params->num_bufs; i++) {
+		params->length[i]=params->size-i*(params->size/(2*params->num_bufs));
+		params->data[i]=(e_u8 *)th_malloc(params->length[i]+1);
+		if (params->data[i]==NULL)
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+		th_memcpy(params->data[i],msg,params->length[i]);
+		if (i==0)
+			th_memcpy(params->ref_digest,params->expected_digest,32);
+		else
+			sha2(params->data[i],params->length[i],params->ref_digest+i*32);
+	}
+	th_free(msg);
+
+	return params;
+}
+
+int bmark_clean_shamb(void *in_params) {
+	shamb_params *params=(shamb_params *)in_params;
+	e_u32 i;
+	if (in_params==NULL)
+		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
+	if (params->data) {
+		for (i=0; i<params->num_bufs; i++)
+			th_free(params->data[i]);
+		th_free(params->data);
+	}
+	if (params->length)
+		th_free(params->length);
+	if (params->ref_digest)
+		th_free(params->ref_digest);
+	th_free(params);
+	return 1;
+}
+
+void *bmark_init_shamb(void *in_params) {
+	shamb_params *params=(shamb_params *)in_params;
+	shamb_params *myparams;
+	e_u8 *digests;
+	e_u32 i;
+	if (in_params==NULL)
+		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
+	myparams=(shamb_params *)th_malloc(sizeof(shamb_params));
+	if ( myparams == NULL )
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	th_memcpy(myparams,params,sizeof(shamb_params));
+	/* messages are shared, digests are private to the context */
+	myparams->digest=(e_u8 **)th_malloc(sizeof(e_u8 *)*params->num_bufs);
+	digests=(e_u8 *)th_calloc(params->num_bufs,32);
+	if (myparams->digest==NULL || digests==NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	for (i=0; i<params->num_bufs; i++)
+		myparams->digest[i]=digests+i*32;
+
+	return myparams;
+}
+
+void *bmark_fini_shamb(void *in_params) {
+	shamb_params *params;
+	if (in_params==NULL)
+		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
+	params=(shamb_params *)in_params;
+
+	th_free(params->digest[0]);
+	th_free(params->digest);
+	th_free(params);
+
+	return NULL;
+}
+
+void *t_run_test_shamb(struct TCDef *tcdef,void *in_params) {
+	shamb_params *p=(shamb_params *)in_params;
+	e_u32 i,j;
+
+	tcdef->expected_CRC=0;
+	sha2_mb(p->data, p->length, p->digest, p->num_bufs, p->lanes, p->simd);
+	for (j=0; j<p->num_bufs; j++)
+		for (i=0; i<32; i++)
+			if (p->digest[j][i]!=p->ref_digest[j*32+i])
+				tcdef->CRC++;
+
+	if (p->gen_ref)
+		tcdef->CRC=0;
+
+	return tcdef;
+}
+
+int bmark_verify_shamb(void *in_params) {
+	int i;
+	e_u32 j;
+	char digest_string[5*32];
+	char buf[5];
+	shamb_params *p=(shamb_params *)in_params;
+	int err=0;
+
+	if (p->gen_ref) {
+		*digest_string=0;
+		for (i=0; i<32; i++) {
+			th_sprintf(buf,"0x%02x",p->digest[0][i]);
+			if (i>0)
+				th_strcat(digest_string,",");
+			th_strcat(digest_string,buf);
+		}
+		th_printf("\t{%d,NULL,\n\t\t{0,},\n\t\t{%s},\n\t%d,0},\n",
+						p->size,	digest_string,p->seed);
+		return 1;
+	}
+	for (j=0; j<p->num_bufs; j++) {
+		for (i=0; i<32; i++)
+			if (p->digest[j][i]!=p->ref_digest[j*32+i])
+				break;
+		if (i==32)
+			continue;
+		err++;
+		th_printf("SHA256 ERROR in validation of buffer %d (%d bytes)!\n",j,p->length[j]);
+		*digest_string=0;
+		for (i=0; i<32; i++) {
+			th_sprintf(buf,"0x%02x",p->digest[j][i]);
+			th_strcat(digest_string,buf);
+		}
+		th_printf("digest,%s\n",digest_string);
+		*digest_string=0;
+		for (i=0; i<32; i++) {
+			th_sprintf(buf,"0x%02x",p->ref_digest[j*32+i]);
+			th_strcat(digest_string,buf);
+		}
+		th_printf("expect,%s\n",digest_string);
+	}
+	return (err==0) ? 1 : 0;
+}
@@ -19,6 +19,7 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include "th_lib.h"
 #include "th_rand.h" /* initialize a random data vector */
 #include "th_types.h"
+#include "mith_workload.h"
 
 #include "zlib.h"
 
@@ -37,8 +38,30 @@ typedef struct zip_params_s {
 	int err;
 	e_u32 buf_type;
 	e_u16 expected_crc;
+	mith_input_t *input; /* input of the operation, shared by all contexts */
+	e_u32 threads; /* if non zero, deflate blocks of the input concurrently with this many threads */
+	e_u32 block_size; /* size of each input block for parallel deflate */
+	e_u32 window; /* if non zero, stream generated records through buffers of this size */
+	struct zip_stream_stats_s *stats; /* stream results, shared by all contexts */
+	size_t stream_ticks; /* time of the last stream run */
+	size_t stream_peak; /* peak working set of the last stream run */
+	e_u32 stream_bytes; /* uncompressed bytes of the last stream run */
 } zip_params;
 
+/* accumulated results of stream runs for all contexts */
+typedef struct zip_stream_stats_s {
+	char name[MITH_MAX_NAME];
+	size_t bytes;
+	size_t ticks;
+	size_t peak;
+	e_u32 runs;
+	al_mutex_t lock;
+} zip_stream_stats;
+
+#define ZIP_DEFAULT_BLOCK (128*1024)
+#define ZIP_DICT_SIZE (32*1024)
+#define ZIP_STREAM_MIN_WINDOW (1024)
+
 /* file provides :
 define - init base input params (segment [within 0..2 boundary], number of coefficients to calculate, number of integration steps)
 init -  allocate working memory, assign a[0] and b[0] . 
@@ -57,6 +80,8 @@ void *bmark_fini_zip(void *in_params);
 /* benchmark function declarations */
 e_u16 do_unz(zip_params *p);
 e_u16 do_zip(zip_params *p);
+e_u16 do_zip_parallel(zip_params *p);
+e_u16 do_zip_stream(zip_params *p);
 
 #define MULTI_LINE_STRING(a) #a
 
@@ -86,6 +111,25 @@ static char *cname[] = { "EEMBC" , "SAGESOFT", "INTEL" , "Lockheed Martin", "ST"
 static char *pname[] = { "Shay"  ,  "Markus" , "Pierre", "Vader"          , "Skeet", "Boron" 	};
 static e_u32 requested_size=0; 
 
+/* generate one record of the given type into lbuf, return its length */
+static e_u32 gen_record(char *lbuf, void *r, e_u32 record_type) {
+	char *company=	cname[random_u32(r) % (sizeof(cname)/sizeof(char *))];
+	char *name=		pname[random_u32(r) % (sizeof(pname)/sizeof(char *))];
+	e_u32 id=random_u32_inrange(r,1,0xfff);
+	switch (record_type) {
+		case 1:
+			th_sprintf(lbuf,"%s,%s,%d\n",company,name,id);
+			break;
+		case 2:
+			th_sprintf(lbuf,"%d\n",id);
+			break;
+		default:
+			th_sprintf(lbuf,"<p company='%s'><b>%s</b><data>%d</data></p>\n",company,name,id);
+			break;
+	}
+	return th_strlen(lbuf);
+}
+
 static char *gen_parse_buf(e_u32 *psize, void *r, e_u32 record_type) {
 	char lbuf[100];
 	e_u32 size=*psize;
@@ -102,22 +146,8 @@ static char *gen_parse_buf(e_u32 *psize, void *r, e_u32 record_type) {
 	while (size > (end_size+max_entry)) 
 	{
 		/* add records until reaching required size */
-		char *company=	cname[random_u32(r) % (sizeof(cname)/sizeof(char *))];
-		char *name=		pname[random_u32(r) % (sizeof(pname)/sizeof(char *))];
-		e_u32 id=random_u32_inrange(r,1,0xfff);
-		switch (record_type) {
-			case 1:
-				th_sprintf(lbuf,"%s,%s,%d\n",company,name,id);
-				break;
-			case 2:
-				th_sprintf(lbuf,"%d\n",id);
-				break;
-			default:
-				th_sprintf(lbuf,"<p company='%s'><b>%s</b><data>%d</data></p>\n",company,name,id);
-				break;
-		}
+		size-=gen_record(lbuf,r,record_type);
 		th_strcat(buf,lbuf);
-		size-=th_strlen(lbuf);
 	}
 	/* setup xml/html footer */
 	th_strcat(buf,default_end);
@@ -154,8 +184,25 @@ void *define_params_zip(unsigned int idx, char *name, char *dataset) {
 		th_parse_buf_flag(dataset,"-s",&params->seed);
 		th_parse_buf_flag(dataset,"-g",&params->gen_ref);
 		th_get_buf_flag(dataset,"-f=",&params->filename);
+		th_parse_buf_flag_unsigned(dataset,"-p=",&params->threads);
+		th_parse_buf_flag_unsigned(dataset,"-B=",&params->block_size);
+		th_parse_buf_flag_unsigned(dataset,"-W=",&params->window);
 	}
-	if (params->filename) { /* file name defined, read into buf) */
+	if (params->block_size==0)
+		params->block_size=ZIP_DEFAULT_BLOCK;
+	if (params->window) { /* stream mode, records are generated during the run */
+		if (params->window<ZIP_STREAM_MIN_WINDOW)
+			params->window=ZIP_STREAM_MIN_WINDOW;
+		if (size!=0)
+			params->unz_buf_len=size;
+		requested_size=params->unz_buf_len;
+		params->stats=(zip_stream_stats *)th_malloc(sizeof(zip_stream_stats));
+		if (params->stats==NULL)
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+		th_memset(params->stats,0,sizeof(zip_stream_stats));
+		th_strncpy(params->stats->name,name,MITH_MAX_NAME-1);
+		al_mutex_init(&params->stats->lock);
+	} else if (params->filename) { /* file name defined, read into buf) */
 		ee_FILE *f=th_fopen(params->filename,"rb");
 		size_t fs=th_fsize(params->filename);
 		if (params->unzip) {
@@ -189,6 +236,16 @@ void *define_params_zip(unsigned int idx, char *name, char *dataset) {
 			}
 		}
 	}
+	/* the input is only read by the operation, so all contexts can use the same copy */
+	if (params->unzip && params->zip_buf) {
+		params->input=mith_input_share(params->zip_buf,params->zip_buf_len);
+		th_free(params->zip_buf);
+		params->zip_buf=(e_u8 *)params->input->data;
+	} else if (!params->unzip && params->unz_buf) {
+		params->input=mith_input_share(params->unz_buf,params->unz_buf_len);
+		th_free(params->unz_buf);
+		params->unz_buf=(e_u8 *)params->input->data;
+	}
 	
 	return params;
 }
@@ -202,6 +259,8 @@ void *define_params_zip(unsigned int idx, char *name, char *dataset) {
 e_u16 do_zip(zip_params *p)
 {
     int err;
+	if (p->threads && !p->unzip)
+		return do_zip_parallel(p);
     uLong ulen = p->unz_buf_len;
     uLong zlen = compressBound(ulen);
 	if (p->zip_buf)
@@ -217,6 +276,344 @@ e_u16 do_zip(zip_params *p)
 	/* TODO: subsample output to determine if ok */
 	return zlen;
 }
+/* Parallel deflate.
+	The input is split into blocks that are deflated independently as raw deflate streams,
+	each one primed with the last 32KB of input preceding the block as a dictionary.
+	All blocks but the last end with a sync flush, so they are byte aligned and
+	can be concatenated into a single zlib stream with a header and the combined adler32.
+*/
+typedef struct zip_job_s {
+	e_u8 *in;
+	e_u32 in_len;
+	e_u32 block_size;
+	e_u32 num_blocks;
+	e_u32 next; /* next block to deflate */
+	e_u8 *out;
+	e_u32 *out_off; /* start of the output slot of each block */
+	e_u32 *out_len; /* deflated size of each block */
+	uLong *adler; /* adler32 of each block input */
+	int err;
+	al_mutex_t lock;
+} zip_job;
+
+/* upper bound of the deflated size of a block, including the sync flush marker */
+#define ZIP_BLOCK_BOUND(len) (compressBound(len)+16)
+
+static void *zip_block_worker(void *arg) {
+	zip_job *job=(zip_job *)arg;
+	z_stream strm;
+	e_u32 b, start, len, dict, last;
+	int err;
+
+	for (;;) {
+		al_mutex_lock(&job->lock);
+		b=job->next++;
+		al_mutex_unlock(&job->lock);
+		if (b>=job->num_blocks)
+			break;
+		job->out_len[b]=0;
+		start=b*job->block_size;
+		len=job->in_len-start;
+		if (len>job->block_size)
+			len=job->block_size;
+		last=(b==job->num_blocks-1);
+		th_memset(&strm,0,sizeof(strm));
+		err=deflateInit2(&strm,Z_DEFAULT_COMPRESSION,Z_DEFLATED,-MAX_WBITS,8,Z_DEFAULT_STRATEGY);
+		if (err==Z_OK && b>0) {
+			dict=start>ZIP_DICT_SIZE ? ZIP_DICT_SIZE : start;
+			err=deflateSetDictionary(&strm,job->in+start-dict,dict);
+		}
+		if (err==Z_OK) {
+			strm.next_in=job->in+start;
+			strm.avail_in=len;
+			strm.next_out=job->out+job->out_off[b];
+			strm.avail_out=ZIP_BLOCK_BOUND(len);
+			err=deflate(&strm,last ? Z_FINISH : Z_SYNC_FLUSH);
+			if ((last && err==Z_STREAM_END) || (!last && err==Z_OK && strm.avail_in==0))
+				err=Z_OK;
+			else if (err==Z_OK)
+				err=Z_BUF_ERROR;
+			job->out_len[b]=ZIP_BLOCK_BOUND(len)-strm.avail_out;
+			deflateEnd(&strm);
+		}
+		job->adler[b]=adler32(adler32(0L,Z_NULL,0),job->in+start,len);
+		if (err!=Z_OK) {
+			al_mutex_lock(&job->lock);
+			th_printf("deflate block %d error: %d\n",b,err);
+			job->err++;
+			al_mutex_unlock(&job->lock);
+		}
+	}
+	return NULL;
+}
+
+e_u16 do_zip_parallel(zip_params *p)
+{
+	zip_job job;
+	al_thread_t *workers;
+	mith_textend tex;
+	e_u32 b, pos, len, nthreads;
+	uLong zlen, adler;
+	void *retval;
+
+	th_memset(&job,0,sizeof(job));
+	job.in=p->unz_buf;
+	job.in_len=p->unz_buf_len;
+	job.block_size=p->block_size;
+	job.num_blocks=(job.in_len+job.block_size-1)/job.block_size;
+	if (job.num_blocks==0)
+		job.num_blocks=1;
+	nthreads=p->threads>job.num_blocks ? job.num_blocks : p->threads;
+	job.out_off=(e_u32 *)th_malloc(sizeof(e_u32)*job.num_blocks*2);
+	job.adler=(uLong *)th_malloc(sizeof(uLong)*job.num_blocks);
+	workers=(al_thread_t *)th_malloc(sizeof(al_thread_t)*nthreads);
+	if (job.out_off==NULL || job.adler==NULL || workers==NULL) {
+		th_printf("Could not allocate memory!\n");
+		p->err++;
+		if (workers)
+			th_free(workers);
+		if (job.adler)
+			th_free(job.adler);
+		if (job.out_off)
+			th_free(job.out_off);
+		return 0;
+	}
+	job.out_len=job.out_off+job.num_blocks;
+	/* each block gets its own output slot after the 2 byte zlib header */
+	zlen=2;
+	for (b=0; b<job.num_blocks; b++) {
+		len=job.in_len-b*job.block_size;
+		if (len>job.block_size)
+			len=job.block_size;
+		job.out_off[b]=zlen;
+		zlen+=ZIP_BLOCK_BOUND(len);
+	}
+	zlen+=4;
+	if (p->zip_buf)
+		th_free(p->zip_buf);
+	p->zip_buf=(e_u8 *)th_malloc(zlen);
+	if (p->zip_buf==NULL) {
+		th_printf("Could not allocate memory!\n");
+		p->err++;
+		th_free(workers);
+		th_free(job.adler);
+		th_free(job.out_off);
+		return 0;
+	}
+	job.out=p->zip_buf;
+	al_mutex_init(&job.lock);
+	for (b=0; b<nthreads; b++) {
+		al_item_textend(&tex,b);
+		al_thread_create_ex(&workers[b],zip_block_worker,&job,&tex);
+	}
+	for (b=0; b<nthreads; b++)
+		al_thread_join(workers[b],&retval);
+	al_mutex_destroy(&job.lock);
+	p->err+=job.err;
+	if (job.err>0) {
+		/* a failed block leaves no usable output to stitch */
+		p->zip_buf_len=0;
+		th_free(workers);
+		th_free(job.adler);
+		th_free(job.out_off);
+		return 0;
+	}
+
+	/* stitch the blocks into a single zlib stream */
+	p->zip_buf[0]=0x78;
+	p->zip_buf[1]=0x9c;
+	pos=2;
+	adler=adler32(0L,Z_NULL,0);
+	for (b=0; b<job.num_blocks; b++) {
+		len=job.in_len-b*job.block_size;
+		if (len>job.block_size)
+			len=job.block_size;
+		th_memmove(p->zip_buf+pos,p->zip_buf+job.out_off[b],job.out_len[b]);
+		pos+=job.out_len[b];
+		adler=adler32_combine(adler,job.adler[b],len);
+	}
+	p->zip_buf[pos++]=(e_u8)(adler>>24);
+	p->zip_buf[pos++]=(e_u8)(adler>>16);
+	p->zip_buf[pos++]=(e_u8)(adler>>8);
+	p->zip_buf[pos++]=(e_u8)adler;
+	p->zip_buf_len=pos;
+
+	th_free(workers);
+	th_free(job.adler);
+	th_free(job.out_off);
+	return pos;
+}
+
+/* Streaming deflate and inflate.
+	Records from the same generator as <gen_parse_buf> are produced during the run into a window,
+	deflated into a second window, and each compressed chunk is inflated right away into a third one.
+	Only the windows and the zlib state are live, so the working set is bounded by the window size
+	instead of the size of the data.
+*/
+/* working set of a stream, all its allocations go through zip_stream_alloc */
+typedef struct zip_stream_mem_s {
+	size_t cur;
+	size_t peak;
+} zip_stream_mem;
+
+static voidpf zip_stream_alloc(voidpf opaque, uInt items, uInt size) {
+	zip_stream_mem *mem=(zip_stream_mem *)opaque;
+	size_t len=(size_t)items*size;
+	size_t *blk=(size_t *)th_malloc(len+sizeof(size_t)*2);
+	if (blk==NULL)
+		return Z_NULL;
+	blk[0]=len;
+	mem->cur+=len;
+	if (mem->cur>mem->peak)
+		mem->peak=mem->cur;
+	return (voidpf)(blk+2);
+}
+
+static void zip_stream_free(voidpf opaque, voidpf address) {
+	zip_stream_mem *mem=(zip_stream_mem *)opaque;
+	size_t *blk=((size_t *)address)-2;
+	mem->cur-=blk[0];
+	th_free(blk);
+}
+
+/* generator state, produces the same data as gen_parse_buf */
+typedef struct zip_stream_gen_s {
+	void *r;
+	e_u32 record_type;
+	e_u32 remaining;
+	int state; /* 0 - header, 1 - records, 2 - footer, 3 - done */
+} zip_stream_gen;
+
+/* fill up to len bytes of buf with whole records, return bytes written */
+static e_u32 zip_stream_fill(zip_stream_gen *g, char *buf, e_u32 len) {
+	e_u32 pos=0, n;
+	e_u32 end_size=th_strlen(default_end);
+	char lbuf[100];
+	while (g->state<3 && len-pos>=max_entry) {
+		switch (g->state) {
+			case 0:
+				n=th_strlen(default_start);
+				th_memcpy(buf+pos,default_start,n);
+				g->remaining-=n;
+				g->state=1;
+				break;
+			case 1:
+				if (g->remaining <= (end_size+max_entry)) {
+					g->state=2;
+					continue;
+				}
+				n=gen_record(lbuf,g->r,g->record_type);
+				th_memcpy(buf+pos,lbuf,n);
+				g->remaining-=n;
+				break;
+			default:
+				n=end_size;
+				th_memcpy(buf+pos,default_end,n);
+				g->state=3;
+				break;
+		}
+		pos+=n;
+	}
+	return pos;
+}
+
+/* inflate a compressed chunk, return 0 on error */
+static int zip_stream_inflate(z_stream *inf, e_u8 *in, e_u32 len, e_u8 *out, e_u32 window,
+		uLong *crc, e_u32 *total) {
+	int err;
+	e_u32 n;
+	inf->next_in=in;
+	inf->avail_in=len;
+	do {
+		inf->next_out=out;
+		inf->avail_out=window;
+		err=inflate(inf,Z_NO_FLUSH);
+		if (err!=Z_OK && err!=Z_STREAM_END && err!=Z_BUF_ERROR)
+			return 0;
+		n=window-inf->avail_out;
+		*crc=crc32(*crc,out,n);
+		*total+=n;
+	} while (inf->avail_out==0);
+	return 1;
+}
+
+e_u16 do_zip_stream(zip_params *p)
+{
+	zip_stream_mem mem;
+	zip_stream_gen gen;
+	z_stream def, inf;
+	e_u8 *in_win, *z_win, *out_win;
+	e_u32 w=p->window, n, have, zlen=0, ulen=0, inflated=0;
+	uLong in_crc, out_crc;
+	int wbits=MAX_WBITS, err, flush;
+
+	/* limit the deflate history to the window if it is smaller than the default */
+	while (wbits>9 && ((e_u32)1<<wbits)>w)
+		wbits--;
+	th_memset(&mem,0,sizeof(mem));
+	in_win=(e_u8 *)zip_stream_alloc(&mem,w,1);
+	z_win=(e_u8 *)zip_stream_alloc(&mem,w,1);
+	out_win=(e_u8 *)zip_stream_alloc(&mem,w,1);
+	if (in_win==NULL || z_win==NULL || out_win==NULL) {
+		th_printf("Could not allocate memory!\n");
+		p->err++;
+		return 0;
+	}
+	th_memset(&def,0,sizeof(def));
+	th_memset(&inf,0,sizeof(inf));
+	def.zalloc=inf.zalloc=zip_stream_alloc;
+	def.zfree=inf.zfree=zip_stream_free;
+	def.opaque=inf.opaque=(voidpf)&mem;
+	err=deflateInit2(&def,Z_DEFAULT_COMPRESSION,Z_DEFLATED,wbits,8,Z_DEFAULT_STRATEGY);
+	CHECK_ERR(err, "deflateInit",p);
+	err=inflateInit2(&inf,wbits);
+	CHECK_ERR(err, "inflateInit",p);
+
+	gen.r=rand_init(p->seed, 0xff, 0, 0);
+	gen.record_type=p->buf_type;
+	gen.remaining=p->unz_buf_len;
+	gen.state=0;
+	in_crc=out_crc=crc32(0L,Z_NULL,0);
+	do {
+		n=zip_stream_fill(&gen,(char *)in_win,w);
+		in_crc=crc32(in_crc,in_win,n);
+		ulen+=n;
+		flush=(gen.state==3) ? Z_FINISH : Z_NO_FLUSH;
+		def.next_in=in_win;
+		def.avail_in=n;
+		do {
+			def.next_out=z_win;
+			def.avail_out=w;
+			err=deflate(&def,flush);
+			if (err==Z_STREAM_ERROR) {
+				CHECK_ERR(err, "deflate",p);
+				break;
+			}
+			have=w-def.avail_out;
+			zlen+=have;
+			if (have && !zip_stream_inflate(&inf,z_win,have,out_win,w,&out_crc,&inflated)) {
+				th_printf("inflate error: %s\n",inf.msg ? inf.msg : "?");
+				p->err++;
+			}
+		} while (def.avail_out==0);
+	} while (flush!=Z_FINISH && p->err==0);
+	rand_fini(gen.r);
+
+	if (inflate(&inf,Z_NO_FLUSH)!=Z_STREAM_END || inflated!=ulen || in_crc!=out_crc) {
+		th_printf("stream error: %d bytes in, %d bytes out\n",ulen,inflated);
+		p->err++;
+	}
+	deflateEnd(&def);
+	inflateEnd(&inf);
+	zip_stream_free(&mem,out_win);
+	zip_stream_free(&mem,z_win);
+	zip_stream_free(&mem,in_win);
+	p->stream_peak=mem.peak;
+	p->stream_bytes=ulen;
+	p->zip_buf_len=zlen;
+	return zlen;
+}
+
 e_u16 do_unz(zip_params *p)
 {
     int err;
@@ -239,6 +636,31 @@ int bmark_clean_zip(void *in_params) {
 	zip_params *params=(zip_params *)in_params;
 	if (in_params==NULL)
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
+	if (params->input!=NULL) {
+		if (params->unzip)
+			params->zip_buf=NULL;
+		else
+			params->unz_buf=NULL;
+		mith_input_release(params->input);
+	}
+	if (params->stats!=NULL) {
+		zip_stream_stats *st=params->stats;
+		if (st->runs>0) {
+			th_printf("-- %s:stream_window(bytes)=%u\n",st->name,params->window);
+			th_printf("-- %s:stream_peak(bytes)=%u\n",st->name,(e_u32)st->peak);
+#if FLOAT_SUPPORT
+			if (st->ticks>0)
+				th_printf("-- %s:stream_bytes/sec=%8g\n",st->name,
+					(double)st->bytes*(double)th_ticks_per_sec()/(double)st->ticks);
+#else
+			if (st->ticks>0)
+				th_printf("-- %s:stream_bytes/sec=%u\n",st->name,
+					(e_u32)(st->bytes/st->ticks*th_ticks_per_sec()));
+#endif
+		}
+		al_mutex_destroy(&st->lock);
+		th_free(st);
+	}
 	if (params->unz_buf!=NULL)
 		th_free(params->unz_buf);
 	if (params->zip_buf!=NULL)
@@ -256,8 +678,16 @@ void *bmark_init_zip(void *in_params) {
 	if ( p == NULL )
           th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	th_memcpy(p,params,sizeof(zip_params));
-	/* Copy the input */
-	if (p->unzip) {
+	/* Use the shared input directly, only the output is allocated by the operation */
+	if (p->window) {
+		p->unz_buf=NULL;
+		p->zip_buf=NULL;
+	} else if (p->input!=NULL) {
+		if (p->unzip)
+			p->unz_buf=NULL;
+		else
+			p->zip_buf=NULL;
+	} else if (p->unzip) {
 		p->zip_buf=(e_u8 *)th_malloc(params->zip_buf_len);
 		th_memcpy(p->zip_buf,params->zip_buf,params->zip_buf_len);
 	} else {
@@ -272,6 +702,22 @@ void *bmark_fini_zip(void *in_params) {
 	if (in_params==NULL)
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
 	params=(zip_params *)in_params;
+	if (params->stats!=NULL && params->stream_bytes>0) {
+		zip_stream_stats *st=params->stats;
+		al_mutex_lock(&st->lock);
+		st->bytes+=params->stream_bytes;
+		st->ticks+=params->stream_ticks;
+		if (params->stream_peak>st->peak)
+			st->peak=params->stream_peak;
+		st->runs++;
+		al_mutex_unlock(&st->lock);
+	}
+	if (params->input!=NULL) { /* the input belongs to the shared copy */
+		if (params->unzip)
+			params->zip_buf=NULL;
+		else
+			params->unz_buf=NULL;
+	}
 	if (params->zip_buf)
 		th_free(params->zip_buf);
 	if (params->unz_buf)
@@ -288,12 +734,21 @@ void *t_run_test_zip(struct TCDef *tcdef,void *in_params) {
 	tcdef->expected_CRC=0;
 	p->err=0;
 	/* perform requested op on buffer */
-	if (p->unzip)
+	if (p->window) {
+		p->stream_ticks=th_signal_now();
+		p->zip_result=do_zip_stream(p);
+		p->stream_ticks=th_signal_now()-p->stream_ticks;
+	} else if (p->unzip)
 		p->zip_result=do_unz(p);
 	else 
 		p->zip_result=do_zip(p);
 	
-	if ((p->zip_result != p->expected_result) || (p->err > 0))
+	/* parallel deflate output depends on the block size, it is checked in verify,
+	   and a stream is checked during the run */
+	if (p->window || (p->threads && !p->unzip)) {
+		if (p->err > 0)
+			tcdef->CRC=1;
+	} else if ((p->zip_result != p->expected_result) || (p->err > 0))
 		tcdef->CRC=1;
 	
 	if (p->gen_ref)
@@ -323,6 +778,30 @@ int bmark_verify_zip(void *in_params) {
 	} else {
 		crc=th_crcbuffer(params->zip_buf,params->zip_buf_len,params->zip_result);
 	}
+	if (params->window) {
+		/* the stream is inflated and compared with the input during the run */
+		if (params->gen_ref)
+			th_printf("stream: %d bytes, %d compressed\n",params->stream_bytes,params->zip_buf_len);
+		return (params->err==0);
+	}
+	if (params->threads && !params->unzip && !params->gen_ref) {
+		/* inflate the parallel deflate output and compare with the input */
+		uLong ulen=params->unz_buf_len;
+		e_u8 *check=(e_u8 *)th_malloc(ulen+1);
+		int res;
+		if (check==NULL) {
+			th_printf("Could not allocate memory!\n");
+			return 0;
+		}
+		res=uncompress(check,&ulen,params->zip_buf,params->zip_buf_len);
+		if (res!=Z_OK || ulen!=params->unz_buf_len || th_memcmp(check,params->unz_buf,ulen)!=0) {
+			th_printf("Error! Parallel deflate output does not match input (%d)\n",res);
+			th_free(check);
+			return 0;
+		}
+		th_free(check);
+		return 1;
+	}
 	if (params->gen_ref) {
 		th_printf("{NULL,%d,NULL,%d,0x%04x,0,%d,0,%s,0,%d,0,%d,0x%04x},\n",
 			params->zip_buf_len,requested_size,params->zip_result,params->seed,
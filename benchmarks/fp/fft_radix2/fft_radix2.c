@@ -23,6 +23,19 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 //PT: 4/4/2016: w/g decision (undoes th_lib.h for radix only)
 #undef  MIN_ACC_BITS_FP64    
 #define MIN_ACC_BITS_FP64 25
+/* Normwise accuracy required from the algorithms that did not produce the reference data.
+	The single precision reference data was computed with the radix 2 recurrence twiddles,
+	and for the 64K set is itself only within 2^-12.5 of the exact transform. */
+#define NORM_ACC_BITS_FP32 12
+
+/* Rows of the matrix transformed together by <FFT_fourstep>, so that the transposes
+	move whole cache lines */
+#ifndef FFT_FOURSTEP_BLOCK
+#define FFT_FOURSTEP_BLOCK 8
+#endif
+#if (FFT_FOURSTEP_BLOCK<1) || (FFT_FOURSTEP_BLOCK & (FFT_FOURSTEP_BLOCK-1))
+#error "FFT_FOURSTEP_BLOCK must be a power of 2"
+#endif
 
 extern void init_preset_0();
 extern void init_preset_1();
@@ -30,6 +43,7 @@ extern void init_preset_2();
 extern void init_preset_3();
 extern void init_preset_4();
 extern void init_preset_5();
+extern void init_preset_6();
 radix2_params presets_radix2[NUM_DATAS];
 
 /* ======================================================================== */
@@ -50,9 +64,61 @@ int bmark_clean_radix2(void *);
 int bmark_verify_radix2(void *in_params);
 void *bmark_fini_radix2(void *in_params);
 
+/* Stockham butterflies.
+	With GCC the radix 4 stages work on vectors of FFT_VBYTES bytes, that is FFT_VLEN/2 complex values
+	from FFT_VLEN/2 consecutive butterflies. Stages with fewer butterflies per twiddle use scalar code.
+*/
+#if defined(__GNUC__) && !defined(__clang__) && (USE_FP32 || USE_FP64)
+#define FFT_GNU_VEC 1
+#if defined(__AVX__)
+#define FFT_VBYTES 32
+#else
+#define FFT_VBYTES 16
+#endif
+#if USE_FP32
+#define FFT_VLEN (FFT_VBYTES/4)
+typedef e_s32 fft_ivec __attribute__((vector_size(FFT_VBYTES)));
+#else
+#define FFT_VLEN (FFT_VBYTES/8)
+typedef e_s64 fft_ivec __attribute__((vector_size(FFT_VBYTES)));
+#endif
+typedef e_fp fft_vec __attribute__((vector_size(FFT_VBYTES),aligned(sizeof(e_fp))));
+#if FFT_VLEN==2
+#define FFT_SWAP_PAIRS {1,0}
+#define FFT_ALT_SIGN {-1,1}
+#elif FFT_VLEN==4
+#define FFT_SWAP_PAIRS {1,0,3,2}
+#define FFT_ALT_SIGN {-1,1,-1,1}
+#else
+#define FFT_SWAP_PAIRS {1,0,3,2,5,4,7,6}
+#define FFT_ALT_SIGN {-1,1,-1,1,-1,1,-1,1}
+#endif
+#else
+#define FFT_GNU_VEC 0
+#endif
+
+/* Batched transforms.
+	Transforms are interleaved in groups of FFT_BATCH_LANES, element i of transform l of a group
+	is at i*FFT_BATCH_LANES+l, so each lane of a vector runs a different transform in lockstep
+	and the butterflies need no shuffles.
+*/
+#if FFT_GNU_VEC
+#define FFT_BATCH_LANES FFT_VLEN
+typedef fft_vec fft_lanes;
+#else
+#define FFT_BATCH_LANES 1
+typedef e_fp fft_lanes;
+#endif
+
 /* benchmark function declarations */
 static void FFT_transform_internal (int N, e_fp * RESTRICT data, int direction, e_fp *twp);
 static void FFT_bitreverse(int N, e_fp * RESTRICT data);
+static void FFT_stockham(int N, e_fp * RESTRICT data, e_fp * RESTRICT work, int direction, e_fp *twp);
+static void FFT_fourstep(int N, e_fp * RESTRICT data, e_fp * RESTRICT work, int direction, e_fp *twp);
+static void FFT_stockham_batch(int N, fft_lanes * RESTRICT data, fft_lanes * RESTRICT work, int direction, e_fp *twp);
+static e_u32 normwise_bits(e_fp *data, intparts *ref, int N);
+static int verify_computed(radix2_params *params, e_u32 minbits);
+static int verify_batch(radix2_params *params, e_u32 minbits);
 static int int_log2 (int n)
 {
     int k = 1;
@@ -100,15 +166,120 @@ static e_fp *calculate_twiddles(int size, int direction) {
 	}
 	return twp;
 }
+/* Twiddles for <FFT_stockham>.
+	For each radix 4 stage of length n, and each butterfly p in 0..n/4-1, W^p, W^2p and W^3p
+	with W=exp(direction*2*pi*i/n), in the order the stages read them.
+	Returns the number of values in the table, w may be NULL to only get the size.
+*/
+static int fill_stockham_twiddles(e_fp *w, int size, int direction) {
+	int n,p,k,cnt=0;
+
+	for (n=size/2; n>=4; n/=4) {
+		cnt+=6*(n/4);
+		if (w==NULL)
+			continue;
+		for (p=0; p<n/4; p++) {
+			for (k=1; k<=3; k++) {
+				e_fp theta = FPCONST(2.0) * direction * EE_PI * (e_fp)(k*p) / (e_fp)n;
+				*w++ = th_cos(theta);
+				*w++ = th_sin(theta);
+			}
+		}
+	}
+	return cnt;
+}
+static e_fp *calculate_stockham_twiddles(int size, int direction) {
+	int cnt=fill_stockham_twiddles(NULL,size,direction);
+	e_fp *twp;
+
+	if (cnt==0)
+		return NULL;
+	twp=(e_fp *)th_malloc(sizeof(e_fp)*cnt);
+	if (twp==NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	fill_stockham_twiddles(twp,size,direction);
+	return twp;
+}
+/* Function: fourstep_shape
+	Split the N/2 points of <FFT_fourstep> into a matrix of rows x cols,
+	with cols=rows or cols=2*rows.
+*/
+static void fourstep_shape(int N, int *rows, int *cols) {
+	int logn=int_log2(N/2);
+	*rows=1<<(logn/2);
+	*cols=(N/2)>>(logn/2);
+}
+/* Twiddles for <FFT_fourstep>.
+	Stockham tables for the column and row transforms, followed by the twiddles applied between
+	the two steps. The full table of W^(r*c), W=exp(direction*2*pi*i/(N/2)), would be as large as the data,
+	so it is split as W^(r*c) = W^((r*c)%cols) * W^(cols*((r*c)/cols)) and only two short tables are kept.
+*/
+static e_fp *calculate_fourstep_twiddles(int size, int direction) {
+	int rows,cols,i,cnt;
+	e_fp *twp,*w;
+
+	fourstep_shape(size,&rows,&cols);
+	cnt=fill_stockham_twiddles(NULL,2*cols,direction)+fill_stockham_twiddles(NULL,2*rows,direction)+2*cols+2*rows;
+	twp=(e_fp *)th_malloc(sizeof(e_fp)*cnt);
+	if (twp==NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	w=twp;
+	w+=fill_stockham_twiddles(w,2*cols,direction);
+	w+=fill_stockham_twiddles(w,2*rows,direction);
+	for (i=0; i<cols; i++) {
+		e_fp theta = FPCONST(2.0) * direction * EE_PI * (e_fp)i / (e_fp)(size/2);
+		*w++ = th_cos(theta);
+		*w++ = th_sin(theta);
+	}
+	for (i=0; i<rows; i++) {
+		e_fp theta = FPCONST(2.0) * direction * EE_PI * (e_fp)i / (e_fp)rows;
+		*w++ = th_cos(theta);
+		*w++ = th_sin(theta);
+	}
+	return twp;
+}
+/* input of a batch, transform t uses seed+t so the first one is the dataset signal */
+static e_fp *batch_input(int N, e_u32 batch, e_u32 seed) {
+	e_u32 t;
+	int i;
+	e_fp *data=(e_fp *)th_malloc(sizeof(e_fp)*N*batch);
+	if (data==NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	for (t=0; t<batch; t++) {
+		e_fp *in=fromint_fp_vector(N,seed+t);
+		e_fp *group=data+(size_t)(t/FFT_BATCH_LANES)*N*FFT_BATCH_LANES;
+		for (i=0; i<N; i++)
+			group[i*FFT_BATCH_LANES+t%FFT_BATCH_LANES]=in[i];
+		th_free(in);
+	}
+	return data;
+}
+/* size of the work buffer for each algorithm, in e_fp */
+static int work_size(e_u32 algo, int N) {
+	int rows,cols;
+	switch (algo) {
+		case FFT_ALGO_STOCKHAM:
+			return N;
+		case FFT_ALGO_FOURSTEP:
+			/* intermediate matrix, a block of rows and the scratch buffer for the row transforms */
+			fourstep_shape(N,&rows,&cols);
+			return N+2*cols*(FFT_FOURSTEP_BLOCK+1);
+		default:
+			return 0;
+	}
+}
+
 void *define_params_radix2(unsigned int idx, char *name, char *dataset) {
     radix2_params *params;
 	e_s32 data_index=idx;
+	int algo_given=0;
 	init_preset_0();
 	init_preset_1();
 	init_preset_2();
 	init_preset_3();
 	init_preset_4();
 	init_preset_5();
+	init_preset_6();
 
 	/* parameter setup */
 	params=(radix2_params *)th_calloc(1,sizeof(radix2_params));
@@ -122,6 +293,8 @@ void *define_params_radix2(unsigned int idx, char *name, char *dataset) {
 	params->ref_avg=intparts_zero;
 	params->ref_data=NULL;
 	params->seed=0;
+	params->ref_computed=0;
+	params->batch=1;
 #if (USE_FP32)
 	params->minbits=MIN_ACC_BITS_FP32;
 #elif (USE_FP64)
@@ -141,16 +314,53 @@ void *define_params_radix2(unsigned int idx, char *name, char *dataset) {
 		params->ref_avg=presets_radix2[data_index].ref_avg;
 		params->ref_data=presets_radix2[data_index].ref_data;
 		params->seed=presets_radix2[data_index].seed;
+		params->ref_computed=presets_radix2[data_index].ref_computed;
 	} 
 	/* command line overrides */
 	if (pgo_training_run==0) {
 		th_parse_buf_flag_unsigned(dataset,"-s",&params->seed);
 		th_parse_buf_flag_unsigned(dataset,"-n",&params->N);
 		th_parse_buf_flag(dataset,"-g",&params->gen_ref);
+		algo_given=th_parse_buf_flag_unsigned(dataset,"-a",&params->algo);
+		th_parse_buf_flag_unsigned(dataset,"-b",&params->batch);
 	}
 	/* generate the data */
-	params->data=fromint_fp_vector(params->N,params->seed); /* default */
-	params->twp=calculate_twiddles(params->N,-1);
+	if (params->batch>1) {
+		char logbuf[128];
+		e_u32 lanes=(params->batch+FFT_BATCH_LANES-1)/FFT_BATCH_LANES*FFT_BATCH_LANES;
+		/* whole groups of lanes, batches always use the Stockham engine */
+		if (lanes!=params->batch) {
+			th_sprintf(logbuf,"fft: batch of %d rounded up to %d, a multiple of %d lanes\n",params->batch,lanes,FFT_BATCH_LANES);
+			th_log(TH_WARNING,logbuf);
+			params->batch=lanes;
+		}
+		if (algo_given && params->algo!=FFT_ALGO_STOCKHAM) {
+			th_sprintf(logbuf,"fft: -a%d ignored, batches use the Stockham engine (-a%d)\n",params->algo,FFT_ALGO_STOCKHAM);
+			th_log(TH_WARNING,logbuf);
+		}
+		params->algo=FFT_ALGO_STOCKHAM;
+		params->data=batch_input(params->N,params->batch,params->seed);
+		th_sprintf(logbuf,"fft: batch of %d transforms, %d lanes\n",params->batch,FFT_BATCH_LANES);
+		th_log(TH_INFO,logbuf);
+	} else {
+		params->batch=1;
+		params->data=fromint_fp_vector(params->N,params->seed); /* default */
+	}
+	/* twiddles are only read by the transforms, all contexts share this table */
+	switch (params->algo) {
+		case FFT_ALGO_RADIX2:
+			params->twp=calculate_twiddles(params->N,-1);
+			break;
+		case FFT_ALGO_STOCKHAM:
+			params->twp=calculate_stockham_twiddles(params->N,-1);
+			break;
+		case FFT_ALGO_FOURSTEP:
+			params->twp=calculate_fourstep_twiddles(params->N,-1);
+			break;
+		default:
+			th_exit( THE_BAD_SIZE, "Unknown FFT algorithm %d %s:%d", params->algo, __FILE__,__LINE__ );
+	}
+	params->work=NULL;
 	
 	return params;
 }
@@ -177,13 +387,26 @@ void *bmark_init_radix2(void *in_params) {
           th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	th_memcpy(myparams,params,sizeof(radix2_params));
 
-	myparams->data = (e_fp *)th_aligned_malloc(params->N*sizeof(e_fp), ALIGN_BOUNDARY);
+	myparams->data = (e_fp *)th_aligned_malloc((size_t)params->N*params->batch*sizeof(e_fp), ALIGN_BOUNDARY);
 	if ( myparams->data == NULL) {
 		th_printf("%s:%d - cannot allocate working array!", __FILE__, __LINE__ );
 		return NULL;
 	}
 
-	th_memcpy(myparams->data,params->data,params->N*sizeof(e_fp));
+	th_memcpy(myparams->data,params->data,(size_t)params->N*params->batch*sizeof(e_fp));
+	if (params->batch>1) {
+		myparams->work = (e_fp *)th_aligned_malloc(params->N*FFT_BATCH_LANES*sizeof(e_fp), ALIGN_BOUNDARY);
+		if ( myparams->work == NULL) {
+			th_printf("%s:%d - cannot allocate working array!", __FILE__, __LINE__ );
+			return NULL;
+		}
+	} else if (params->algo!=FFT_ALGO_RADIX2) {
+		myparams->work = (e_fp *)th_aligned_malloc(work_size(params->algo,params->N)*sizeof(e_fp), ALIGN_BOUNDARY);
+		if ( myparams->work == NULL) {
+			th_printf("%s:%d - cannot allocate working array!", __FILE__, __LINE__ );
+			return NULL;
+		}
+	}
 	
 	return myparams;
 }
@@ -195,11 +418,31 @@ void *bmark_fini_radix2(void *in_params) {
 
 	if (params->data)
 		th_aligned_free(params->data);
+	if (params->work)
+		th_aligned_free(params->work);
 	th_free(params);
 
 	return NULL;
 }
 
+/* Average of the output of the first transform, elements are stride apart.
+	Sets with a computed reference have millions of outputs, and a single precision sum of those
+	would be mostly rounding error, so they accumulate in double. */
+static e_fp output_avg(radix2_params *params, int stride) {
+	int i;
+	if (params->ref_computed) {
+		e_f64 sum=0.0;
+		for (i=0; i<params->N; i++)
+			sum+=params->data[i*stride];
+		return (e_fp)(sum/params->N);
+	} else {
+		e_fp avg=FPCONST(0.0);
+		for (i=0; i<params->N; i++)
+			avg+=params->data[i*stride];
+		return avg/params->N;
+	}
+}
+
 #if BMDEBUG
 static void dump_data(int iter, int N, e_fp * RESTRICT data)
 {
@@ -213,13 +456,28 @@ void *t_run_test_radix2(struct TCDef *tcdef,void *in_params) {
 	e_u32 test;
 	e_fp min=EE_MININI,max=EE_MAXINI,avg=FPCONST(0.0);
 	radix2_params *params=(radix2_params *)in_params;
-	FFT_transform_internal(params->N, params->data, -1, params->twp);
+	int stride=(params->batch>1) ? FFT_BATCH_LANES : 1;
+	if (params->batch>1) {
+		e_u32 g;
+		for (g=0; g<params->batch/FFT_BATCH_LANES; g++)
+			FFT_stockham_batch(params->N, (fft_lanes *)(params->data+(size_t)g*params->N*FFT_BATCH_LANES),
+				(fft_lanes *)params->work, -1, params->twp);
+	} else switch (params->algo) {
+		case FFT_ALGO_STOCKHAM:
+			FFT_stockham(params->N, params->data, params->work, -1, params->twp);
+			break;
+		case FFT_ALGO_FOURSTEP:
+			FFT_fourstep(params->N, params->data, params->work, -1, params->twp);
+			break;
+		default:
+			FFT_transform_internal(params->N, params->data, -1, params->twp);
+			break;
+	}
 	for (i=0; i<params->N ; i++) {
-		min=(min>params->data[i])?params->data[i]:min;
-		max=(max<params->data[i])?params->data[i]:max;
-		avg+=params->data[i];
+		min=(min>params->data[i*stride])?params->data[i*stride]:min;
+		max=(max<params->data[i*stride])?params->data[i*stride]:max;
 	}
-	avg/=params->N;
+	avg=output_avg(params,stride);
 	
 	test=fp_iaccurate_bits(avg,&params->ref_avg);
 	if (test>=params->minbits)
@@ -239,20 +497,20 @@ int bmark_verify_radix2(void *in_params) {
 	radix2_params *params=(radix2_params *)in_params;
 	if (params->gen_ref) {
 		e_fp min=EE_MININI,max=EE_MAXINI,avg=FPCONST(0.0);
+		int stride=(params->batch>1) ? FFT_BATCH_LANES : 1;
 		char sbuf[256];
 		th_printf("/**** START DATASET ****/\n#include \"th_lib.h\"\n#include \"../fft_radix2.h\"\n");
 		th_printf("static const intparts ref_data_index[]={\n"); 
 		for (i=0; i<params->N; i++) {
 			th_printf("\t");
-			th_print_fp(params->data[i]);
+			th_print_fp(params->data[i*stride]);
 			if (i<params->N-1)
 				th_printf(",\n");
-			min=(min>params->data[i])?params->data[i]:min;
-			max=(max<params->data[i])?params->data[i]:max;
-			avg+=params->data[i];
+			min=(min>params->data[i*stride])?params->data[i*stride]:min;
+			max=(max<params->data[i*stride])?params->data[i*stride]:max;
 		}
 		th_printf("}; //ref_data\n\n"); 
-		avg/=params->N;
+		avg=output_avg(params,stride);
 		th_printf("static intparts ref_avg=%s;\n",th_sprint_fp(avg,sbuf));
 		th_printf("static intparts ref_max=%s;\n",th_sprint_fp(max,sbuf));
 		th_printf("static intparts ref_min=%s;\n",th_sprint_fp(min,sbuf));
@@ -263,10 +521,29 @@ int bmark_verify_radix2(void *in_params) {
 		th_printf("/**** END DATASET ****/\n");
 	} else {
 		snr_result resa;
+#if (USE_FP32)
+		e_u32 minbits=NORM_ACC_BITS_FP32;
+#else
+		e_u32 minbits=params->minbits;
+#endif
+		if (params->batch>1)
+			return verify_batch(params,minbits);
+		if (params->ref_computed)
+			return verify_computed(params,minbits);
 		if (params->ref_data==NULL) {
 			th_printf("Cannot validate this dataset! Please generate reference data on reliable hardware and tools using -g!\n");
 			return -1;
 		}
+		if (params->algo!=FFT_ALGO_RADIX2) {
+			/* Rounding differs from the reference algorithm, and bins close to zero can differ in all bits,
+			   so the whole output is checked for relative error instead. */
+			e_u32 bits=normwise_bits(params->data,params->ref_data,params->N);
+			if (bits<minbits) {
+				th_printf("FFT normwise accuracy %d bits, expected at least %d\n",bits,minbits);
+				return 0;
+			}
+			return 1;
+		}
 		resa.bmin_ok=params->minbits;
 		ee_ifpbits_buffer(params->data,params->ref_data,params->N,&resa);
 	
@@ -276,6 +553,106 @@ int bmark_verify_radix2(void *in_params) {
 }
 
 
+/* bits of accuracy for squared norms of the error and of the reference */
+static e_u32 norm_bits(e_f64 err, e_f64 norm) {
+	e_u32 bits=0;
+	e_f64 scale=4.0;
+	while (bits<64 && err*scale<=norm) {
+		bits++;
+		scale*=4.0;
+	}
+	return bits;
+}
+/* number of bits to which data matches the reference, as ||data-ref|| / ||ref|| */
+static e_u32 normwise_bits(e_fp *data, intparts *ref, int N) {
+	int i;
+	e_fp r;
+	e_f64 err=0.0, norm=0.0;
+	for (i=0; i<N; i++) {
+		store_fp(&r,&ref[i]);
+		err+=((e_f64)data[i]-r)*((e_f64)data[i]-r);
+		norm+=(e_f64)r*r;
+	}
+	return norm_bits(err,norm);
+}
+/* Function: verify_computed
+	Datasets too large to keep the reference output in source only store the summary values.
+	The output is checked against the same input transformed by a second engine, Stockham,
+	or four step when Stockham is the engine under test.
+*/
+static int verify_computed(radix2_params *params, e_u32 minbits) {
+	int i, N=params->N;
+	e_u32 algo=(params->algo==FFT_ALGO_STOCKHAM) ? FFT_ALGO_FOURSTEP : FFT_ALGO_STOCKHAM;
+	e_fp *ref, *work, *twp;
+	e_f64 err=0.0, norm=0.0;
+	e_u32 bits;
+
+	ref=fromint_fp_vector(N,params->seed);
+	work=(e_fp *)th_aligned_malloc(work_size(algo,N)*sizeof(e_fp), ALIGN_BOUNDARY);
+	if (ref==NULL || work==NULL) {
+		th_printf("%s:%d - cannot allocate reference array!", __FILE__, __LINE__ );
+		return 0;
+	}
+	if (algo==FFT_ALGO_STOCKHAM) {
+		twp=calculate_stockham_twiddles(N,-1);
+		FFT_stockham(N, ref, work, -1, twp);
+	} else {
+		twp=calculate_fourstep_twiddles(N,-1);
+		FFT_fourstep(N, ref, work, -1, twp);
+	}
+	for (i=0; i<N; i++) {
+		err+=((e_f64)params->data[i]-ref[i])*((e_f64)params->data[i]-ref[i]);
+		norm+=(e_f64)ref[i]*ref[i];
+	}
+	if (twp)
+		th_free(twp);
+	th_aligned_free(work);
+	th_free(ref);
+	bits=norm_bits(err,norm);
+	if (bits<minbits) {
+		th_printf("FFT normwise accuracy %d bits vs computed reference, expected at least %d\n",bits,minbits);
+		return 0;
+	}
+	return 1;
+}
+/* Function: verify_batch
+	Every transform of a batch is checked normwise against its input transformed alone by <FFT_stockham>.
+*/
+static int verify_batch(radix2_params *params, e_u32 minbits) {
+	int i, N=params->N;
+	e_u32 t, bits;
+	e_fp *ref, *work;
+
+	work=(e_fp *)th_aligned_malloc(N*sizeof(e_fp), ALIGN_BOUNDARY);
+	if (work==NULL) {
+		th_printf("%s:%d - cannot allocate reference array!", __FILE__, __LINE__ );
+		return 0;
+	}
+	for (t=0; t<params->batch; t++) {
+		e_fp *out=params->data+(size_t)(t/FFT_BATCH_LANES)*N*FFT_BATCH_LANES+t%FFT_BATCH_LANES;
+		e_f64 err=0.0, norm=0.0;
+		ref=fromint_fp_vector(N,params->seed+t);
+		if (ref==NULL) {
+			th_printf("%s:%d - cannot allocate reference array!", __FILE__, __LINE__ );
+			th_aligned_free(work);
+			return 0;
+		}
+		FFT_stockham(N, ref, work, -1, params->twp);
+		for (i=0; i<N; i++) {
+			err+=((e_f64)out[i*FFT_BATCH_LANES]-ref[i])*((e_f64)out[i*FFT_BATCH_LANES]-ref[i]);
+			norm+=(e_f64)ref[i]*ref[i];
+		}
+		th_free(ref);
+		bits=norm_bits(err,norm);
+		if (bits<minbits) {
+			th_printf("FFT batch transform %d accuracy %d bits, expected at least %d\n",t,bits,minbits);
+			th_aligned_free(work);
+			return 0;
+		}
+	}
+	th_aligned_free(work);
+	return 1;
+}
 
 static void FFT_transform_internal (int N, e_fp * RESTRICT data, int direction, e_fp *twp) {
     int n = N/2;
@@ -358,6 +735,214 @@ static void FFT_transform_internal (int N, e_fp * RESTRICT data, int direction,
 #endif
 }
 
+/* Function: FFT_stockham
+	Stockham autosort FFT of N/2 complex points.
+
+	Each stage reads from one buffer and writes to the other (data and work), and the stage
+	indexing leaves the result in natural order, so there is no bit reversal pass.
+	The stages are radix 4 with one radix 2 stage at the end when log2(N/2) is odd,
+	and all accesses are unit stride within a group of s butterflies sharing the same twiddles.
+	twp is the table built by <calculate_stockham_twiddles> for the same direction.
+*/
+static void FFT_stockham(int N, e_fp * RESTRICT data, e_fp * RESTRICT work, int direction, e_fp *twp)
+{
+	int n, s, m, p, q;
+	e_fp *x = data, *y = work, *t;
+	e_fp *w = twp;
+	e_fp dir = (e_fp)direction;
+#if FFT_GNU_VEC
+	const fft_ivec swap = FFT_SWAP_PAIRS;
+	const fft_vec alt = FFT_ALT_SIGN;
+	const fft_vec jsign = alt * dir;
+#endif
+
+	if (N < 4) return;    /* single point, identity */
+
+	for (n = N/2, s = 1; n >= 4; n /= 4, s *= 4) {
+		m = n/4;
+		for (p = 0; p < m; p++, w += 6) {
+			e_fp *x0 = x + 2*s*p, *x1 = x0 + 2*s*m, *x2 = x1 + 2*s*m, *x3 = x2 + 2*s*m;
+			e_fp *y0 = y + 2*s*4*p, *y1 = y0 + 2*s, *y2 = y1 + 2*s, *y3 = y2 + 2*s;
+			q = 0;
+#if FFT_GNU_VEC
+			if (s >= FFT_VLEN/2) {
+				fft_vec w1r = (fft_vec){0} + w[0], w1i = alt * w[1];
+				fft_vec w2r = (fft_vec){0} + w[2], w2i = alt * w[3];
+				fft_vec w3r = (fft_vec){0} + w[4], w3i = alt * w[5];
+				for (; q < 2*s; q += FFT_VLEN) {
+					fft_vec a = *(fft_vec *)(x0+q), b = *(fft_vec *)(x1+q);
+					fft_vec c = *(fft_vec *)(x2+q), d = *(fft_vec *)(x3+q);
+					fft_vec apc = a + c, amc = a - c, bpd = b + d, bmd = b - d;
+					fft_vec jbmd = __builtin_shuffle(bmd, swap) * jsign;
+					fft_vec z1 = amc + jbmd, z2 = apc - bpd, z3 = amc - jbmd;
+					*(fft_vec *)(y0+q) = apc + bpd;
+					*(fft_vec *)(y1+q) = z1 * w1r + __builtin_shuffle(z1, swap) * w1i;
+					*(fft_vec *)(y2+q) = z2 * w2r + __builtin_shuffle(z2, swap) * w2i;
+					*(fft_vec *)(y3+q) = z3 * w3r + __builtin_shuffle(z3, swap) * w3i;
+				}
+			}
+#endif
+			for (; q < 2*s; q += 2) {
+				e_fp apc_r = x0[q] + x2[q],     apc_i = x0[q+1] + x2[q+1];
+				e_fp amc_r = x0[q] - x2[q],     amc_i = x0[q+1] - x2[q+1];
+				e_fp bpd_r = x1[q] + x3[q],     bpd_i = x1[q+1] + x3[q+1];
+				e_fp jbmd_r = -dir * (x1[q+1] - x3[q+1]);
+				e_fp jbmd_i =  dir * (x1[q] - x3[q]);
+				e_fp z1_r = amc_r + jbmd_r,     z1_i = amc_i + jbmd_i;
+				e_fp z2_r = apc_r - bpd_r,      z2_i = apc_i - bpd_i;
+				e_fp z3_r = amc_r - jbmd_r,     z3_i = amc_i - jbmd_i;
+				y0[q]   = apc_r + bpd_r;
+				y0[q+1] = apc_i + bpd_i;
+				y1[q]   = z1_r * w[0] - z1_i * w[1];
+				y1[q+1] = z1_i * w[0] + z1_r * w[1];
+				y2[q]   = z2_r * w[2] - z2_i * w[3];
+				y2[q+1] = z2_i * w[2] + z2_r * w[3];
+				y3[q]   = z3_r * w[4] - z3_i * w[5];
+				y3[q+1] = z3_i * w[4] + z3_r * w[5];
+			}
+		}
+		t = x; x = y; y = t;
+	}
+	if (n == 2) {
+		/* radix 2 stage, all twiddles are 1 */
+		for (q = 0; q < 2*s; q++) {
+			e_fp a = x[q], b = x[q+2*s];
+			y[q] = a + b;
+			y[q+2*s] = a - b;
+		}
+		t = x; x = y; y = t;
+	}
+	if (x != data)
+		th_memcpy(data, x, N*sizeof(e_fp));
+}
+
+/* Function: FFT_stockham_batch
+	<FFT_stockham> on a group of FFT_BATCH_LANES interleaved transforms of N/2 points.
+
+	The real and imaginary parts of a point are each a vector with one lane per transform,
+	so the stages are the scalar Stockham stages with every value replaced by a vector,
+	and the twiddles, shared by all lanes, are broadcast.
+*/
+static void FFT_stockham_batch(int N, fft_lanes * RESTRICT data, fft_lanes * RESTRICT work, int direction, e_fp *twp)
+{
+	int n, s, m, p, q;
+	fft_lanes *x = data, *y = work, *t;
+	e_fp *w = twp;
+	e_fp dir = (e_fp)direction;
+
+	if (N < 4) return;    /* single point, identity */
+
+	for (n = N/2, s = 1; n >= 4; n /= 4, s *= 4) {
+		m = n/4;
+		for (p = 0; p < m; p++, w += 6) {
+			fft_lanes *x0 = x + 2*s*p, *x1 = x0 + 2*s*m, *x2 = x1 + 2*s*m, *x3 = x2 + 2*s*m;
+			fft_lanes *y0 = y + 2*s*4*p, *y1 = y0 + 2*s, *y2 = y1 + 2*s, *y3 = y2 + 2*s;
+			for (q = 0; q < 2*s; q += 2) {
+				fft_lanes apc_r = x0[q] + x2[q],     apc_i = x0[q+1] + x2[q+1];
+				fft_lanes amc_r = x0[q] - x2[q],     amc_i = x0[q+1] - x2[q+1];
+				fft_lanes bpd_r = x1[q] + x3[q],     bpd_i = x1[q+1] + x3[q+1];
+				fft_lanes jbmd_r = -dir * (x1[q+1] - x3[q+1]);
+				fft_lanes jbmd_i =  dir * (x1[q] - x3[q]);
+				fft_lanes z1_r = amc_r + jbmd_r,     z1_i = amc_i + jbmd_i;
+				fft_lanes z2_r = apc_r - bpd_r,      z2_i = apc_i - bpd_i;
+				fft_lanes z3_r = amc_r - jbmd_r,     z3_i = amc_i - jbmd_i;
+				y0[q]   = apc_r + bpd_r;
+				y0[q+1] = apc_i + bpd_i;
+				y1[q]   = z1_r * w[0] - z1_i * w[1];
+				y1[q+1] = z1_i * w[0] + z1_r * w[1];
+				y2[q]   = z2_r * w[2] - z2_i * w[3];
+				y2[q+1] = z2_i * w[2] + z2_r * w[3];
+				y3[q]   = z3_r * w[4] - z3_i * w[5];
+				y3[q+1] = z3_i * w[4] + z3_r * w[5];
+			}
+		}
+		t = x; x = y; y = t;
+	}
+	if (n == 2) {
+		/* radix 2 stage, all twiddles are 1 */
+		for (q = 0; q < 2*s; q++) {
+			fft_lanes a = x[q], b = x[q+2*s];
+			y[q] = a + b;
+			y[q+2*s] = a - b;
+		}
+		t = x; x = y; y = t;
+	}
+	if (x != data)
+		th_memcpy(data, x, N*sizeof(fft_lanes));
+}
+
+/* Function: FFT_fourstep
+	Bailey four step FFT of N/2 complex points, for transforms that do not fit in the caches.
+
+	The points are treated as a matrix of rows x cols, x[j1+rows*j2] with j1 a column and j2 a row.
+	The first pass transforms the columns, applies the W^(j1*k2) twiddles and stores the
+	matrix transposed in work. The second pass transforms the rows of work and stores them transposed
+	back into data, which leaves the output in natural order.
+	Each transpose moves <FFT_FOURSTEP_BLOCK> rows at a time through a small buffer, so both passes
+	read and write whole cache lines, and every short transform runs in cache with <FFT_stockham>.
+	twp is the table built by <calculate_fourstep_twiddles> for the same direction,
+	work must hold <work_size> values.
+*/
+static void FFT_fourstep(int N, e_fp * RESTRICT data, e_fp * RESTRICT work, int direction, e_fp *twp)
+{
+	int rows, cols, logc, blk, j, k, b, e;
+	e_fp *twc, *twr, *wlo, *whi, *buf, *scratch;
+
+	if (N < 4) return;    /* single point, identity */
+	fourstep_shape(N, &rows, &cols);
+	logc = int_log2(cols);
+	twc = twp;
+	twr = twc + fill_stockham_twiddles(NULL, 2*cols, direction);
+	wlo = twr + fill_stockham_twiddles(NULL, 2*rows, direction);
+	whi = wlo + 2*cols;
+	buf = work + N;
+	scratch = buf + 2*cols*FFT_FOURSTEP_BLOCK;
+
+	/* columns, twiddles, and transpose into work */
+	blk = (rows < FFT_FOURSTEP_BLOCK) ? rows : FFT_FOURSTEP_BLOCK;
+	for (j = 0; j < rows; j += blk) {
+		for (k = 0; k < cols; k++) {
+			e_fp *src = data + 2*(k*rows + j);
+			for (b = 0; b < blk; b++) {
+				buf[2*(b*cols+k)]   = src[2*b];
+				buf[2*(b*cols+k)+1] = src[2*b+1];
+			}
+		}
+		for (b = 0; b < blk; b++) {
+			e_fp *row = buf + 2*b*cols;
+			FFT_stockham(2*cols, row, scratch, direction, twc);
+			for (k = 1, e = j+b; e > 0 && k < cols; k++, e += j+b) {
+				e_fp *lo = wlo + 2*(e & (cols-1)), *hi = whi + 2*(e >> logc);
+				e_fp w_real = lo[0]*hi[0] - lo[1]*hi[1];
+				e_fp w_imag = lo[0]*hi[1] + lo[1]*hi[0];
+				e_fp z_real = row[2*k], z_imag = row[2*k+1];
+				row[2*k]   = z_real*w_real - z_imag*w_imag;
+				row[2*k+1] = z_imag*w_real + z_real*w_imag;
+			}
+		}
+		for (k = 0; k < cols; k++) {
+			e_fp *dst = work + 2*(k*rows + j);
+			for (b = 0; b < blk; b++) {
+				dst[2*b]   = buf[2*(b*cols+k)];
+				dst[2*b+1] = buf[2*(b*cols+k)+1];
+			}
+		}
+	}
+	/* rows, and transpose back into data */
+	blk = (cols < FFT_FOURSTEP_BLOCK) ? cols : FFT_FOURSTEP_BLOCK;
+	for (k = 0; k < cols; k += blk) {
+		e_fp *src = work + 2*k*rows;
+		for (b = 0; b < blk; b++)
+			FFT_stockham(2*rows, src + 2*b*rows, scratch, direction, twr);
+		for (j = 0; j < rows; j++) {
+			e_fp *dst = data + 2*(j*cols + k);
+			for (b = 0; b < blk; b++) {
+				dst[2*b]   = src[2*(b*rows+j)];
+				dst[2*b+1] = src[2*(b*rows+j)+1];
+			}
+		}
+	}
+}
 
 static void FFT_bitreverse(int N, e_fp * RESTRICT data) {
     /* This is the Goldrader bit-reversal algorithm */
@@ -13,6 +13,11 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #ifndef _FFTR2_H_
 #define _FFTR2_H_
 
+/* FFT algorithms, selected with dataset flag -a */
+#define FFT_ALGO_RADIX2		0	/* in place radix 2 with bit reversal */
+#define FFT_ALGO_STOCKHAM	1	/* Stockham autosort, radix 4 */
+#define FFT_ALGO_FOURSTEP	2	/* Bailey four step, for transforms larger than the caches */
+
 typedef struct radix2_params_s {
 	e_fp *data;
 	e_fp *twp;
@@ -24,11 +29,15 @@ typedef struct radix2_params_s {
 	intparts ref_avg;
 	e_u32 minbits;
 	e_u32 seed;
+	e_u32 algo;
+	e_fp *work;
+	e_u32 ref_computed; /* only the summary is stored, the output is checked against a second engine */
+	e_u32 batch; /* number of transforms per run, interleaved by FFT_BATCH_LANES */
 } radix2_params;
 
 /* When adding new data, replace "index" with current NUM_DATAS in generated data,	*
  * add proto and call init_preset_NUM_DATAS in init, and increase NUM_DATAS by 1	*/
-#define NUM_DATAS 6
+#define NUM_DATAS 7
 extern radix2_params presets_radix2[NUM_DATAS];
 
 #endif
\ No newline at end of file
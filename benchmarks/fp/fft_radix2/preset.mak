@@ -1,5 +1,5 @@
 SRC_BASE = fft_radix2
-DATA_BASE = 2K 32K 4K data3_big data4_mid data5_small
+DATA_BASE = 2K 32K 4K data3_big data4_mid data5_small data6_huge
 
 ifdef PRECISION
 KERNEL_DEFINES+=$(CDEFN)$(PRECISION)
@@ -0,0 +1,28 @@
+/*
+(C) 2014 EEMBC(R).  All rights reserved.                            
+
+All EEMBC Benchmark Software are products of EEMBC 
+and are provided under the terms of the EEMBC Benchmark License Agreements.  
+The EEMBC Benchmark Software are proprietary intellectual properties of EEMBC and its Members 
+and is protected under all applicable laws, including all applicable copyright laws.  
+If you received this EEMBC Benchmark Software without having 
+a currently effective EEMBC Benchmark License Agreement, you must discontinue use. 
+Please refer to LICENSE.md for the specific license agreement that pertains to this Benchmark Software.
+*/
+
+/**** START DATASET ****/
+#include "th_lib.h"
+#include "../fft_radix2.h"
+static intparts ref_avg={0,7,0x0010010c,0x8f2b8ed4}/*1.280327831125965758e+02*/;
+static intparts ref_max={0,28,0x00126eb4,0x0a9f7356}/*3.092449386228536367e+08*/;
+static intparts ref_min={1,28,0x0012715f,0x32cab959}/*-3.094198267918906808e+08*/;
+void init_preset_6() {
+presets_radix2[6].ref_data=NULL;
+presets_radix2[6].ref_computed=1;
+presets_radix2[6].N=2097152;
+presets_radix2[6].seed=6710900;
+presets_radix2[6].ref_avg=ref_avg;
+presets_radix2[6].ref_max=ref_max;
+presets_radix2[6].ref_min=ref_min;
+}
+/**** END DATASET ****/
@@ -20,6 +20,7 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include "th_math.h" /* for sin, cos and pow */
 #include "th_lib.h"
 #include "th_rand.h" /* initialize a random data vector */
+#include "al_smp.h"
 #include "linpack.h"
 #define DEBUG_LINPACK 0
 #if DEBUG_LINPACK || BMDEBUG
@@ -28,6 +29,69 @@ static int dbgi=1;
 
 linpack_params presets_linpack[NUM_DATAS];
 
+/* Blocked LU tuning.
+	The trailing update works on LINPACK_MC rows of the panel at a time, packed in strips of LINPACK_MR rows,
+	and updates LINPACK_MR x LINPACK_NR blocks of the trailing matrix in registers.
+	LINPACK_MC must be a multiple of LINPACK_MR.
+*/
+#ifndef LINPACK_MC
+#define LINPACK_MC 256
+#endif
+#define LINPACK_NR 4
+#if !USE_RVV && defined(__GNUC__) && (USE_FP32 || USE_FP64)
+#define LINPACK_GNU_VEC 1
+#if defined(__AVX__)
+#define LINPACK_VBYTES 32
+#else
+#define LINPACK_VBYTES 16
+#endif
+#define LINPACK_VLEN (LINPACK_VBYTES/(int)sizeof(e_fp))
+typedef e_fp lp_vec __attribute__((vector_size(LINPACK_VBYTES),aligned(sizeof(e_fp))));
+#define LINPACK_MR (2*LINPACK_VLEN)
+#else
+#define LINPACK_GNU_VEC 0
+#define LINPACK_MR 16
+#endif
+/* Panel width used by the task parallel LU if none was selected */
+#ifndef LINPACK_TEAM_BLOCK
+#define LINPACK_TEAM_BLOCK 32
+#endif
+
+/* Task parallel LU.
+	A team of threads owned by the work item factors one matrix at a time.
+	The matrix is split in column blocks of the panel width, and each task either factors
+	block p as a panel, or updates block j with panel p (p<j).
+	Tasks are handed out under the team lock as their inputs become ready, and the next panel is
+	always preferred, so panel p+1 is factored as soon as its own block is updated with panel p
+	while the other updates with panel p are still running (lookahead).
+*/
+typedef struct linpack_team_s linpack_team;
+typedef struct linpack_worker_s {
+	linpack_team *team;
+	e_fp *pack;		/* panel pack of this thread */
+} linpack_worker;
+struct linpack_team_s {
+	al_mutex_t lock;
+	al_cond_t wake;		/* a job was posted, a task completed, or the team is shutting down */
+	al_cond_t idle;		/* the last helper left the job */
+	int nthreads;		/* including the thread that posts the job */
+	al_thread_t *threads;
+	linpack_worker *workers;
+	e_u32 job;			/* job serial number */
+	int quit;
+	int active;			/* helpers that did not finish the current job yet */
+	/* current job */
+	e_fp *a;
+	int lda,n,nb,nblocks,info;
+	e_u16 *ipvt;
+	int *applied;		/* per block, number of panels applied to it */
+	char *busy;			/* per block, a task is using it */
+	int factored;		/* number of panels factored */
+	int remaining;		/* tasks not completed */
+};
+static linpack_team *linpack_team_create(int nthreads,int n,int nb);
+static void linpack_team_destroy(linpack_team *team);
+
 /* ======================================================================== */
 /*         FALSE U N C TRUE I O N   P R O TRUE O TRUE Y P E S                            */
 /* ======================================================================== */
@@ -51,7 +115,14 @@ static void linpack_first(linpack_params *params);
 static e_fp run_single_linpack(int outer,int inner,int lda,linpack_params *params);
 static void run_linpack(linpack_params *params);
 static void matgen(e_fp *a,int lda,int n,e_fp *b,e_fp *norma,e_u32 init, linpack_params *params);
+static void lu_factor(e_fp *a,int lda,int n,e_u16 ipvt[],int *info,linpack_params *params);
 static void dgefa(e_fp *a,int lda,int n,e_u16 ipvt[],int *info);
+static void dgefa_blocked(e_fp *a,int lda,int n,e_u16 ipvt[],int *info,int nb,e_fp *pack);
+static void dgefa_team(linpack_team *team,e_fp *a,int lda,int n,e_u16 ipvt[],int *info,int nb);
+static void lu_panel(e_fp *a,int lda,int n,e_u16 ipvt[],int k0,int ke,int *info);
+static void lu_trailing(e_fp *a,int lda,int n,e_u16 ipvt[],int k0,int ke,int j0,int j1,e_fp *pack);
+static void lu_restore(e_fp *a,int lda,e_u16 ipvt[],int k0,int ke);
+static void lu_update(int m,int nc,int kb,e_fp *l,e_fp *u,e_fp *c,int lda,e_fp *pack);
 static void dgesl(e_fp * RESTRICT a,int lda,int n,e_u16 ipvt[],e_fp * RESTRICT b,int job);
 static void daxpy(int n,e_fp da,e_fp * RESTRICT dx,int incx,e_fp * RESTRICT dy,int incy);
 static e_fp ddot(int n,e_fp *dx,int incx,e_fp *dy,int incy);
@@ -93,8 +164,17 @@ void *define_params_linpack(unsigned int idx, char *name, char *dataset) {
 		th_parse_buf_flag_unsigned(dataset,"-n",&params->n);
 		th_parse_buf_flag_unsigned(dataset,"-l",&params->ntimes);
 		th_parse_buf_flag(dataset,"-g",&params->gen_ref);
+		th_parse_buf_flag_unsigned(dataset,"-b",&params->block);
+		th_parse_buf_flag_unsigned(dataset,"-p",&params->threads);
 	}
+#if USE_SINGLE_CONTEXT
+	params->threads=0;
+#endif
+	if (params->threads>1 && params->block==0)
+		params->block=LINPACK_TEAM_BLOCK;
 	params->lda=1+params->n;
+	params->pack=NULL;
+	params->team=NULL;
 
 #if USE_FP64
 	params->random_values=fromint_fp_vector(1+params->random_mask,params->seed);
@@ -138,6 +218,13 @@ void *bmark_init_linpack(void *in_params) {
 	myparams->ipvt=(e_u16 *)th_malloc(sizeof(e_u16)*(lda-1));
 	if (( myparams->a == NULL ) || ( myparams->b == NULL ) || ( myparams->ipvt == NULL ))
         th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	if (myparams->block) {
+		myparams->pack=(e_fp *)th_malloc(sizeof(e_fp)*LINPACK_MC*myparams->block);
+		if ( myparams->pack == NULL )
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	}
+	if (myparams->threads>1)
+		myparams->team=linpack_team_create(myparams->threads,myparams->n,myparams->block);
 
 	return myparams;
 }
@@ -153,6 +240,10 @@ void *bmark_fini_linpack(void *in_params) {
 		th_free(params->b);
 	if (params->ipvt!=NULL)
 		th_free(params->ipvt);
+	if (params->pack!=NULL)
+		th_free(params->pack);
+	if (params->team!=NULL)
+		linpack_team_destroy(params->team);
 	th_free(params);
 
 	return NULL;
@@ -262,6 +353,8 @@ static void linpack_first(linpack_params *params) {
 	e_fp *x=(e_fp *)th_malloc(sizeof(e_fp)*(lda-1));
 	e_u16 *ipvt=(e_u16 *)th_malloc(sizeof(e_u16)*(lda-1));
 	int info,i;
+	if (params->block)
+		params->pack=(e_fp *)th_malloc(sizeof(e_fp)*LINPACK_MC*params->block);
 /* initial run once to derive platform verification values - helps debug, does not affect timing */
 	matgen(a,lda,n,b,&norma,1325,params);
 #if BMDEBUG
@@ -274,7 +367,7 @@ static void linpack_first(linpack_params *params) {
 	}
 	th_printf("\n");
 #endif
-	dgefa(a,lda,n,ipvt,&info);
+	lu_factor(a,lda,n,ipvt,&info,params);
 	dgesl(a,lda,n,ipvt,b,0);
 /* compute a residual to verify results.  */
 	for (i = 0; i < n; i++) {
@@ -305,6 +398,10 @@ static void linpack_first(linpack_params *params) {
 	th_free(b);
 	th_free(x);
 	th_free(ipvt);
+	if (params->pack) {
+		th_free(params->pack);
+		params->pack=NULL;
+	}
 }
 
 static e_fp get_avg(e_fp *a, int maxidx) {
@@ -330,14 +427,14 @@ static e_fp run_single_linpack(int outer, int inner, int lda, linpack_params *pa
 		/*  matgen generates a new input each time through.
 			make the input different each time so code does not get optimized away... */
 		matgen(a,lda,n,b,&norma,random_u32(params->r),params);
-		dgefa(a,lda,n,ipvt,&info);
+		lu_factor(a,lda,n,ipvt,&info,params);
 		dgesl(a,lda,n,ipvt,b,0);
 		/* Now account for the final values calculated */
 		feedback[j++]=get_avg(b,n);
 	}
 	for (i = 0; i < inner; i++) {
 		matgen(a,lda,n,b,&norma,random_u32(params->r),params);
-		dgefa(a,lda,n,ipvt,&info);
+		lu_factor(a,lda,n,ipvt,&info,params);
 		/* Since only the last pivots will be used, make sure to collect something from all pivots,
 			otherwise a smart compiler can eliminate all but the last iteration */
 		feedback[j++]=(e_fp)(th_crcbuffer(ipvt,sizeof(e_u16)*n,0)/32768)+norma;
@@ -379,6 +476,18 @@ static void matgen(e_fp *a,int lda,int n,e_fp *b,e_fp *norma,e_u32 init, linpack
 	}
 }
 
+/*----------------------*/
+static void lu_factor(e_fp *a,int lda,int n,e_u16 ipvt[],int *info,linpack_params *params)
+/* factor with dgefa, with dgefa_blocked if a panel width was selected, or with the team of the item */
+{
+	if (params->team)
+		dgefa_team(params->team,a,lda,n,ipvt,info,params->block);
+	else if (params->block)
+		dgefa_blocked(a,lda,n,ipvt,info,params->block,params->pack);
+	else
+		dgefa(a,lda,n,ipvt,info);
+}
+
 /*----------------------*/
 static void dgefa(e_fp *a,int lda,int n,e_u16 ipvt[],int *info)
 /* In this function, references to a[i][j] are written a[lda*i+j].  */
@@ -486,6 +595,435 @@ int idamax(),j,k,kp1,l,nm1;
 	if (a[lda*(n-1)+(n-1)] == ZERO) *info = n-1;
 }
 
+/*----------------------*/
+static void dgefa_blocked(e_fp *a,int lda,int n,e_u16 ipvt[],int *info,int nb,e_fp *pack)
+/* In this function, references to a[i][j] are written a[lda*i+j].  */
+/*
+     dgefa_blocked computes the same factorization as dgefa, with the
+     same output format, working on panels of nb columns at a time.
+
+     each panel is factored with the unblocked algorithm, except that
+     row interchanges are applied to all the columns of the panel, so
+     the multipliers line up with the rows of the trailing matrix
+     (lu_panel). the trailing columns are then interchanged, solved
+     against the unit lower triangle of the panel, and updated with a
+     single rank nb product instead of nb passes of daxpy over the
+     whole trailing matrix (lu_trailing). finally the interchanges made
+     inside the multipliers are undone (lu_restore), so dgesl can use
+     the result unchanged.
+
+     on entry
+
+        a, lda, n    as for dgefa.
+
+        nb      integer
+                the panel width.
+
+        pack    e_fp precision[LINPACK_MC*nb]
+                work space for the packed panel.
+
+     on return
+
+        a, ipvt, info    as for dgefa.
+*/
+{
+	int k0,ke;
+
+	*info = 0;
+	for (k0 = 0; k0 < n; k0 = ke) {
+		ke = (n - k0 < nb) ? n : k0 + nb;
+		lu_panel(a,lda,n,ipvt,k0,ke,info);
+		lu_trailing(a,lda,n,ipvt,k0,ke,ke,n,pack);
+		lu_restore(a,lda,ipvt,k0,ke);
+	}
+}
+
+/*----------------------*/
+static void lu_panel(e_fp *a,int lda,int n,e_u16 ipvt[],int k0,int ke,int *info)
+/*
+     factor columns k0 to ke-1 of a with the trailing columns left
+     as they are. interchanges are applied to all the panel columns.
+*/
+{
+	e_fp t;
+	int j,k,l;
+
+	for (k = k0; k < ke; k++) {
+		l = idamax(n-k,&a[lda*k+k],1) + k;
+		ipvt[k] = l;
+		if (a[lda*k+l] == ZERO) {
+			*info = k;
+			continue;
+		}
+		if (l != k) {
+			for (j = k0; j < ke; j++) {
+				t = a[lda*j+l];
+				a[lda*j+l] = a[lda*j+k];
+				a[lda*j+k] = t;
+			}
+		}
+		t = -ONE/a[lda*k+k];
+		dscal(n-(k+1),t,&a[lda*k+k+1],1);
+		for (j = k+1; j < ke; j++)
+			daxpy(n-(k+1),a[lda*j+k],&a[lda*k+k+1],1,&a[lda*j+k+1],1);
+	}
+}
+
+/*----------------------*/
+static void lu_trailing(e_fp *a,int lda,int n,e_u16 ipvt[],int k0,int ke,int j0,int j1,e_fp *pack)
+/*
+     apply the panel in columns k0 to ke-1, as left by lu_panel,
+     to columns j0 to j1-1.
+*/
+{
+	e_fp t;
+	int j,k,l;
+
+	if (j0 >= j1)
+		return;
+
+	/* interchange and solve the panel rows */
+
+	for (j = j0; j < j1; j++) {
+		for (k = k0; k < ke; k++) {
+			l = ipvt[k];
+			if (l != k) {
+				t = a[lda*j+l];
+				a[lda*j+l] = a[lda*j+k];
+				a[lda*j+k] = t;
+			}
+		}
+		for (k = k0; k < ke-1; k++)
+			daxpy(ke-(k+1),a[lda*j+k],&a[lda*k+k+1],1,&a[lda*j+k+1],1);
+	}
+
+	/* rank ke-k0 update of the rows below the panel */
+
+	lu_update(n-ke,j1-j0,ke-k0,&a[lda*k0+ke],&a[lda*j0+k0],&a[lda*j0+ke],lda,pack);
+}
+
+/*----------------------*/
+static void lu_restore(e_fp *a,int lda,e_u16 ipvt[],int k0,int ke)
+/*
+     undo the interchanges lu_panel applied to the multipliers,
+     leaving them in the order dgesl expects.
+*/
+{
+	e_fp t;
+	int j,k,l;
+
+	for (k = ke-1; k > k0; k--) {
+		l = ipvt[k];
+		if (l != k) {
+			for (j = k0; j < k; j++) {
+				t = a[lda*j+l];
+				a[lda*j+l] = a[lda*j+k];
+				a[lda*j+k] = t;
+			}
+		}
+	}
+}
+
+/*----------------------*/
+static void lu_tasks(linpack_team *t,e_fp *pack)
+/*
+     run tasks of the current job until all of them are completed.
+     called and returns with the team lock held.
+*/
+{
+	int p,j,k0,ke,info;
+
+	while (t->remaining > 0) {
+		/* next panel, once all the previous panels were applied to it */
+		p = t->factored;
+		if (p < t->nblocks && !t->busy[p] && t->applied[p] == p) {
+			t->busy[p] = 1;
+			info = t->info;
+			al_mutex_unlock(&t->lock);
+			k0 = p*t->nb;
+			ke = (t->n - k0 < t->nb) ? t->n : k0 + t->nb;
+			lu_panel(t->a,t->lda,t->n,t->ipvt,k0,ke,&info);
+			al_mutex_lock(&t->lock);
+			t->info = info;
+			t->factored++;
+		} else {
+			/* lowest block that can take the next panel it needs */
+			for (j = 0; j < t->nblocks; j++) {
+				if (!t->busy[j] && t->applied[j] < j && t->applied[j] < t->factored)
+					break;
+			}
+			if (j == t->nblocks) {
+				al_cond_wait(&t->wake,&t->lock);
+				continue;
+			}
+			p = t->applied[j];
+			t->busy[j] = 1;
+			al_mutex_unlock(&t->lock);
+			k0 = p*t->nb;
+			ke = k0 + t->nb;
+			lu_trailing(t->a,t->lda,t->n,t->ipvt,k0,ke,j*t->nb,
+				(t->n - j*t->nb < t->nb) ? t->n : (j+1)*t->nb,pack);
+			al_mutex_lock(&t->lock);
+			t->applied[j]++;
+			p = j;
+		}
+		t->busy[p] = 0;
+		t->remaining--;
+		al_cond_broadcast(&t->wake);
+	}
+}
+
+/*----------------------*/
+static void *lu_helper(void *arg)
+/* thread of the team, runs tasks of each job posted by dgefa_team */
+{
+	linpack_worker *w=(linpack_worker *)arg;
+	linpack_team *t=w->team;
+	e_u32 job=0;
+
+	al_mutex_lock(&t->lock);
+	for (;;) {
+		while (!t->quit && t->job == job)
+			al_cond_wait(&t->wake,&t->lock);
+		if (t->quit)
+			break;
+		job = t->job;
+		lu_tasks(t,w->pack);
+		if (--t->active == 0)
+			al_cond_signal(&t->idle);
+	}
+	al_mutex_unlock(&t->lock);
+	return NULL;
+}
+
+/*----------------------*/
+static void dgefa_team(linpack_team *t,e_fp *a,int lda,int n,e_u16 ipvt[],int *info,int nb)
+/*
+     same factorization as dgefa_blocked, with the panels and trailing
+     updates executed by the team as soon as their inputs are ready.
+*/
+{
+	int j,k0;
+
+	al_mutex_lock(&t->lock);
+	t->a = a;
+	t->lda = lda;
+	t->n = n;
+	t->nb = nb;
+	t->ipvt = ipvt;
+	t->info = 0;
+	t->nblocks = (n + nb - 1)/nb;
+	for (j = 0; j < t->nblocks; j++) {
+		t->applied[j] = 0;
+		t->busy[j] = 0;
+	}
+	t->factored = 0;
+	t->remaining = t->nblocks + t->nblocks*(t->nblocks-1)/2;
+	t->active = t->nthreads - 1;
+	t->job++;
+	al_cond_broadcast(&t->wake);
+	lu_tasks(t,t->workers[0].pack);
+	while (t->active > 0)
+		al_cond_wait(&t->idle,&t->lock);
+	*info = t->info;
+	al_mutex_unlock(&t->lock);
+
+	for (k0 = 0; k0 < n; k0 += nb)
+		lu_restore(a,lda,ipvt,k0,(n - k0 < nb) ? n : k0 + nb);
+}
+
+/*----------------------*/
+static linpack_team *linpack_team_create(int nthreads,int n,int nb)
+/*
+     create a team of nthreads, the thread calling dgefa_team and
+     nthreads-1 helpers, for matrices of order up to n.
+*/
+{
+	linpack_team *t;
+	mith_textend tex;
+	int i,nblocks=(n + nb - 1)/nb;
+
+	t=(linpack_team *)th_calloc(1,sizeof(linpack_team));
+	if (t == NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	t->nthreads = nthreads;
+	t->threads = (al_thread_t *)th_malloc(sizeof(al_thread_t)*nthreads);
+	t->workers = (linpack_worker *)th_malloc(sizeof(linpack_worker)*nthreads);
+	t->applied = (int *)th_malloc(sizeof(int)*nblocks);
+	t->busy = (char *)th_malloc(nblocks);
+	if (t->threads == NULL || t->workers == NULL || t->applied == NULL || t->busy == NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	al_mutex_init(&t->lock);
+	al_cond_init(&t->wake);
+	al_cond_init(&t->idle);
+	for (i = 0; i < nthreads; i++) {
+		t->workers[i].team = t;
+		t->workers[i].pack = (e_fp *)th_malloc(sizeof(e_fp)*LINPACK_MC*nb);
+		if (t->workers[i].pack == NULL)
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	}
+	for (i = 1; i < nthreads; i++) {
+		al_item_textend(&tex, i);
+		al_thread_create_ex(&t->threads[i],lu_helper,&t->workers[i],&tex);
+	}
+	return t;
+}
+
+/*----------------------*/
+static void linpack_team_destroy(linpack_team *t)
+{
+	void *retval;
+	int i;
+
+	al_mutex_lock(&t->lock);
+	t->quit = 1;
+	al_cond_broadcast(&t->wake);
+	al_mutex_unlock(&t->lock);
+	for (i = 1; i < t->nthreads; i++)
+		al_thread_join(t->threads[i],&retval);
+	al_cond_destroy(&t->idle);
+	al_cond_destroy(&t->wake);
+	al_mutex_destroy(&t->lock);
+	for (i = 0; i < t->nthreads; i++)
+		th_free(t->workers[i].pack);
+	th_free(t->busy);
+	th_free(t->applied);
+	th_free(t->workers);
+	th_free(t->threads);
+	th_free(t);
+}
+
+/*----------------------*/
+static void lu_pack(int mc,int kb,e_fp *l,int lda,e_fp *pack)
+/*
+     copy mc rows of the kb columns of l to pack, in strips of
+     LINPACK_MR rows stored one column after the other. the last
+     strip is padded with zeros.
+*/
+{
+	int i,k,r;
+
+	for (i = 0; i < mc; i += LINPACK_MR) {
+		for (k = 0; k < kb; k++) {
+			for (r = 0; r < LINPACK_MR; r++)
+				pack[r] = (i + r < mc) ? l[lda*k+i+r] : ZERO;
+			pack += LINPACK_MR;
+		}
+	}
+}
+
+/*----------------------*/
+static void lu_kernel(int kb,e_fp * RESTRICT pa,e_fp * RESTRICT b,e_fp * RESTRICT c,int ld,int mr,int nr)
+/*
+     c[nr][mr] += pa * b[nr][kb], where pa is one packed strip of
+     LINPACK_MR rows and kb columns, and b and c have leading
+     dimension ld. mr is at most LINPACK_MR, nr at most LINPACK_NR.
+*/
+{
+	int i,j,k;
+#if LINPACK_GNU_VEC
+	lp_vec c00,c01,c10,c11,c20,c21,c30,c31,a0,a1;
+	e_fp tmp[LINPACK_MR];
+
+	if (nr == LINPACK_NR) {
+		c00 = c01 = c10 = c11 = c20 = c21 = c30 = c31 = (lp_vec){0};
+		for (k = 0; k < kb; k++) {
+			a0 = *(lp_vec *)(pa+LINPACK_MR*k);
+			a1 = *(lp_vec *)(pa+LINPACK_MR*k+LINPACK_VLEN);
+			c00 += a0*b[k];      c01 += a1*b[k];
+			c10 += a0*b[ld+k];   c11 += a1*b[ld+k];
+			c20 += a0*b[2*ld+k]; c21 += a1*b[2*ld+k];
+			c30 += a0*b[3*ld+k]; c31 += a1*b[3*ld+k];
+		}
+		if (mr == LINPACK_MR) {
+			*(lp_vec *)(c)                     += c00;
+			*(lp_vec *)(c+LINPACK_VLEN)        += c01;
+			*(lp_vec *)(c+ld)                  += c10;
+			*(lp_vec *)(c+ld+LINPACK_VLEN)     += c11;
+			*(lp_vec *)(c+2*ld)                += c20;
+			*(lp_vec *)(c+2*ld+LINPACK_VLEN)   += c21;
+			*(lp_vec *)(c+3*ld)                += c30;
+			*(lp_vec *)(c+3*ld+LINPACK_VLEN)   += c31;
+			return;
+		}
+		for (j = 0; j < LINPACK_NR; j++) {
+			switch (j) {
+				case 0: a0 = c00; a1 = c01; break;
+				case 1: a0 = c10; a1 = c11; break;
+				case 2: a0 = c20; a1 = c21; break;
+				default: a0 = c30; a1 = c31; break;
+			}
+			*(lp_vec *)(tmp) = a0;
+			*(lp_vec *)(tmp+LINPACK_VLEN) = a1;
+			for (i = 0; i < mr; i++)
+				c[ld*j+i] += tmp[i];
+		}
+		return;
+	}
+	/* remaining columns, one at a time */
+	for (j = 0; j < nr; j++) {
+		c00 = c01 = (lp_vec){0};
+		for (k = 0; k < kb; k++) {
+			c00 += *(lp_vec *)(pa+LINPACK_MR*k)*b[ld*j+k];
+			c01 += *(lp_vec *)(pa+LINPACK_MR*k+LINPACK_VLEN)*b[ld*j+k];
+		}
+		*(lp_vec *)(tmp) = c00;
+		*(lp_vec *)(tmp+LINPACK_VLEN) = c01;
+		for (i = 0; i < mr; i++)
+			c[ld*j+i] += tmp[i];
+	}
+#elif USE_RVV
+	for (j = 0; j < nr; j++) {
+		for (i = 0; i < mr;) {
+			size_t vl = __riscv_vsetvl_e32m8(mr-i);
+			vfloat32m8_t cs = __riscv_vle32_v_f32m8(&c[ld*j+i], vl);
+			for (k = 0; k < kb; k++) {
+				vfloat32m8_t as = __riscv_vle32_v_f32m8(&pa[LINPACK_MR*k+i], vl);
+				cs = __riscv_vfmadd_vf_f32m8(as, b[ld*j+k], cs, vl);
+			}
+			__riscv_vse32_v_f32m8(&c[ld*j+i], cs, vl);
+			i += vl;
+		}
+	}
+#else
+	e_fp acc[LINPACK_NR][LINPACK_MR];
+
+	for (j = 0; j < nr; j++)
+		for (i = 0; i < LINPACK_MR; i++)
+			acc[j][i] = ZERO;
+	for (k = 0; k < kb; k++)
+		for (j = 0; j < nr; j++)
+			for (i = 0; i < LINPACK_MR; i++)
+				acc[j][i] += pa[LINPACK_MR*k+i]*b[ld*j+k];
+	for (j = 0; j < nr; j++)
+		for (i = 0; i < mr; i++)
+			c[ld*j+i] += acc[j][i];
+#endif
+}
+
+/*----------------------*/
+static void lu_update(int m,int nc,int kb,e_fp *l,e_fp *u,e_fp *c,int lda,e_fp *pack)
+/*
+     c[nc][m] += l[kb][m] * u[nc][kb], all with leading dimension lda.
+     LINPACK_MC rows of l are packed at a time and stay in cache
+     while they are applied to all the columns of c.
+*/
+{
+	int i0,i,j,mc;
+
+	for (i0 = 0; i0 < m; i0 += LINPACK_MC) {
+		mc = (m - i0 < LINPACK_MC) ? m - i0 : LINPACK_MC;
+		lu_pack(mc,kb,l+i0,lda,pack);
+		for (j = 0; j < nc; j += LINPACK_NR) {
+			for (i = 0; i < mc; i += LINPACK_MR) {
+				lu_kernel(kb,pack+kb*i,u+lda*j,c+lda*j+i0+i,lda,
+					(mc - i < LINPACK_MR) ? mc - i : LINPACK_MR,
+					(nc - j < LINPACK_NR) ? nc - j : LINPACK_NR);
+			}
+		}
+	}
+}
+
 /*----------------------*/
 
 static void dgesl(e_fp * RESTRICT a,int lda,int n,e_u16 ipvt[],e_fp * RESTRICT b,int job)
@@ -17,6 +17,8 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #define ZERO FPCONST(0.0)
 #define ONE FPCONST(1.0)
 
+struct linpack_team_s;
+
 typedef struct linpack_params_s {
 	/* Benchmark setup */
 	e_u32 lda; 	//Leading dimension
@@ -44,6 +46,12 @@ typedef struct linpack_params_s {
 
 	e_fp ret_lda,ret_ldaa; /* return value so computation cannot be optimized away */
 	e_fp resid,eps,x0,xn,residn; /* for verification */
+
+	/* Blocked factorization */
+	e_u32 block; 	//Panel width, 0 selects the unblocked dgefa
+	e_fp *pack;	//Packed panel for the trailing update
+	e_u32 threads;	//Threads factoring each matrix, 0 or 1 for the calling thread only
+	struct linpack_team_s *team;	//Threads of this context
 } linpack_params;
 
 /* When adding new data, replace "index" with current NUM_DATAS in generated data,	*
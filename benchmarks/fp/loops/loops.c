@@ -18,8 +18,23 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include "th_math.h" /* for sin, cos and pow */
 #include "th_lib.h"
 #include "th_rand.h" /* initialize a random data vector */
+#include "mith_workload.h"
+#include "al_smp.h"
 #include "loops.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+	((defined(USE_FP32) && USE_FP32) || (defined(USE_FP64) && USE_FP64)) && !defined(LOOPS_NO_SIMD)
+#define LOOPS_X86 1
+#include <immintrin.h>
+#else
+#define LOOPS_X86 0
+#endif
+#if defined(USE_RVV) && USE_RVV && defined(USE_FP32) && USE_FP32 && !defined(LOOPS_NO_SIMD)
+#define LOOPS_RVV 1
+#else
+#define LOOPS_RVV 0
+#endif
+
 static int num_vectors=12;
 static int num_2d_matrixes=9;
 static int num_3d_matrixes=3;
@@ -143,9 +158,83 @@ char *test_type_str[] = {
 	"LAST_TEST_IDX				"
 };
 #endif
+/* kernel names used in reports */
+static const char *kernel_name[] = {
+	"MonteCarlo_integrate",
+	"hydro_fragment",
+	"cholesky",
+	"inner_product",
+	"banded_linear",
+	"tri_diagonal",
+	"linear_recurrence",
+	"state_fragment",
+	"adi_integration",
+	"integrate_predictors",
+	"difference_predictors",
+	"first_sum",
+	"first_dif",
+	"pic_2d",
+	"pic_1d",
+	"casual",
+	"monte_carlo",
+	"implicit",
+	"hydro_2d",
+	"lin_recurrence",
+	"ordinate_transport",
+	"matmul",
+	"planckian",
+	"hydro_2d_implicit",
+	"firstmin"
+};
 
-uint32_t hex(float f) {
-  return *((uint32_t*)(&f));
+/* Isolated kernels.
+	With dataset flag -p<threads> each enabled kernel is a separate task. A task starts from
+	zeroed buffers and its own random stream, seeded from the seed and the kernel index,
+	so kernels do not see data left by the kernels before them, and the result of each kernel
+	does not depend on which thread runs it or in what order.
+	A team of threads owned by the work item runs the tasks of each run, every thread with
+	its own buffers. Tasks are handed out under the team lock, longest kernel first based on
+	the time accumulated in earlier runs.
+*/
+typedef struct loops_team_s loops_team;
+typedef struct loops_worker_s {
+	loops_team *team;
+	loops_params *ctx;	/* buffers of this thread, the work item context for the first one */
+} loops_worker;
+struct loops_team_s {
+	al_mutex_t lock;
+	al_cond_t wake;		/* a job was posted, or the team is shutting down */
+	al_cond_t idle;		/* the last helper left the job */
+	int nthreads;		/* including the thread that posts the job */
+	al_thread_t *threads;
+	loops_worker *workers;
+	e_u32 job;			/* job serial number */
+	int quit;
+	int active;			/* helpers that did not finish the current job yet */
+	/* current job */
+	loops_params *params;	/* receives the results */
+	e_u32 order[LAST_TEST_IDX];
+	e_u32 ntasks;
+	e_u32 next;			/* next task to hand out */
+};
+static loops_team *loops_team_create(loops_params *params);
+static void loops_team_destroy(loops_team *team);
+static void run_isolated(loops_params *params);
+
+/* accumulated kernel timings of all contexts */
+typedef struct loops_stats_s {
+	char name[MITH_MAX_NAME];
+	size_t kernel_ticks[LAST_TEST_IDX];
+	size_t run_ticks;
+	e_u32 runs;
+	al_mutex_t lock;
+} loops_stats;
+
+/* bits of f, for the debug prints in kernel 8 */
+e_u32 hex(float f) {
+  e_u32 u;
+  th_memcpy(&u,&f,sizeof(u));
+  return u;
 }
 
 e_fp *reinit_vec_limited(loops_params *params, e_fp *p, int nvals) {
@@ -289,6 +378,465 @@ static e_fp get_array_feedback(e_fp *a, int maxidx) {
 #endif
 	return ret/(e_fp)maxidx;
 }
+/* Vectorized kernel variants.
+	pic_2d and pic_1d load and update arrays through computed indexes. With dataset flag
+	-V<mask>, a mask of kernels like -x, the kernels in the mask run an explicitly vectorized
+	variant, with gathers for the indexed loads, and for the indexed updates a scatter with
+	conflict detection, so updates of the same element are applied in the original order.
+	All other operations are the same as in the scalar loops and done in the same order,
+	so the results are checked against the same reference. Indexes are converted with 32 bit
+	conversions, like the scalar code as long as the values fit in 31 bits.
+
+	A variant processes whole vectors and returns the number of elements done, the scalar
+	loop of the kernel does the rest.
+
+	Engines, the widest one supported by the processor is used, -E<engine> limits it:
+	1 - avx2, gathers, the indexed updates are done one lane at a time.
+	2 - avx512, needs avx512f, avx512cd and avx512vl. Gathers, and scatters with conflict detection.
+	3 - rvv, pic_1d with indexed loads (USE_RVV, single precision). pic_2d always runs its rvv loop.
+
+	Define LOOPS_NO_SIMD to build the scalar kernels only.
+*/
+#define LOOPS_VEC_NONE		0
+#define LOOPS_VEC_AVX2		1
+#define LOOPS_VEC_AVX512	2
+#define LOOPS_VEC_RVV		3
+static const char *vec_engine_name[] = { "none", "avx2", "avx512", "rvv" };
+
+/* Function: loops_vec_engine
+	Select the engine for the vectorized variants.
+
+	Parameters:
+	limit - widest engine to use, 0 for the widest available
+	kernels - set to the kernels that have a variant with this engine
+*/
+static e_u32 loops_vec_engine(e_u32 limit, e_u32 *kernels) {
+	e_u32 engine=LOOPS_VEC_NONE;
+	*kernels=0;
+#if LOOPS_X86
+	__builtin_cpu_init();
+	if ((limit==0 || limit>=LOOPS_VEC_AVX512) && __builtin_cpu_supports("avx512f") &&
+		__builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512vl"))
+		engine=LOOPS_VEC_AVX512;
+	else if ((limit==0 || limit>=LOOPS_VEC_AVX2) && __builtin_cpu_supports("avx2"))
+		engine=LOOPS_VEC_AVX2;
+	if (engine!=LOOPS_VEC_NONE)
+		*kernels=PIC_2D|PIC_1D;
+#elif LOOPS_RVV
+	engine=LOOPS_VEC_RVV;
+	*kernels=PIC_1D;
+#endif
+	return engine;
+}
+
+/* pic_2d, one repetition: returns the number of particles done */
+#define LOOPS_PIC_2D_BODY { \
+	e_fp *y=p->v[0], *z=p->v[1]; \
+	e_fp *p1r=p->v[2], *p1i=p->v[3]; \
+	e_fp *p2r=p->v[4], *p2i=p->v[5]; \
+	e_u32 *e=p->iv[0], *f=p->iv[1]; \
+	e_fp *b=p->m2[1], *c=p->m2[2], *h=p->m2[3]; \
+	int n=p->N, ip; \
+	vi_t m63=V_SET1I(0x3f), c32=V_SET1I(32); \
+	vf_t one=V_SET1F(FPCONST(1.0)); \
+	for (ip=0; ip+V_N<=n; ip+=V_N) { \
+		vf_t vp1r=V_LOADF(p1r+ip), vp1i=V_LOADF(p1i+ip); \
+		vf_t vp2r=V_LOADF(p2r+ip), vp2i=V_LOADF(p2i+ip); \
+		vi_t i1=V_ANDI(V_CVTT(vp1r),m63), j1=V_ANDI(V_CVTT(vp1i),m63); \
+		vi_t bc=V_ADDI(V_SLLI(j1,6),i1), i2, j2; \
+		vp2r=V_ADDF(vp2r,V_GATHERF(b,bc)); \
+		vp2i=V_ADDF(vp2i,V_GATHERF(c,bc)); \
+		vp1r=V_ADDF(vp1r,vp2r); \
+		vp1i=V_ADDF(vp1i,vp2i); \
+		i2=V_ADDI(V_ANDI(V_CVTT(vp1r),m63),c32); \
+		j2=V_ADDI(V_ANDI(V_CVTT(vp1i),m63),c32); \
+		vp1r=V_ADDF(vp1r,V_GATHERF(y,i2)); \
+		vp1i=V_ADDF(vp1i,V_GATHERF(z,j2)); \
+		V_STOREF(p1r+ip,vp1r); V_STOREF(p1i+ip,vp1i); \
+		V_STOREF(p2r+ip,vp2r); V_STOREF(p2i+ip,vp2i); \
+		i2=V_ADDI(V_SUBI(i2,c32),V_GATHERI(e,i2)); \
+		j2=V_ADDI(V_SUBI(j2,c32),V_GATHERI(f,j2)); \
+		V_SCATTER_ADDF(h,V_ADDI(V_SLLI(j2,6),i2),one); \
+	} \
+	return ip; \
+}
+
+/* pic_1d, one repetition of all three loops: returns the number of particles done.
+	rh is only updated by the last loop, so each vector deposits right away. */
+#define LOOPS_PIC_1D_BODY { \
+	e_fp *vx=p->v[0], *xx=p->v[1]; \
+	e_fp *grd=p->v[2], *xi=p->v[3]; \
+	e_fp *ex=p->v[4], *ex1=p->v[5]; \
+	e_fp *dex=p->v[6], *dex1=p->v[7]; \
+	e_fp *rx=p->v[8], *rh=p->v[9]; \
+	e_u32 *ix=p->iv[0], *ir=p->iv[1]; \
+	int n=p->N, k; \
+	vi_t i1=V_SET1I(1), nmask=V_SET1I(n-1); \
+	vf_t zero=V_SET1F(FPCONST(0.0)), eps=V_SET1F(EE_EPSINI), vflx=V_SET1F(flx); \
+	for (k=0; k+V_N<=n; k+=V_N) { \
+		vf_t g=V_LOADF(grd+k), vxi, vex1, vdex1, vvx, vxx, vrx; \
+		vi_t vix=V_CVTT(g), vir, im1=V_SUBI(vix,i1); \
+		vxi=V_CVTU(vix); \
+		vex1=V_GATHERF(ex,im1); \
+		vdex1=V_GATHERF(dex,im1); \
+		V_STOREI(ix+k,vix); V_STOREF(xi+k,vxi); \
+		V_STOREF(ex1+k,vex1); V_STOREF(dex1+k,vdex1); \
+		V_STOREF(grd+k,V_ADDF(g,eps)); \
+		vvx=V_ADDF(zero,V_ADDF(vex1,V_MULF(V_SUBF(zero,vxi),vdex1))); \
+		vxx=V_ADDF(zero,V_ADDF(vvx,vflx)); \
+		vir=V_CVTT(vxx); \
+		vrx=V_SUBF(vxx,V_CVTU(vir)); \
+		vir=V_ADDI(V_ANDI(vir,nmask),i1); \
+		vxx=V_ADDF(vrx,V_CVTU(vir)); \
+		V_STOREF(vx+k,vvx); V_STOREF(xx+k,vxx); \
+		V_STOREI(ir+k,vir); V_STOREF(rx+k,vrx); \
+		V_DEPOSIT(rh,vir,vrx,ir+k,rx+k); \
+	} \
+	return k; \
+}
+
+#if LOOPS_X86
+/* fp-contract=off: no fused multiply add, the scalar kernels do not use it either */
+#define LOOPS_AVX2 __attribute__((target("avx2"),optimize("fp-contract=off")))
+#define LOOPS_AVX512 __attribute__((target("avx512f,avx512cd,avx512vl"),optimize("fp-contract=off")))
+
+/* avx2 engine, indexed updates one lane at a time in lane order */
+#if USE_FP32
+#define V_N				8
+#define vf_t			__m256
+#define vi_t			__m256i
+#define V_LOADF(a)		_mm256_loadu_ps(a)
+#define V_STOREF(a,x)	_mm256_storeu_ps(a,x)
+#define V_SET1F(x)		_mm256_set1_ps(x)
+#define V_ADDF(x,y)		_mm256_add_ps(x,y)
+#define V_SUBF(x,y)		_mm256_sub_ps(x,y)
+#define V_MULF(x,y)		_mm256_mul_ps(x,y)
+#define V_CVTT(x)		_mm256_cvttps_epi32(x)
+#define V_CVTI(i)		_mm256_cvtepi32_ps(i)
+#define V_GATHERF(a,i)	_mm256_i32gather_ps(a,i,4)
+#define V_STOREI(a,x)	_mm256_storeu_si256((__m256i *)(a),x)
+#define V_SET1I(x)		_mm256_set1_epi32(x)
+#define V_ADDI(x,y)		_mm256_add_epi32(x,y)
+#define V_SUBI(x,y)		_mm256_sub_epi32(x,y)
+#define V_ANDI(x,y)		_mm256_and_si256(x,y)
+#define V_SLLI(x,n)		_mm256_slli_epi32(x,n)
+#define V_SRLI(x,n)		_mm256_srli_epi32(x,n)
+#define V_GATHERI(a,i)	_mm256_i32gather_epi32((const int *)(a),i,4)
+#else
+#define V_N				4
+#define vf_t			__m256d
+#define vi_t			__m128i
+#define V_LOADF(a)		_mm256_loadu_pd(a)
+#define V_STOREF(a,x)	_mm256_storeu_pd(a,x)
+#define V_SET1F(x)		_mm256_set1_pd(x)
+#define V_ADDF(x,y)		_mm256_add_pd(x,y)
+#define V_SUBF(x,y)		_mm256_sub_pd(x,y)
+#define V_MULF(x,y)		_mm256_mul_pd(x,y)
+#define V_CVTT(x)		_mm256_cvttpd_epi32(x)
+#define V_CVTI(i)		_mm256_cvtepi32_pd(i)
+#define V_GATHERF(a,i)	_mm256_i32gather_pd(a,i,8)
+#define V_STOREI(a,x)	_mm_storeu_si128((__m128i *)(a),x)
+#define V_SET1I(x)		_mm_set1_epi32(x)
+#define V_ADDI(x,y)		_mm_add_epi32(x,y)
+#define V_SUBI(x,y)		_mm_sub_epi32(x,y)
+#define V_ANDI(x,y)		_mm_and_si128(x,y)
+#define V_SLLI(x,n)		_mm_slli_epi32(x,n)
+#define V_SRLI(x,n)		_mm_srli_epi32(x,n)
+#define V_GATHERI(a,i)	_mm_i32gather_epi32((const int *)(a),i,4)
+#endif
+/* unsigned to fp from the two 16 bit halves, both exact, so the sum is rounded once */
+#define V_CVTU(i)		V_ADDF(V_MULF(V_CVTI(V_SRLI(i,16)),V_SET1F(FPCONST(65536.0))), \
+							V_CVTI(V_ANDI(i,V_SET1I(0xffff))))
+#define V_SCATTER_ADDF(a,i,x)	scatter_add_avx2(a,i,x)
+#define V_DEPOSIT(rh,vir,vrx,pir,prx) { \
+	int j; \
+	for (j=0; j<V_N; j++) { \
+		rh[(pir)[j]-1] += FPCONST(1.0) - (prx)[j]; \
+		rh[(pir)[j]  ] += (prx)[j]; \
+	} \
+}
+LOOPS_AVX2 static inline void scatter_add_avx2(e_fp *a, vi_t i, vf_t x) {
+	e_u32 idx[V_N];
+	e_fp val[V_N];
+	int j;
+	V_STOREI(idx,i);
+	V_STOREF(val,x);
+	for (j=0; j<V_N; j++)
+		a[idx[j]]+=val[j];
+}
+LOOPS_AVX2 static int pic_2d_avx2(loops_params *p) LOOPS_PIC_2D_BODY
+LOOPS_AVX2 static int pic_1d_avx2(loops_params *p, e_fp flx) LOOPS_PIC_1D_BODY
+#undef V_N
+#undef vf_t
+#undef vi_t
+#undef V_LOADF
+#undef V_STOREF
+#undef V_SET1F
+#undef V_ADDF
+#undef V_SUBF
+#undef V_MULF
+#undef V_CVTT
+#undef V_CVTI
+#undef V_CVTU
+#undef V_GATHERF
+#undef V_STOREI
+#undef V_SET1I
+#undef V_ADDI
+#undef V_SUBI
+#undef V_ANDI
+#undef V_SLLI
+#undef V_SRLI
+#undef V_GATHERI
+#undef V_SCATTER_ADDF
+#undef V_DEPOSIT
+
+/* avx512 engine, for the indexed updates the lanes whose index is not in an earlier lane
+	(vpconflictd) are updated with one gather and scatter, the other lanes after them one at
+	a time in lane order. One pass per conflict would be exact too, but pic_2d starts with all
+	particles in the same cell and such passes are slower than the scalar loop. */
+#if USE_FP32
+#define V_N				16
+#define vf_t			__m512
+#define vi_t			__m512i
+#define vm_t			__mmask16
+#define V_LOADF(a)		_mm512_loadu_ps(a)
+#define V_STOREF(a,x)	_mm512_storeu_ps(a,x)
+#define V_SET1F(x)		_mm512_set1_ps(x)
+#define V_ADDF(x,y)		_mm512_add_ps(x,y)
+#define V_SUBF(x,y)		_mm512_sub_ps(x,y)
+#define V_MULF(x,y)		_mm512_mul_ps(x,y)
+#define V_CVTT(x)		_mm512_cvttps_epi32(x)
+#define V_CVTU(i)		_mm512_cvtepu32_ps(i)
+#define V_GATHERF(a,i)	_mm512_i32gather_ps(i,a,4)
+#define V_MGATHERF(m,a,i,x)	_mm512_mask_i32gather_ps(x,m,i,a,4)
+#define V_MSCATTERF(m,a,i,x)	_mm512_mask_i32scatter_ps(a,m,i,x,4)
+#define V_STOREI(a,x)	_mm512_storeu_si512((void *)(a),x)
+#define V_SET1I(x)		_mm512_set1_epi32(x)
+#define V_ADDI(x,y)		_mm512_add_epi32(x,y)
+#define V_SUBI(x,y)		_mm512_sub_epi32(x,y)
+#define V_ANDI(x,y)		_mm512_and_si512(x,y)
+#define V_SLLI(x,n)		_mm512_slli_epi32(x,n)
+#define V_GATHERI(a,i)	_mm512_i32gather_epi32(i,a,4)
+#define V_CONFLICT(i)	_mm512_conflict_epi32(i)
+#define V_READY(m,c)	_mm512_mask_testn_epi32_mask(m,c,_mm512_set1_epi32(m))
+/* element k of the first vector and element k of the second one, alternating */
+#define V_ZIPLOI(x,y)	_mm512_permutex2var_epi32(x,_mm512_setr_epi32(0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23),y)
+#define V_ZIPHII(x,y)	_mm512_permutex2var_epi32(x,_mm512_setr_epi32(8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31),y)
+#define V_ZIPLOF(x,y)	_mm512_permutex2var_ps(x,_mm512_setr_epi32(0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23),y)
+#define V_ZIPHIF(x,y)	_mm512_permutex2var_ps(x,_mm512_setr_epi32(8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31),y)
+#else
+#define V_N				8
+#define vf_t			__m512d
+#define vi_t			__m256i
+#define vm_t			__mmask8
+#define V_LOADF(a)		_mm512_loadu_pd(a)
+#define V_STOREF(a,x)	_mm512_storeu_pd(a,x)
+#define V_SET1F(x)		_mm512_set1_pd(x)
+#define V_ADDF(x,y)		_mm512_add_pd(x,y)
+#define V_SUBF(x,y)		_mm512_sub_pd(x,y)
+#define V_MULF(x,y)		_mm512_mul_pd(x,y)
+#define V_CVTT(x)		_mm512_cvttpd_epi32(x)
+#define V_CVTU(i)		_mm512_cvtepu32_pd(i)
+#define V_GATHERF(a,i)	_mm512_i32gather_pd(i,a,8)
+#define V_MGATHERF(m,a,i,x)	_mm512_mask_i32gather_pd(x,m,i,a,8)
+#define V_MSCATTERF(m,a,i,x)	_mm512_mask_i32scatter_pd(a,m,i,x,8)
+#define V_STOREI(a,x)	_mm256_storeu_si256((__m256i *)(a),x)
+#define V_SET1I(x)		_mm256_set1_epi32(x)
+#define V_ADDI(x,y)		_mm256_add_epi32(x,y)
+#define V_SUBI(x,y)		_mm256_sub_epi32(x,y)
+#define V_ANDI(x,y)		_mm256_and_si256(x,y)
+#define V_SLLI(x,n)		_mm256_slli_epi32(x,n)
+#define V_GATHERI(a,i)	_mm256_i32gather_epi32((const int *)(a),i,4)
+#define V_CONFLICT(i)	_mm256_conflict_epi32(i)
+#define V_READY(m,c)	_mm256_mask_testn_epi32_mask(m,c,_mm256_set1_epi32(m))
+/* element k of the first vector and element k of the second one, alternating */
+#define V_ZIPLOI(x,y)	_mm256_permutex2var_epi32(x,_mm256_setr_epi32(0,8,1,9,2,10,3,11),y)
+#define V_ZIPHII(x,y)	_mm256_permutex2var_epi32(x,_mm256_setr_epi32(4,12,5,13,6,14,7,15),y)
+#define V_ZIPLOF(x,y)	_mm512_permutex2var_pd(x,_mm512_setr_epi64(0,8,1,9,2,10,3,11),y)
+#define V_ZIPHIF(x,y)	_mm512_permutex2var_pd(x,_mm512_setr_epi64(4,12,5,13,6,14,7,15),y)
+#endif
+#define V_SCATTER_ADDF(a,i,x)	scatter_add_avx512(a,i,x)
+/* rh[ir-1] and rh[ir] of each element, in element order */
+#define V_DEPOSIT(rh,vir,vrx,pir,prx) { \
+	vi_t irm1=V_SUBI(vir,V_SET1I(1)); \
+	vf_t rxm1=V_SUBF(V_SET1F(FPCONST(1.0)),vrx); \
+	scatter_add_avx512(rh,V_ZIPLOI(irm1,vir),V_ZIPLOF(rxm1,vrx)); \
+	scatter_add_avx512(rh,V_ZIPHII(irm1,vir),V_ZIPHIF(rxm1,vrx)); \
+}
+LOOPS_AVX512 static inline void scatter_add_avx512(e_fp *a, vi_t i, vf_t x) {
+	vi_t conf=V_CONFLICT(i);	/* lanes before each lane with the same index */
+	vm_t todo=(vm_t)~0, ready;
+	e_u32 idx[V_N];
+	e_fp val[V_N];
+	int j;
+	ready=V_READY(todo,conf);
+	V_MSCATTERF(ready,a,i,V_ADDF(V_MGATHERF(ready,a,i,x),x));
+	todo&=~ready;
+	/* the rest, one lane at a time */
+	if (todo) {
+		V_STOREI(idx,i);
+		V_STOREF(val,x);
+		for (j=0; j<V_N; j++)
+			if (todo & (1<<j))
+				a[idx[j]]+=val[j];
+	}
+}
+LOOPS_AVX512 static int pic_2d_avx512(loops_params *p) LOOPS_PIC_2D_BODY
+LOOPS_AVX512 static int pic_1d_avx512(loops_params *p, e_fp flx) LOOPS_PIC_1D_BODY
+#undef V_N
+#undef vf_t
+#undef vi_t
+#undef vm_t
+#undef V_LOADF
+#undef V_STOREF
+#undef V_SET1F
+#undef V_ADDF
+#undef V_SUBF
+#undef V_MULF
+#undef V_CVTT
+#undef V_CVTU
+#undef V_GATHERF
+#undef V_MGATHERF
+#undef V_MSCATTERF
+#undef V_STOREI
+#undef V_SET1I
+#undef V_ADDI
+#undef V_SUBI
+#undef V_ANDI
+#undef V_SLLI
+#undef V_GATHERI
+#undef V_CONFLICT
+#undef V_READY
+#undef V_ZIPLOI
+#undef V_ZIPHII
+#undef V_ZIPLOF
+#undef V_ZIPHIF
+#undef V_SCATTER_ADDF
+#undef V_DEPOSIT
+#endif /* LOOPS_X86 */
+
+#if LOOPS_RVV
+/* rvv engine, pic_1d loops 1 and 2 with indexed loads, the deposit stays in element order */
+static int pic_1d_rvv(loops_params *p, e_fp flx) {
+	e_fp *vx=p->v[0], *xx=p->v[1];
+	e_fp *grd=p->v[2], *xi=p->v[3];
+	e_fp *ex=p->v[4], *ex1=p->v[5];
+	e_fp *dex=p->v[6], *dex1=p->v[7];
+	e_fp *rx=p->v[8], *rh=p->v[9];
+	e_u32 *ix=p->iv[0], *ir=p->iv[1];
+	int n=p->N, k;
+	size_t vl;
+	for (k=0; k<n; k+=vl) {
+		vl = __riscv_vsetvl_e32m2(n - k);
+		vfloat32m2_t zero = __riscv_vfmv_v_f_f32m2(0.0f, vl);
+		vfloat32m2_t g = __riscv_vle32_v_f32m2(&grd[k], vl);
+		vuint32m2_t vix = __riscv_vreinterpret_v_i32m2_u32m2(__riscv_vfcvt_rtz_x_f_v_i32m2(g, vl));
+		vfloat32m2_t vxi = __riscv_vfcvt_f_xu_v_f32m2(vix, vl);
+		/* byte offsets of ix-1 */
+		vuint32m2_t offs = __riscv_vsll_vx_u32m2(__riscv_vsub_vx_u32m2(vix, 1, vl), 2, vl);
+		vfloat32m2_t vex1 = __riscv_vluxei32_v_f32m2(ex, offs, vl);
+		vfloat32m2_t vdex1 = __riscv_vluxei32_v_f32m2(dex, offs, vl);
+		__riscv_vse32_v_u32m2(&ix[k], vix, vl);
+		__riscv_vse32_v_f32m2(&xi[k], vxi, vl);
+		__riscv_vse32_v_f32m2(&ex1[k], vex1, vl);
+		__riscv_vse32_v_f32m2(&dex1[k], vdex1, vl);
+		__riscv_vse32_v_f32m2(&grd[k], __riscv_vfadd_vf_f32m2(g, EE_EPSINI, vl), vl);
+
+		vfloat32m2_t vvx = __riscv_vfmul_vv_f32m2(__riscv_vfsub_vv_f32m2(zero, vxi, vl), vdex1, vl);
+		vvx = __riscv_vfadd_vv_f32m2(zero, __riscv_vfadd_vv_f32m2(vex1, vvx, vl), vl);
+		vfloat32m2_t vxx = __riscv_vfadd_vv_f32m2(zero, __riscv_vfadd_vf_f32m2(vvx, flx, vl), vl);
+		vuint32m2_t vir = __riscv_vreinterpret_v_i32m2_u32m2(__riscv_vfcvt_rtz_x_f_v_i32m2(vxx, vl));
+		vfloat32m2_t vrx = __riscv_vfsub_vv_f32m2(vxx, __riscv_vfcvt_f_xu_v_f32m2(vir, vl), vl);
+		vir = __riscv_vadd_vx_u32m2(__riscv_vand_vx_u32m2(vir, n - 1, vl), 1, vl);
+		vxx = __riscv_vfadd_vv_f32m2(vrx, __riscv_vfcvt_f_xu_v_f32m2(vir, vl), vl);
+		__riscv_vse32_v_f32m2(&vx[k], vvx, vl);
+		__riscv_vse32_v_f32m2(&xx[k], vxx, vl);
+		__riscv_vse32_v_u32m2(&ir[k], vir, vl);
+		__riscv_vse32_v_f32m2(&rx[k], vrx, vl);
+	}
+	/* elements of a vector may update the same rh element */
+	for (k=0; k<n; k++) {
+		rh[ ir[k]-1 ] += FPCONST(1.0) - rx[k];
+		rh[ ir[k]   ] += rx[k];
+	}
+	return n;
+}
+#endif /* LOOPS_RVV */
+
+/* Function: pic_2d_vec
+	Run the vectorized variant of one pic_2d repetition with the selected engine.
+	Returns the number of particles done.
+*/
+static int pic_2d_vec(loops_params *p) {
+	switch (p->vengine) {
+#if LOOPS_X86
+		case LOOPS_VEC_AVX512:	return pic_2d_avx512(p);
+		case LOOPS_VEC_AVX2:	return pic_2d_avx2(p);
+#endif
+		default:				return 0;
+	}
+}
+/* Function: pic_1d_vec
+	Run the vectorized variant of one pic_1d repetition with the selected engine.
+	Returns the number of particles done.
+*/
+static int pic_1d_vec(loops_params *p, e_fp flx) {
+	switch (p->vengine) {
+#if LOOPS_X86
+		case LOOPS_VEC_AVX512:	return pic_1d_avx512(p,flx);
+		case LOOPS_VEC_AVX2:	return pic_1d_avx2(p,flx);
+#elif LOOPS_RVV
+		case LOOPS_VEC_RVV:		return pic_1d_rvv(p,flx);
+#endif
+		default:				return 0;
+	}
+}
+/* Function: kernel_work
+	Approximate work of one call of a kernel, derived from nsize and nruns.
+
+	Flops count the additions, multiplications, divisions, square roots and exponentials in the
+	repeated loops, compares and conversions are not counted. Bytes count the array elements
+	read and the elements written during one repetition once each, as if nothing stayed in the
+	caches between repetitions. Setup before the repeated loops and reads of the random banks
+	are not counted. Data dependent kernels (monte_carlo, implicit) use the longest common path.
+*/
+static void kernel_work(loops_params *p, e_u32 test_num, e_f64 *flops, e_f64 *bytes) {
+	e_f64 n=(e_f64)p->nsize[test_num];
+	e_f64 loop=(e_f64)p->nruns[test_num];
+	e_f64 fe=(e_f64)sizeof(e_fp), ie=(e_f64)sizeof(e_u32);
+	e_f64 f=0.0, b=0.0;
+
+	switch (test_num) {
+		case MONTE_CARLO_PI_IDX:		f=3*n;		b=4*n*fe;	break;
+		case HYDRO_IDX:					f=6*n;		b=5*n*fe;	break;
+		case CHOLESKY_IDX:				f=2*n;		b=2.5*n*fe;	break; /* n/2 updates over all levels */
+		case INNER_PRODUCT_IDX:			f=2*n;		b=2*n*fe;	break;
+		case BANDED_LINEAR_IDX:			f=1.2*n;	b=0.8*n*fe;	break; /* 3 bands of n/5 */
+		case TRI_DIAGONAL_IDX:			f=2*n;		b=3*n*fe;	break;
+		case LINEAR_RECURRENCE_IDX:		f=n*n/2;	b=(n*n/2+2*n)*fe;	break;
+		case STATE_FRAGMENT_IDX:		f=17*n;		b=6*n*fe;	break;
+		case ADI_INTEGRATION_IDX:		f=81*n;		b=33*n*fe;	break;
+		case INTEGRATE_PREDICTORS_IDX:	f=18*n;		b=13*n*fe;	break;
+		case DIFFERENCE_PREDICTORS_IDX:	f=9*n;		b=21*n*fe;	break;
+		case FIRST_SUM_IDX:				f=n;		b=3*n*fe;	break;
+		case FIRST_DIF_IDX:				f=2*n;		b=4*n*fe;	loop+=1;	break;
+		case PIC_2D_IDX:				f=7*n;		b=14*n*fe+2*n*ie;	break;
+		case PIC_1D_IDX:				f=12*n;		b=20*n*fe+4*n*ie;	break;
+		case CASUAL_IDX:				f=74*n;		b=67*n*fe;	break;
+		case MONTE_CARLO_IDX:			f=n;		b=(2*n*(n+1)+2*n)*ie;	break; /* zone is reinitialized each repetition */
+		case IMPLICIT_IDX:				f=9*n;		b=8*n*fe;	break;
+		case HYDRO_2D_IDX:				f=232*n;	b=75*n*fe;	break; /* 5 rows of n */
+		case LIN_RECURRENCE_IDX:		f=6*n;		b=4*n*fe;	break;
+		case ORDINATE_TRANSPORT_IDX:	f=14*n;		b=10*n*fe;	break;
+		case MATMUL_IDX:				f=1250*n;	b=(75*n+625)*fe;	break; /* 25x25 by 25xn */
+		case PLANCKIAN_IDX:				f=5*n;		b=8*n*fe;	break;
+		case HYDRO_2D_IMPLICIT_IDX:		f=60*n;		b=35*n*fe;	break; /* 5 rows of n */
+		case FIRSTMIN_IDX:				f=0;		b=2*n*fe;	break;
+		default:						break;
+	}
+	*flops=f*loop;
+	*bytes=b*loop;
+}
 /* Benchmark */
 void *define_params_loops(unsigned int idx, char *name, char *dataset) {
     loops_params *params;
@@ -340,6 +888,36 @@ void *define_params_loops(unsigned int idx, char *name, char *dataset) {
 		th_parse_buf_flag_unsigned(dataset,"-b",&req_bits);
 		th_parse_buf_flag_unsigned(dataset,"-r",&params->rtype);
 		th_parse_buf_flag_unsigned(dataset,"-INT",&params->limit_int_input);
+		th_parse_buf_flag_unsigned(dataset,"-p",&params->threads);
+		th_parse_buf_flag(dataset,"-k",&params->kernel_stats);
+		th_parse_buf_flag_unsigned(dataset,"-V",&params->vtests);
+		th_parse_buf_flag_unsigned(dataset,"-E",&params->vengine);
+	}
+	/* vectorized variants */
+	if (params->vtests) {
+		e_u32 vkernels;
+		char logbuf[128];
+		params->vengine=loops_vec_engine(params->vengine,&vkernels);
+		params->vtests&=vkernels;
+		th_sprintf(logbuf,"loops: %s engine, vectorized kernels mask 0x%x\n",
+			vec_engine_name[params->vengine],params->vtests);
+		th_log(TH_INFO,logbuf);
+	}
+#if USE_SINGLE_CONTEXT
+	if (params->threads>1)
+		params->threads=1;
+#endif
+	/* isolated kernels have their own reference */
+	if (params->threads)
+		params->ref_data=params->ref_iso_data;
+	params->team=NULL;
+	params->stats=NULL;
+	if (params->kernel_stats) {
+		params->stats=(loops_stats *)th_calloc(1,sizeof(loops_stats));
+		if (params->stats==NULL)
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+		th_strncpy(params->stats->name,name,MITH_MAX_NAME-1);
+		al_mutex_init(&params->stats->lock);
 	}
 	/* generic inits */
 	{
@@ -418,6 +996,42 @@ void *define_params_loops(unsigned int idx, char *name, char *dataset) {
 
 int bmark_clean_loops(void *in_params) {
 	loops_params *params=(loops_params *)in_params;
+	if (params->stats!=NULL) {
+		loops_stats *st=params->stats;
+		int i;
+		if (st->runs>0) {
+			size_t sum=0;
+			e_f64 flops, bytes, secs, tflops=0.0, tbytes=0.0;
+			for (i=0; i<LAST_TEST_IDX; i++) {
+				if ((params->tests & ((e_u32)1<<i))==0)
+					continue;
+				secs=(double)st->kernel_ticks[i]/(double)th_ticks_per_sec();
+				kernel_work(params,i,&flops,&bytes);
+				flops*=st->runs;
+				bytes*=st->runs;
+				th_printf("-- %s:%s(secs/run)=%8g\n",st->name,kernel_name[i],secs/(double)st->runs);
+				if (bytes>0.0)
+					th_printf("-- %s:%s(flops/byte)=%8g\n",st->name,kernel_name[i],flops/bytes);
+				if (secs>0.0) {
+					th_printf("-- %s:%s(GFLOP/s)=%8g\n",st->name,kernel_name[i],flops/secs*1e-9);
+					th_printf("-- %s:%s(GB/s)=%8g\n",st->name,kernel_name[i],bytes/secs*1e-9);
+				}
+				sum+=st->kernel_ticks[i];
+				tflops+=flops;
+				tbytes+=bytes;
+			}
+			secs=(double)sum/(double)th_ticks_per_sec();
+			th_printf("-- %s:kernels(secs/run)=%8g\n",st->name,secs/(double)st->runs);
+			if (secs>0.0) {
+				th_printf("-- %s:kernels(GFLOP/s)=%8g\n",st->name,tflops/secs*1e-9);
+				th_printf("-- %s:kernels(GB/s)=%8g\n",st->name,tbytes/secs*1e-9);
+			}
+			th_printf("-- %s:run(secs/run)=%8g\n",st->name,
+				(double)st->run_ticks/(double)th_ticks_per_sec()/(double)st->runs);
+		}
+		al_mutex_destroy(&st->lock);
+		th_free(st);
+	}
 	if (params->irbank)
 		th_free(params->irbank);
 	if (params->rbank)
@@ -467,52 +1081,84 @@ void dump_sparse_data(loops_params *p) {
 	}
 }
 
-void *bmark_init_loops(void *in_params) {
-	/* Create a params for this invocation */
+/* working buffers of a context, also used by the threads of a team */
+static void alloc_buffers(loops_params *p) {
 	int i;
-	loops_params *params=(loops_params *)in_params;
-    loops_params *myparams;
-
-	if (in_params==NULL)
-		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
-	myparams=(loops_params *)th_calloc(1,sizeof(loops_params));
-	if ( myparams == NULL )
-        th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
-	th_memcpy(myparams,params,sizeof(loops_params));
-	/* Allocate working buffers */
 	/* livermor has sizes 1001,101,2048,300 in space1 vectors */
-	myparams->v=(e_fp **)th_malloc(sizeof(e_fp *)*num_vectors);
+	p->v=(e_fp **)th_malloc(sizeof(e_fp *)*num_vectors);
 	for (i=0; i<num_vectors; i++) {
 		int spacer;
 		if (i<4) spacer=10;
 		else spacer=0;
-		myparams->v[i]=(e_fp *)th_malloc(sizeof(e_fp)*(myparams->vsize+spacer));
-		if ( myparams->v[i] == NULL )
+		p->v[i]=(e_fp *)th_malloc(sizeof(e_fp)*(p->vsize+spacer));
+		if ( p->v[i] == NULL )
 			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	}
-	myparams->iv=(e_u32 **)th_malloc(sizeof(e_u32 *)*num_vectors);
+	p->iv=(e_u32 **)th_malloc(sizeof(e_u32 *)*num_vectors);
 	for (i=0; i<num_vectors; i++) {
-		myparams->iv[i]=(e_u32 *)th_malloc(sizeof(e_u32)*myparams->ivsize);
-		if ( myparams->iv[i] == NULL )
+		p->iv[i]=(e_u32 *)th_malloc(sizeof(e_u32)*p->ivsize);
+		if ( p->iv[i] == NULL )
 			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	}
-	myparams->v2=(e_fp *)th_calloc(1,sizeof(e_fp)*(LAST_TEST_IDX+1));
-	if ( myparams->v2 == NULL )
-		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
-
-	myparams->m2=(e_fp **)th_malloc(sizeof(e_fp *)*num_2d_matrixes);
+	p->m2=(e_fp **)th_malloc(sizeof(e_fp *)*num_2d_matrixes);
 	for (i=0; i<num_2d_matrixes; i++) {
-		myparams->m2[i]=(e_fp *)th_malloc(sizeof(e_fp)*myparams->m2size);
-		if ( myparams->m2[i] == NULL )
+		p->m2[i]=(e_fp *)th_malloc(sizeof(e_fp)*p->m2size);
+		if ( p->m2[i] == NULL )
 			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	}
-	myparams->m3=(e_fp **)th_malloc(sizeof(e_fp *)*num_3d_matrixes);
+	p->m3=(e_fp **)th_malloc(sizeof(e_fp *)*num_3d_matrixes);
 	for (i=0; i<num_3d_matrixes; i++) {
-		myparams->m3[i]=(e_fp *)th_malloc(sizeof(e_fp)*myparams->m3size);
-		if ( myparams->m3[i] == NULL )
+		p->m3[i]=(e_fp *)th_malloc(sizeof(e_fp)*p->m3size);
+		if ( p->m3[i] == NULL )
 			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	}
-	reset_all_data(myparams);
+	reset_all_data(p);
+}
+static void free_buffers(loops_params *p) {
+	int i;
+	if (p->v) {
+	for (i=0; i<num_vectors; i++)
+		th_free(p->v[i]);
+	th_free(p->v);
+	}
+	if (p->iv) {
+	for (i=0; i<num_vectors; i++)
+		th_free(p->iv[i]);
+	th_free(p->iv);
+	}
+	if (p->m2) {
+	for (i=0; i<num_2d_matrixes; i++)
+		th_free(p->m2[i]);
+	th_free(p->m2);
+	}
+	if (p->m3) {
+	for (i=0; i<num_3d_matrixes; i++)
+		th_free(p->m3[i]);
+	th_free(p->m3);
+	}
+}
+
+void *bmark_init_loops(void *in_params) {
+	/* Create a params for this invocation */
+	loops_params *params=(loops_params *)in_params;
+    loops_params *myparams;
+
+	if (in_params==NULL)
+		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
+	myparams=(loops_params *)th_calloc(1,sizeof(loops_params));
+	if ( myparams == NULL )
+        th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	th_memcpy(myparams,params,sizeof(loops_params));
+	/* Allocate working buffers */
+	alloc_buffers(myparams);
+	myparams->v2=(e_fp *)th_calloc(1,sizeof(e_fp)*(LAST_TEST_IDX+1));
+	if ( myparams->v2 == NULL )
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	th_memset(myparams->kernel_ticks,0,sizeof(myparams->kernel_ticks));
+	myparams->run_ticks=0;
+	myparams->runs=0;
+	if (myparams->threads>1)
+		myparams->team=loops_team_create(myparams);
 
 	return myparams;
 }
@@ -524,31 +1170,22 @@ void *bmark_fini_loops(void *in_params) {
 	if (in_params==NULL)
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
 	myparams=(loops_params *)in_params;
-	/* Cleanup working buffers */
-	if (myparams->v) {
-	for (i=0; i<num_vectors; i++)
-		th_free(myparams->v[i]);
-	th_free(myparams->v);
+	if (myparams->stats!=NULL && myparams->runs>0) {
+		loops_stats *st=myparams->stats;
+		al_mutex_lock(&st->lock);
+		for (i=0; i<LAST_TEST_IDX; i++)
+			st->kernel_ticks[i]+=myparams->kernel_ticks[i];
+		st->run_ticks+=myparams->run_ticks;
+		st->runs+=myparams->runs;
+		al_mutex_unlock(&st->lock);
 	}
+	if (myparams->team!=NULL)
+		loops_team_destroy(myparams->team);
+	/* Cleanup working buffers */
+	free_buffers(myparams);
 	if (myparams->v2) {
 		th_free(myparams->v2);
 	}
-	if (myparams->iv) {
-	for (i=0; i<num_vectors; i++)
-		th_free(myparams->iv[i]);
-	th_free(myparams->iv);
-	}
-	if (myparams->m2) {
-	for (i=0; i<num_2d_matrixes; i++)
-		th_free(myparams->m2[i]);
-	th_free(myparams->m2);
-	}
-	if (myparams->m3) {
-	for (i=0; i<num_3d_matrixes; i++)
-		th_free(myparams->m3[i]);
-	th_free(myparams->m3);
-	}
-
 	th_free(myparams);
 
 	return NULL;
@@ -560,31 +1197,44 @@ void *t_run_test_loops(struct TCDef *tcdef,void *in_params) {
 	e_u32 next_test=1;
 	e_u32 test_num=0;
 	e_u32 test;
+	size_t start, run_start;
 	//test_type run_test;
 
 	tcdef->CRC=0;
-	params->r=rand_init(params->seed,256,-1e10,1e10);
-	while (test_num<LAST_TEST_IDX) {
-		e_fp retval;
-		while ((next_test & params->tests) == 0) {
+	run_start=th_signal_now();
+	if (params->threads) {
+		run_isolated(params);
+		for (test_num=0; test_num<LAST_TEST_IDX; test_num++)
+			if (params->tests & ((e_u32)1<<test_num))
+				val+=params->v2[test_num];
+	} else {
+		params->r=rand_init(params->seed,256,-1e10,1e10);
+		while (test_num<LAST_TEST_IDX) {
+			e_fp retval;
+			while ((next_test & params->tests) == 0) {
+				next_test<<=1;
+				test_num++;
+				if (test_num>=LAST_TEST_IDX) break;
+			}
+			if (all_tests[test_num]==NULL)
+				break;
+#if VERBOSE
+			th_printf("Running %s\n",test_type_str[test_num]);
+#endif
+			params->N=params->nsize[test_num];
+			params->Loop=params->nruns[test_num];
+			start=th_signal_now();
+			retval=all_tests[test_num](params);
+			params->kernel_ticks[test_num]+=th_signal_now()-start;
+			params->v2[test_num]=retval;
+			val+=retval;
 			next_test<<=1;
 			test_num++;
-			if (test_num>=LAST_TEST_IDX) break;
 		}
-		if (all_tests[test_num]==NULL)
-			break;
-#if VERBOSE
-		th_printf("Running %s\n",test_type_str[test_num]);
-#endif
-		params->N=params->nsize[test_num];
-		params->Loop=params->nruns[test_num];
-		retval=all_tests[test_num](params);
-		params->v2[test_num]=retval;
-		val+=retval;
-		next_test<<=1;
-		test_num++;
+		rand_fini(params->r);
 	}
-	rand_fini(params->r);
+	params->run_ticks+=th_signal_now()-run_start;
+	params->runs++;
 	params->v2[LAST_TEST_IDX]=val;
 	params->val=val;
 
@@ -612,7 +1262,20 @@ int bmark_verify_loops(void *in_params) {
 	int ret=1;
 	loops_params *params=(loops_params *)in_params;
 
-	if (params->gen_ref) {
+	if (params->gen_ref && params->threads) {
+		int i;
+		th_printf("/**** START ISOLATED REFERENCE ****/\n");
+		th_printf("static intparts ref_iso_data_index[]={\n");
+		for (i=0; i<LAST_TEST_IDX+1; i++) {
+			th_printf("\t");
+			th_print_fp(params->v2[i]);
+			if (i<LAST_TEST_IDX)
+				th_printf(",\n");
+		}
+		th_printf("\n}; /* ref_iso_data */\n\n");
+		th_printf("presets_loops[index].ref_iso_data=ref_iso_data_index;\n");
+		th_printf("/**** END ISOLATED REFERENCE ****/\n");
+	} else if (params->gen_ref) {
 		int i;
 		th_printf("/**** START DATASET ****/\n#include \"th_lib.h\"\n#include \"../loops.h\"\n");
 		th_printf("static intparts ref_data_index[]={\n");
@@ -653,6 +1316,170 @@ int bmark_verify_loops(void *in_params) {
 	return ret;
 }
 
+/*----------------------*/
+static void run_task(loops_params *ctx,loops_params *params,e_u32 test_num)
+/*
+     run kernel test_num isolated on the buffers of ctx,
+     the result and the time go to params.
+*/
+{
+	size_t start;
+
+	reset_all_data(ctx);
+	ctx->r=rand_init(params->seed+test_num,256,-1e10,1e10);
+	ctx->N=params->nsize[test_num];
+	ctx->Loop=params->nruns[test_num];
+	start=th_signal_now();
+	params->v2[test_num]=all_tests[test_num](ctx);
+	params->kernel_ticks[test_num]+=th_signal_now()-start;
+	rand_fini(ctx->r);
+}
+
+/*----------------------*/
+static void loops_tasks(loops_team *t,loops_params *ctx)
+/*
+     run tasks of the current job until all of them are handed out.
+     called and returns with the team lock held.
+*/
+{
+	e_u32 test_num;
+
+	while (t->next < t->ntasks) {
+		test_num = t->order[t->next++];
+		al_mutex_unlock(&t->lock);
+		run_task(ctx,t->params,test_num);
+		al_mutex_lock(&t->lock);
+	}
+}
+
+/*----------------------*/
+static void *loops_helper(void *arg)
+/* thread of the team, runs tasks of each job posted by run_isolated */
+{
+	loops_worker *w=(loops_worker *)arg;
+	loops_team *t=w->team;
+	e_u32 job=0;
+
+	al_mutex_lock(&t->lock);
+	for (;;) {
+		while (!t->quit && t->job == job)
+			al_cond_wait(&t->wake,&t->lock);
+		if (t->quit)
+			break;
+		job = t->job;
+		loops_tasks(t,w->ctx);
+		if (--t->active == 0)
+			al_cond_signal(&t->idle);
+	}
+	al_mutex_unlock(&t->lock);
+	return NULL;
+}
+
+/*----------------------*/
+static void run_isolated(loops_params *params)
+/*
+     run all enabled kernels as isolated tasks, on the team of the
+     context if it has one. v2 gets the result of each kernel.
+*/
+{
+	loops_team *t=params->team;
+	e_u32 order[LAST_TEST_IDX];
+	e_u32 i,j,n=0;
+
+	/* longest kernels first, so a slow one does not start last */
+	for (i = 0; i < LAST_TEST_IDX; i++) {
+		if ((params->tests & ((e_u32)1<<i)) == 0)
+			continue;
+		for (j = n; j > 0 && params->kernel_ticks[order[j-1]] < params->kernel_ticks[i]; j--)
+			order[j] = order[j-1];
+		order[j] = i;
+		n++;
+	}
+	if (t == NULL) {
+		for (i = 0; i < n; i++)
+			run_task(params,params,order[i]);
+		return;
+	}
+	al_mutex_lock(&t->lock);
+	th_memcpy(t->order,order,sizeof(order));
+	t->ntasks = n;
+	t->next = 0;
+	t->params = params;
+	t->active = t->nthreads - 1;
+	t->job++;
+	al_cond_broadcast(&t->wake);
+	loops_tasks(t,params);
+	while (t->active > 0)
+		al_cond_wait(&t->idle,&t->lock);
+	al_mutex_unlock(&t->lock);
+}
+
+/*----------------------*/
+static loops_team *loops_team_create(loops_params *params)
+/*
+     create a team of params->threads, the thread of the context and
+     params->threads-1 helpers, each helper with its own buffers.
+*/
+{
+	loops_team *t;
+	mith_textend tex;
+	int i,nthreads=params->threads;
+
+	t=(loops_team *)th_calloc(1,sizeof(loops_team));
+	if (t == NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	t->nthreads = nthreads;
+	t->threads = (al_thread_t *)th_malloc(sizeof(al_thread_t)*nthreads);
+	t->workers = (loops_worker *)th_malloc(sizeof(loops_worker)*nthreads);
+	if (t->threads == NULL || t->workers == NULL)
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	al_mutex_init(&t->lock);
+	al_cond_init(&t->wake);
+	al_cond_init(&t->idle);
+	t->workers[0].team = t;
+	t->workers[0].ctx = params;
+	for (i = 1; i < nthreads; i++) {
+		loops_params *ctx=(loops_params *)th_malloc(sizeof(loops_params));
+		if (ctx == NULL)
+			th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+		th_memcpy(ctx,params,sizeof(loops_params));
+		ctx->team = NULL;
+		ctx->v2 = NULL;
+		alloc_buffers(ctx);
+		t->workers[i].team = t;
+		t->workers[i].ctx = ctx;
+	}
+	for (i = 1; i < nthreads; i++) {
+		al_item_textend(&tex, i);
+		al_thread_create_ex(&t->threads[i],loops_helper,&t->workers[i],&tex);
+	}
+	return t;
+}
+
+/*----------------------*/
+static void loops_team_destroy(loops_team *t)
+{
+	void *retval;
+	int i;
+
+	al_mutex_lock(&t->lock);
+	t->quit = 1;
+	al_cond_broadcast(&t->wake);
+	al_mutex_unlock(&t->lock);
+	for (i = 1; i < t->nthreads; i++)
+		al_thread_join(t->threads[i],&retval);
+	al_cond_destroy(&t->idle);
+	al_cond_destroy(&t->wake);
+	al_mutex_destroy(&t->lock);
+	for (i = 1; i < t->nthreads; i++) {
+		free_buffers(t->workers[i].ctx);
+		th_free(t->workers[i].ctx);
+	}
+	th_free(t->workers);
+	th_free(t->threads);
+	th_free(t);
+}
+
 e_fp MonteCarlo_integrate(loops_params *p)
 {
 	int under_curve = 0;
@@ -1491,7 +2318,8 @@ e_fp pic_2d(loops_params *p) {
       }
 
 #else
-      for ( ip=0 ; ip<n ; ip++ ) {
+      ip = (p->vtests & PIC_2D) ? pic_2d_vec(p) : 0;
+      for ( ; ip<n ; ip++ ) {
         i1 = p1r[ip];
         j1 = p1i[ip];
         i1 &= 0x03f;
@@ -1532,7 +2360,7 @@ e_fp pic_1d(loops_params *p) {
 	e_u32 *ix=p->iv[0],  *ir=p->iv[1]; /* temporary outputs */
 	e_fp dw,flx;
 	int n=p->N, loop=p->Loop;
-	int k,l;
+	int k,l,k0;
     /*
      *******************************************************************
      *   Kernel 14 -- 1-D PIC (pticle In Cell)
@@ -1572,7 +2400,8 @@ e_fp pic_1d(loops_params *p) {
 	flx=FPCONST(0.00100e0);
 
     for ( l=1 ; l<=loop ; l++ ) {
-        for ( k=0 ; k<n ; k++ ) {
+        k0 = (p->vtests & PIC_1D) ? pic_1d_vec(p,flx) : 0;
+        for ( k=k0 ; k<n ; k++ ) {
             vx[k] = FPCONST(0.0);
             xx[k] = FPCONST(0.0);
             ix[k] = (long) grd[k];
@@ -1583,7 +2412,7 @@ e_fp pic_1d(loops_params *p) {
 			   each time through the outer loop */
 			grd[k]+=EE_EPSINI;
         }
-        for ( k=0 ; k<n ; k++ ) {
+        for ( k=k0 ; k<n ; k++ ) {
             vx[k] += ex1[k] + ( xx[k] - xi[k] )*dex1[k];
             xx[k] += vx[k]  + flx;
             ir[k] = (e_u32)xx[k];
@@ -1591,7 +2420,7 @@ e_fp pic_1d(loops_params *p) {
             ir[k] = ( ir[k] & (n-1) ) + 1;
             xx[k] = rx[k] + ir[k];
         }
-        for ( k=0 ; k<n ; k++ ) {
+        for ( k=k0 ; k<n ; k++ ) {
             rh[ ir[k]-1 ] += FPCONST(1.0) - rx[k];
             rh[ ir[k]   ] += rx[k];
         }
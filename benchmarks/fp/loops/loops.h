@@ -91,6 +91,10 @@ typedef struct loops_params_s {
 	char *err;
 	e_u32 minbits;
 	e_u32 rtype;
+	e_u32 threads;	//If non zero, run each kernel isolated as a task of a team of this many threads
+	e_s32 kernel_stats;	//Report per kernel timings
+	e_u32 vtests;	//Kernels that run their vectorized variant, same bits as tests
+	e_u32 vengine;	//Engine of the vectorized variants, a limit until define selects it
 
 	/* Per init data */
 	e_fp **v;
@@ -101,9 +105,15 @@ typedef struct loops_params_s {
 	e_fp *rbank;
 	e_u32 *irbank;
 	void *r; //for random;
+	struct loops_team_s *team;
+	size_t kernel_ticks[LAST_TEST_IDX];	//Accumulated time of each kernel in this context
+	size_t run_ticks;
+	e_u32 runs;
+	struct loops_stats_s *stats;	//Timings of all contexts, shared
 	
 	/* Verification and return values */
 	intparts *ref_data;
+	intparts *ref_iso_data;	//Results with isolated kernels
 	e_fp val;
 	e_fp *rx;
 	e_fp *ry;
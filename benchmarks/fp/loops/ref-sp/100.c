@@ -30,6 +30,35 @@ static intparts ref_data_3[]={
 	{0,12,0x00000000,0x009cde77}/*5.019808105468750000e+03*/
 }; /* ref_data */
 
+static intparts ref_iso_data_3[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff6c34}/*9.977447986602783203e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x00000000,0x00fd745c}/*-4.950283765792846680e-01*/,
+	{1,0,0x00000000,0x00be1cb5}/*-1.485251069068908691e+00*/,
+	{0,3,0x00000000,0x00bd9c2e}/*1.185062980651855469e+01*/,
+	{0,-1,0x00000000,0x00fe6018}/*9.936537742614746094e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,4,0x00000000,0x00b4aa00}/*2.258300781250000000e+01*/,
+	{0,-2,0x00000000,0x00de95b8}/*4.347360134124755859e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x0084d615}/*1.037783265113830566e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-1,0x00000000,0x00a147ae}/*-6.299999952316284180e-01*/,
+	{1,0,0x00000000,0x008120c2}/*-1.008812189102172852e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,12,0x00000000,0x009c4000}/*5.000000000000000000e+03*/,
+	{0,12,0x00000000,0x009d523a}/*5.034278320312500000e+03*/
+}; /* ref_iso_data */
+
 void init_preset_3() {
 presets_loops[3].seed=0x4645ca3;
 presets_loops[3].N=0x64;
@@ -40,6 +69,7 @@ presets_loops[3].rtype=0;
 presets_loops[3].limit_int_input=0;
 presets_loops[3].reinit_step=0x1;
 presets_loops[3].ref_data=ref_data_3;
+presets_loops[3].ref_iso_data=ref_iso_data_3;
 }
 /**** END DATASET ****/
 
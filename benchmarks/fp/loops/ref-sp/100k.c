@@ -30,6 +30,35 @@ static intparts ref_data_2[]={
 	{0,13,0x00000000,0x00aafdab}/*1.094341699218750000e+04*/
 }; /* ref_data */
 
+static intparts ref_iso_data_2[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff6c34}/*9.977447986602783203e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff34ec}/*9.969012737274169922e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x00000000,0x00fe9b19}/*-4.972770512104034424e-01*/,
+	{1,-2,0x00000000,0x00f653c6}/*-4.811078906059265137e-01*/,
+	{0,3,0x00000000,0x00a29c74}/*1.016319656372070312e+01*/,
+	{0,-1,0x00000000,0x00fe6018}/*9.936537742614746094e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x00000000,0x00a7c4d6}/*1.073720898437500000e+04*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-3,0x00000000,0x00f86439}/*-2.425698190927505493e-01*/,
+	{0,6,0x00000000,0x00c80000}/*1.000000000000000000e+02*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x0084d616}/*1.037783384323120117e+00*/,
+	{0,6,0x00000000,0x00c97c9f}/*1.007434005737304688e+02*/,
+	{1,-9,0x00000000,0x00ea9e6f}/*-3.580000018700957298e-03*/,
+	{1,-2,0x00000000,0x00e56c78}/*-4.480931758880615234e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x00000000,0x00ab19e0}/*1.095046875000000000e+04*/
+}; /* ref_iso_data */
+
 void init_preset_2() {
 presets_loops[2].seed=0x4645ca3;
 presets_loops[2].N=0x186a0;
@@ -40,6 +69,7 @@ presets_loops[2].rtype=0;
 presets_loops[2].limit_int_input=0;
 presets_loops[2].reinit_step=0x1;
 presets_loops[2].ref_data=ref_data_2;
+presets_loops[2].ref_iso_data=ref_iso_data_2;
 }
 /**** END DATASET ****/
 
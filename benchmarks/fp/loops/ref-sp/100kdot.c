@@ -30,6 +30,35 @@ static intparts ref_data_7[]={
 	{0,21,0x00000000,0x00c84858}/*3.281430000000000000e+06*/
 }; /* ref_data */
 
+static intparts ref_iso_data_7[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,21,0x00000000,0x00c5f2e4}/*3.243193000000000000e+06*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,21,0x00000000,0x00c5f2e4}/*3.243193000000000000e+06*/
+}; /* ref_iso_data */
+
 void init_preset_7() {
 presets_loops[7].seed=0x4645ca3;
 presets_loops[7].N=0x186a0;
@@ -40,6 +69,7 @@ presets_loops[7].rtype=1;
 presets_loops[7].limit_int_input=1;
 presets_loops[7].reinit_step=0x1;
 presets_loops[7].ref_data=ref_data_7;
+presets_loops[7].ref_iso_data=ref_iso_data_7;
 }
 /**** END DATASET ****/
 
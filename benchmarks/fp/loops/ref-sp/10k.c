@@ -30,6 +30,35 @@ static intparts ref_data_1[]={
 	{0,13,0x00000000,0x00aafd9a}/*1.094340039062500000e+04*/
 }; /* ref_data */
 
+static intparts ref_iso_data_1[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff6c34}/*9.977447986602783203e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff34ec}/*9.969012737274169922e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x00000000,0x00fea123}/*-4.973231256008148193e-01*/,
+	{1,-2,0x00000000,0x00fb007e}/*-4.902381300926208496e-01*/,
+	{0,3,0x00000000,0x00a2cce0}/*1.017501831054687500e+01*/,
+	{0,-1,0x00000000,0x00fe6018}/*9.936537742614746094e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x00000000,0x00a7c4d6}/*1.073720898437500000e+04*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-7,0x00000000,0x00c25d3b}/*-1.186304818838834763e-02*/,
+	{0,6,0x00000000,0x00c80000}/*1.000000000000000000e+02*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x0084d615}/*1.037783265113830566e+00*/,
+	{0,6,0x00000000,0x00c97ca0}/*1.007434082031250000e+02*/,
+	{1,-5,0x00000000,0x00e69ad4}/*-5.629999935626983643e-02*/,
+	{1,-2,0x00000000,0x00e80395}/*-4.531523287296295166e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x00000000,0x00ab1a94}/*1.095064453125000000e+04*/
+}; /* ref_iso_data */
+
 void init_preset_1() {
 presets_loops[1].seed=0x4645ca3;
 presets_loops[1].N=0x2710;
@@ -42,6 +71,7 @@ presets_loops[1].rtype=0;
 presets_loops[1].limit_int_input=0;
 presets_loops[1].reinit_step=0x1;
 presets_loops[1].ref_data=ref_data_1;
+presets_loops[1].ref_iso_data=ref_iso_data_1;
 }
 /**** END DATASET ****/
 
@@ -30,6 +30,35 @@ static intparts ref_data_5[]={
 	{0,18,0x00000000,0x00a01800}/*3.278720000000000000e+05*/
 }; /* ref_data */
 
+static intparts ref_iso_data_5[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,18,0x00000000,0x009e6680}/*3.244040000000000000e+05*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,18,0x00000000,0x009e6680}/*3.244040000000000000e+05*/
+}; /* ref_iso_data */
+
 void init_preset_5() {
 presets_loops[5].seed=0x4645ca3;
 presets_loops[5].N=0x2710;
@@ -40,6 +69,7 @@ presets_loops[5].rtype=1;
 presets_loops[5].limit_int_input=1;
 presets_loops[5].reinit_step=0x1;
 presets_loops[5].ref_data=ref_data_5;
+presets_loops[5].ref_iso_data=ref_iso_data_5;
 }
 /**** END DATASET ****/
 
@@ -30,6 +30,35 @@ static intparts ref_data_0[]={
 	{0,13,0x00000000,0x00acc565}/*1.105734863281250000e+04*/
 }; /* ref_data */
 
+static intparts ref_iso_data_0[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff6c34}/*9.977447986602783203e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff34ec}/*9.969012737274169922e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x00000000,0x00fe9d94}/*-4.972959756851196289e-01*/,
+	{1,-1,0x00000000,0x009401be}/*-5.781515836715698242e-01*/,
+	{0,3,0x00000000,0x00a4b1b5}/*1.029338550567626953e+01*/,
+	{0,-1,0x00000000,0x00fe6018}/*9.936537742614746094e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x00000000,0x00a7c4d6}/*1.073720898437500000e+04*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-5,0x00000000,0x0080b459}/*3.142199292778968811e-02*/,
+	{0,6,0x00000000,0x00c80000}/*1.000000000000000000e+02*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x0084d616}/*1.037783384323120117e+00*/,
+	{0,6,0x00000000,0x00c97ca0}/*1.007434082031250000e+02*/,
+	{1,0,0x00000000,0x008ae148}/*-1.085000038146972656e+00*/,
+	{1,-1,0x00000000,0x00812a6e}/*-5.045536756515502930e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x00000000,0x00ab168d}/*1.094963769531250000e+04*/
+}; /* ref_iso_data */
+
 void init_preset_0() {
 presets_loops[0].seed=0x4645ca3;
 presets_loops[0].N=0x400;
@@ -40,6 +69,7 @@ presets_loops[0].rtype=0;
 presets_loops[0].limit_int_input=0;
 presets_loops[0].reinit_step=0x1;
 presets_loops[0].ref_data=ref_data_0;
+presets_loops[0].ref_iso_data=ref_iso_data_0;
 }
 /**** END DATASET ****/
 
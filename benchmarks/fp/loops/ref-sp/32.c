@@ -30,6 +30,35 @@ static intparts ref_data_4[]={
 	{0,10,0x00000000,0x00d02644}/*1.665195800781250000e+03*/
 }; /* ref_data */
 
+static intparts ref_iso_data_4[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x00000000,0x00ff6c34}/*9.977447986602783203e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x00000000,0x00fd015b}/*-4.941509664058685303e-01*/,
+	{1,1,0x00000000,0x00e81c4a}/*-3.626726627349853516e+00*/,
+	{0,4,0x00000000,0x00a2169d}/*2.026104164123535156e+01*/,
+	{0,-1,0x00000000,0x00fe6018}/*9.936537742614746094e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00ca79a6}/*1.581837415695190430e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x0084d616}/*1.037783384323120117e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,3,0x00000000,0x00f851ec}/*-1.552000045776367188e+01*/,
+	{1,1,0x00000000,0x00892b26}/*-2.143258571624755859e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,10,0x00000000,0x00c80000}/*1.600000000000000000e+03*/,
+	{0,10,0x00000000,0x00c862d0}/*1.603087890625000000e+03*/
+}; /* ref_iso_data */
+
 void init_preset_4() {
 presets_loops[4].seed=0x4645ca3;
 presets_loops[4].N=0x20;
@@ -40,6 +69,7 @@ presets_loops[4].rtype=0;
 presets_loops[4].limit_int_input=0;
 presets_loops[4].reinit_step=0x1;
 presets_loops[4].ref_data=ref_data_4;
+presets_loops[4].ref_iso_data=ref_iso_data_4;
 }
 /**** END DATASET ****/
 
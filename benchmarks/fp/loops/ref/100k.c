@@ -30,6 +30,35 @@ static intparts ref_data_2[]={
 	{0,13,0x00152e3b,0xdd5a83b7}/*1.084446769267493619e+04*/
 }; /* ref_data */
 
+static intparts ref_iso_data_2[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x001fae14,0x7ae2bed6}/*9.900000000106625730e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x001fae14,0x7ae3268e}/*9.900000000136104372e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x001d5254,0x60a3e32e}/*-4.581499999763306574e-01*/,
+	{0,123,0x00104865,0x3808efa4}/*1.082177313464290950e+37*/,
+	{0,3,0x00141006,0x1243bd9c}/*1.003129632069504140e+01*/,
+	{0,-1,0x001fae14,0x7ae21cf2}/*9.900000000060613647e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x0014cd2a,0x3d7202e3}/*1.065033000016346887e+04*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-3,0x001f0c23,0x85ef8197}/*-2.425579456312447479e-01*/,
+	{0,6,0x00190000,0x00000000}/*1.000000000000000000e+02*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00105117,0xba96baaa}/*1.019798020231670765e+00*/,
+	{0,6,0x00190147,0xae16575a}/*1.000200000017333934e+02*/,
+	{1,-9,0x001d53cd,0xdd6e04c0}/*-3.579999999999999849e-03*/,
+	{1,-2,0x001a6d30,0xd5271c06}/*-4.129144746370346786e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,123,0x00104865,0x3808efa4}/*1.082177313464290950e+37*/
+}; /* ref_iso_data */
+
 void init_preset_2() {
 presets_loops[2].seed=0x4645ca3;
 presets_loops[2].N=0x186a0;
@@ -40,6 +69,7 @@ presets_loops[2].rtype=0;
 presets_loops[2].limit_int_input=0;
 presets_loops[2].reinit_step=0x1;
 presets_loops[2].ref_data=ref_data_2;
+presets_loops[2].ref_iso_data=ref_iso_data_2;
 }
 /**** END DATASET ****/
 
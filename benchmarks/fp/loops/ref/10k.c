@@ -30,6 +30,35 @@ static intparts ref_data_1[]={
 	{0,13,0x00152e3e,0x2289275b}/*1.084448542894765524e+04*/
 }; /* ref_data */
 
+static intparts ref_iso_data_1[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x001fae14,0x7ae2bed6}/*9.900000000106625730e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x001fae14,0x7ae3268e}/*9.900000000136104372e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x001d5254,0x60a3dbbf}/*-4.581499999762250197e-01*/,
+	{0,123,0x001044f8,0x6f80fff5}/*1.081288149538514063e+37*/,
+	{0,3,0x00141605,0x3d3d3773}/*1.004300872204087192e+01*/,
+	{0,-1,0x001fae14,0x7ae21cf2}/*9.900000000060613647e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x0014cd2a,0x3d7202e3}/*1.065033000016346887e+04*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-9,0x00190214,0x088618eb}/*-3.052748801738327297e-03*/,
+	{0,6,0x00190000,0x00000000}/*1.000000000000000000e+02*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00105117,0xba96baaa}/*1.019798020231670765e+00*/,
+	{0,6,0x00190147,0xae16117d}/*1.000200000014792323e+02*/,
+	{1,-5,0x001cd35a,0x858793de}/*-5.630000000000000282e-02*/,
+	{1,-2,0x001ac266,0xae62a438}/*-4.181153014165519544e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,123,0x001044f8,0x6f80fff5}/*1.081288149538514063e+37*/
+}; /* ref_iso_data */
+
 void init_preset_1() {
 presets_loops[1].seed=0x4645ca3;
 presets_loops[1].N=0x2710;
@@ -40,6 +69,7 @@ presets_loops[1].rtype=0;
 presets_loops[1].limit_int_input=0;
 presets_loops[1].reinit_step=0x1;
 presets_loops[1].ref_data=ref_data_1;
+presets_loops[1].ref_iso_data=ref_iso_data_1;
 }
 /**** END DATASET ****/
 
@@ -30,6 +30,35 @@ static intparts ref_data_0[]={
 	{0,13,0x00152e57,0xbb4a26df}/*1.084468540312669757e+04*/
 }; /* ref_data */
 
+static intparts ref_iso_data_0[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x001fae14,0x7ae2bed6}/*9.900000000106625730e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x001fae14,0x7ae3268e}/*9.900000000136104372e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x001d5254,0x60a3e00b}/*-4.581499999762860820e-01*/,
+	{0,123,0x001023e0,0xd3d4aa7b}/*1.072696918265890087e+37*/,
+	{0,3,0x001451a7,0x728e02f5}/*1.015948064788379135e+01*/,
+	{0,-1,0x001fae14,0x7ae21cf2}/*9.900000000060613647e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,13,0x0014cd2a,0x3d7202e3}/*1.065033000016346887e+04*/,
+	{0,7,0x0018f997,0x61e84800}/*1.997997293030493893e+02*/,
+	{0,-5,0x00104723,0x61922cd3}/*3.179274145176127359e-02*/,
+	{0,6,0x00190000,0x00000000}/*1.000000000000000000e+02*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00105117,0xba96baaa}/*1.019798020231670765e+00*/,
+	{0,6,0x00190147,0xae160a89}/*1.000200000014539370e+02*/,
+	{1,0,0x00115c28,0xf5c28f5c}/*-1.084999999999999964e+00*/,
+	{1,-2,0x001e0050,0x7a242de4}/*-4.687691872393016101e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,123,0x001023e0,0xd3d4aa7b}/*1.072696918265890087e+37*/
+}; /* ref_iso_data */
+
 void init_preset_0() {
 presets_loops[0].seed=0x4645ca3;
 presets_loops[0].N=0x400;
@@ -40,6 +69,7 @@ presets_loops[0].rtype=0;
 presets_loops[0].limit_int_input=0;
 presets_loops[0].reinit_step=0x1;
 presets_loops[0].ref_data=ref_data_0;
+presets_loops[0].ref_iso_data=ref_iso_data_0;
 }
 /**** END DATASET ****/
 
@@ -30,6 +30,35 @@ static intparts ref_data_4[]={
 	{0,10,0x001aa40e,0xf19b557c}/*1.705014593531696846e+03*/
 }; /* ref_data */
 
+static intparts ref_iso_data_4[]={
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,-1,0x001fae14,0x7ae2bed6}/*9.900000000106625730e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,-2,0x001d5254,0x60a4fe82}/*-4.581499999803569922e-01*/,
+	{0,122,0x00174c21,0xd870e566}/*7.741886233010345589e+36*/,
+	{0,4,0x0014039a,0xfe5ecfab}/*2.001408376517035137e+01*/,
+	{0,-1,0x001fae14,0x7ae21cf2}/*9.900000000060613647e-01*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,8,0x0012bb33,0x29f876c0}/*2.996999911981220066e+02*/,
+	{0,0,0x00189c4f,0xa472200a}/*1.538161890379344587e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,0,0x00105117,0xba96baaa}/*1.019798020231670765e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{1,3,0x001f0a3d,0x70a3d70a}/*-1.551999999999999957e+01*/,
+	{1,1,0x0011bed4,0xc1703388}/*-2.218179236637698892e+00*/,
+	{0,0,0x00000000,0x00000000}/*0.000000000000000000e+00*/,
+	{0,10,0x00190000,0x00000000}/*1.600000000000000000e+03*/,
+	{0,122,0x00174c21,0xd870e566}/*7.741886233010345589e+36*/
+}; /* ref_iso_data */
+
 void init_preset_4() {
 presets_loops[4].seed=0x4645ca3;
 presets_loops[4].N=0x20;
@@ -40,6 +69,7 @@ presets_loops[4].rtype=0;
 presets_loops[4].limit_int_input=0;
 presets_loops[4].reinit_step=0x1;
 presets_loops[4].ref_data=ref_data_4;
+presets_loops[4].ref_iso_data=ref_iso_data_4;
 }
 /**** END DATASET ****/
 
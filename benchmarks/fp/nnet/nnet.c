@@ -24,6 +24,31 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 extern void init_preset_0();
 nnet_params presets_nnet[NUM_DATAS];
 
+/* Mini batch vectors.
+	With GCC the batch kernels work on vectors of NNET_VLEN patterns (or inputs),
+	otherwise on single values with the same code.
+*/
+#if defined(__GNUC__) && (USE_FP32 || USE_FP64)
+#define NNET_GNU_VEC 1
+#if defined(__AVX__)
+#define NNET_VBYTES 32
+#else
+#define NNET_VBYTES 16
+#endif
+#define NNET_VLEN (NNET_VBYTES/(int)sizeof(e_fp))
+typedef e_fp nnet_vec __attribute__((vector_size(NNET_VBYTES),aligned(sizeof(e_fp))));
+#if USE_FP32
+typedef e_s32 nnet_ivec __attribute__((vector_size(NNET_VBYTES),aligned(sizeof(e_fp))));
+#else
+typedef e_s64 nnet_ivec __attribute__((vector_size(NNET_VBYTES),aligned(sizeof(e_fp))));
+#endif
+#else
+#define NNET_GNU_VEC 0
+#define NNET_VLEN 1
+typedef e_fp nnet_vec;
+#endif
+#define NNET_VEC(p) (*(nnet_vec *)(p))
+
 /* ======================================================================== */
 /* ======================================================================== */
 /* file provides :
@@ -56,30 +81,83 @@ static void move_wt_changes(nnet_params *params);
 static int check_out_error(nnet_params *params);
 static void zero_changes(nnet_params *params);
 static void randomize_wts(nnet_params *params);
+static void batch_setup(nnet_params *params);
+static void batch_pass(nnet_params *params);
 
 void init_random_patterns(nnet_params *params) {
 	int i,m,k=0;
-	int inpat_size=params->d_y * params->d_x;
-	e_fp *rvals=fromint_fp_01_vector(1+0x0fff,params->seed);
-	e_fp *ivals=fromint_fp_01_vector(params->n_in,params->seed);
+	/* uniform values, enough that large patterns do not repeat each other,
+	   and a density between 25% and 75% for each pattern so patterns stay apart */
+	int rsize=(params->n_in*params->in_size>0x1000) ? params->n_in*params->in_size : 0x1000;
+	e_fp *rvals=fromint_fp_01_vector_uniform(rsize,params->seed);
+	e_fp *ivals=fromint_fp_01_vector_uniform(params->n_in,params->seed+1);
 	
 	for (i=0; i<params->n_in; i++) {
-		for (m=0; m<inpat_size; m++) {
-			params->in_pats[i][m] = (rvals[k++ & 0xfff]>ivals[i]) ? FPCONST(0.9):FPCONST(0.1);
+		e_fp thresh=FPCONST(0.25)+FPCONST(0.5)*ivals[i];
+		for (m=0; m<params->in_size; m++) {
+			params->in_pats[i*params->in_alloc+m] = (rvals[k++ % rsize]>thresh) ? FPCONST(0.9):FPCONST(0.1);
 		}
-		for (m=0; m<params->d_out; m++) {
-			params->out_pats[i][m] = (((i>>m) & 1) == 1) ? FPCONST(1.0) : FPCONST(0.0);
+		for (m=0; m<params->out_size; m++) {
+			params->out_pats[i*params->out_size+m] = (((i>>m) & 1) == 1) ? FPCONST(1.0) : FPCONST(0.0);
 		}
 	}
 	th_free(ivals);
 	th_free(rvals);
 }
 
+/* Carve n values out of a block, keeping every array aligned to whole vectors */
+static e_fp *nnet_carve(e_fp **pos, size_t n) {
+	e_fp *ret=*pos;
+	*pos+=NNET_ALLOC(n);
+	return ret;
+}
+
+/* Allocate the patterns for the topology in params, and fill them from the preset or at random */
+static void alloc_patterns(nnet_params *params) {
+	size_t n_in=params->n_in, in_size=params->in_size, out_size=params->out_size;
+	size_t batch_alloc=params->batch_alloc;
+	size_t size=n_in*params->in_alloc+NNET_ALLOC(n_in*out_size);
+	e_fp *pos;
+	int i,m,in_idx=0;
+
+	if (params->batch)
+		size+=(in_size+out_size+1)*batch_alloc;
+	params->pats=(e_fp *)th_aligned_malloc(size*sizeof(e_fp),ALIGN_BOUNDARY);
+	if ( params->pats == NULL )
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	th_memset(params->pats,0,size*sizeof(e_fp));
+	pos=params->pats;
+	params->in_pats=nnet_carve(&pos,n_in*params->in_alloc);
+	params->out_pats=nnet_carve(&pos,n_in*out_size);
+	if (params->batch) {
+		params->b_in=nnet_carve(&pos,in_size*batch_alloc);
+		params->b_target=nnet_carve(&pos,out_size*batch_alloc);
+		params->b_valid=nnet_carve(&pos,batch_alloc);
+	}
+
+	if (params->in_data==NULL) {
+		init_random_patterns(params);
+		return;
+	}
+	for (i=0; i<params->n_in; i++) {
+		for (m=0; m<params->in_size; m++) {
+			params->in_pats[i*params->in_alloc+m] = params->in_data[in_idx++] ? FPCONST(0.9):FPCONST(0.1);
+		}
+		for (m=0; m<params->out_size; m++) {
+			params->out_pats[i*params->out_size+m] = params->in_data[in_idx++] ? FPCONST(1.0):FPCONST(0.0);
+		}
+	}
+}
+
 void *define_params_nnet(unsigned int idx, char *name, char *dataset) {
     nnet_params *params;
 	e_s32 data_index=idx;
+	e_s32 d_x,d_y,n_in,mid_size;
+	int has_ref;
 	init_preset_0();
 	init_preset_1();
+	init_preset_2();
+	init_preset_3();
 
 	/* parameter setup */
 	params=(nnet_params *)th_aligned_malloc(sizeof(nnet_params),ALIGN_BOUNDARY);
@@ -92,7 +170,12 @@ void *define_params_nnet(unsigned int idx, char *name, char *dataset) {
 	params->seed=0;
 	params->ref_data=NULL;
 	params->next_ridx=0;
-	params->n_in=0;
+	/* letters topology with random patterns, unless a preset is selected */
+	params->d_x=5;
+	params->d_y=7;
+	params->d_out=OUT_SIZE;
+	params->n_in=MAX_PATTERNS;
+	params->loops=1;
 	
 	if (pgo_training_run) {
 		data_index=1; 
@@ -105,17 +188,62 @@ void *define_params_nnet(unsigned int idx, char *name, char *dataset) {
 	} 
 	/* command line overrides */
 	if (pgo_training_run==0) {
+		d_x=params->d_x;
+		d_y=params->d_y;
+		n_in=params->n_in;
+		mid_size=params->mid_size;
 		th_parse_buf_flag_unsigned(dataset,"-s",&params->seed);
 		th_parse_buf_flag(dataset,"-n",&params->loops);
 		th_parse_buf_flag(dataset,"-g",&params->gen_ref);
+		th_parse_buf_flag(dataset,"-b",&params->batch);
+		th_parse_buf_flag(dataset,"-x",&params->d_x);
+		th_parse_buf_flag(dataset,"-y",&params->d_y);
+		th_parse_buf_flag(dataset,"-p",&params->n_in);
+		th_parse_buf_flag(dataset,"-m",&params->mid_size);
+		th_parse_buf_flag(dataset,"-w",&params->init_wts);
+		th_parse_buf_flag(dataset,"-t",&params->max_passes);
+		/* a different topology trains on random patterns, and has no reference */
+		if (d_x!=params->d_x || d_y!=params->d_y || n_in!=params->n_in)
+			params->in_data=NULL;
+		if (d_x!=params->d_x || d_y!=params->d_y || n_in!=params->n_in || mid_size!=params->mid_size) {
+			params->ref_data=NULL;
+			params->ref_passes=NULL;
+			params->ref_batch_data=NULL;
+			params->ref_batch_passes=NULL;
+		}
 	}
-	if (params->n_in > MAX_PATTERNS) {
-		th_printf("ERROR: MAX_PATTERNS is set to 26. Must be modified in the header file for this dataset!\n");
-		th_free(params);
-		return NULL;
+	if (params->d_x<1 || params->d_y<1 || params->d_out<1 || params->n_in<1 || params->mid_size<0 || params->loops<1 || params->max_passes<0)
+		th_exit( THE_BAD_SIZE, "Invalid network topology %s:%d", __FILE__,__LINE__ );
+	if (params->mid_size==0)
+		params->mid_size=MID_SIZE;
+	params->in_size=params->d_x*params->d_y;
+	params->out_size=params->d_out;
+	params->in_alloc=NNET_ALLOC(params->in_size);
+	params->batch_alloc=NNET_ALLOC(params->n_in);
+	/* keep the change of a neurode input per step the same as with the default fan in */
+	params->mid_rate=(e_fp)IN_SIZE/(e_fp)params->in_size;
+	params->out_rate=(e_fp)MID_SIZE/(e_fp)params->mid_size;
+	has_ref=(params->ref_data!=NULL);
+
+	if (params->batch) {
+		/* the batch trajectory differs from per pattern training, and has its own reference */
+		params->ref_passes=params->ref_batch_passes;
+		params->ref_iterations=params->ref_batch_iterations;
+		params->ref_average_error=params->ref_batch_average_error;
+		params->ref_data=params->ref_batch_data;
+		if (has_ref && params->ref_passes==NULL && !params->gen_ref)
+			th_exit( THE_BAD_PTR, "No mini batch reference for this dataset, generate one with -g %s:%d", __FILE__,__LINE__ );
+	}
+	alloc_patterns(params);
+	if (params->batch)
+		batch_setup(params);
+	if (params->init_wts) {
+		params->rand_size=NNET_RAND_SIZE_LARGE;
+		params->random_values=fromint_fp_01_vector_uniform(params->rand_size,params->seed);
+	} else {
+		params->rand_size=NNET_RAND_SIZE;
+		params->random_values=fromint_fp_01_vector(params->rand_size,params->seed);
 	}
-
-	params->random_values=fromint_fp_01_vector(1+0x0ff,params->seed);
 #if (USE_FP32)
 	params->minbits=MIN_ACC_BITS_FP32;
 #elif (USE_FP64)
@@ -123,6 +251,11 @@ void *define_params_nnet(unsigned int idx, char *name, char *dataset) {
 #else
 	params->minbits=MIN_ACC_BITS_OTHER;
 #endif
+	/* Full batch steps amplify rounding differences much more than per pattern training,
+	   contracting multiply adds alone moves the final errors by about 2^-20, so batch results
+	   are checked to single precision accuracy. */
+	if (params->batch && params->minbits>MIN_ACC_BITS_FP32)
+		params->minbits=MIN_ACC_BITS_FP32;
 	
 	return params;
 }
@@ -134,6 +267,8 @@ int bmark_clean_nnet(void *in_params) {
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
 	if (params->random_values)
 		th_free(params->random_values);
+	if (params->pats)
+		th_aligned_free(params->pats);
 	th_aligned_free(params);
 	return 1;
 }
@@ -141,6 +276,8 @@ int bmark_clean_nnet(void *in_params) {
 void *bmark_init_nnet(void *in_params) {
 	nnet_params *params=(nnet_params *)in_params;
     nnet_params *myparams;
+	size_t mid_size, in_alloc, out_size, batch_alloc, size;
+	e_fp *pos;
 	if (in_params==NULL)
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
 	myparams=(nnet_params *)th_aligned_malloc(sizeof(nnet_params),ALIGN_BOUNDARY);
@@ -148,6 +285,39 @@ void *bmark_init_nnet(void *in_params) {
           th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
 	th_memcpy(myparams,params,sizeof(nnet_params));
 
+	/* patterns are shared, weights and layer state are private to the context */
+	mid_size=params->mid_size;
+	in_alloc=params->in_alloc;
+	out_size=params->out_size;
+	batch_alloc=params->batch_alloc;
+	size=3*NNET_ALLOC(mid_size*in_alloc)+3*NNET_ALLOC(out_size*mid_size)
+		+2*NNET_ALLOC(mid_size)+2*NNET_ALLOC(out_size)+2*NNET_ALLOC(params->n_in);
+	if (params->batch)
+		size+=2*NNET_ALLOC(mid_size*batch_alloc)+2*NNET_ALLOC(out_size*batch_alloc);
+	myparams->state=(e_fp *)th_aligned_malloc(size*sizeof(e_fp),ALIGN_BOUNDARY);
+	if ( myparams->state == NULL )
+		th_exit( THE_OUT_OF_MEMORY, "Cannot Allocate Memory %s:%d", __FILE__,__LINE__ );
+	th_memset(myparams->state,0,size*sizeof(e_fp));
+	pos=myparams->state;
+	myparams->mid_wts=nnet_carve(&pos,mid_size*in_alloc);
+	myparams->mid_wt_change=nnet_carve(&pos,mid_size*in_alloc);
+	myparams->mid_wt_cum_change=nnet_carve(&pos,mid_size*in_alloc);
+	myparams->out_wts=nnet_carve(&pos,out_size*mid_size);
+	myparams->out_wt_change=nnet_carve(&pos,out_size*mid_size);
+	myparams->out_wt_cum_change=nnet_carve(&pos,out_size*mid_size);
+	myparams->mid_out=nnet_carve(&pos,mid_size);
+	myparams->mid_error=nnet_carve(&pos,mid_size);
+	myparams->out_out=nnet_carve(&pos,out_size);
+	myparams->out_error=nnet_carve(&pos,out_size);
+	myparams->tot_out_error=nnet_carve(&pos,params->n_in);
+	myparams->avg_out_error=nnet_carve(&pos,params->n_in);
+	if (params->batch) {
+		myparams->b_mid_out=nnet_carve(&pos,mid_size*batch_alloc);
+		myparams->b_mid_error=nnet_carve(&pos,mid_size*batch_alloc);
+		myparams->b_out_out=nnet_carve(&pos,out_size*batch_alloc);
+		myparams->b_out_error=nnet_carve(&pos,out_size*batch_alloc);
+	}
+
 	return myparams;
 }
 void *bmark_fini_nnet(void *in_params) {
@@ -156,6 +326,7 @@ void *bmark_fini_nnet(void *in_params) {
 		th_exit( THE_BAD_PTR, "Invalid pointer %s:%d", __FILE__,__LINE__ );
 	params=(nnet_params *)in_params;
 
+	th_aligned_free(params->state);
 	th_aligned_free(params);
 
 	return NULL;
@@ -189,25 +360,48 @@ void *t_run_test_nnet(struct TCDef *tcdef,void *in_params) {
 int bmark_verify_nnet(void *in_params) {
 	int i,m,val;
 	nnet_params *params=(nnet_params *)in_params;
-	int	inpat_size=params->d_y * params->d_x;
 
-	if (params->gen_ref) {
+	if (params->gen_ref && params->batch) {
 		char sbuf[256];
-		th_printf("/**** START DATASET ****/\n#include \"th_lib.h\"\n#include \"../nnet.h\"\n");
-		th_printf("static e_u8 in_data_index[]={\n"); 
+		th_printf("/**** START BATCH REFERENCE ****/\n");
+		th_printf("static intparts ref_batch_err_index[]={\n"); 
 		for (i=0; i<params->n_in; i++) {
-			for (m=0; m<inpat_size; m++) {
-				val=params->in_pats[i][m]>FPCONST(0.5);
-				th_printf("%d,",val);
-				if (((m+1)%params->d_x)==0) th_printf("\n");
-			}
-			for (m=0; m<params->d_out; m++) {
-				val=params->out_pats[i][m]>FPCONST(0.5);
-				th_printf("%d,",val);
+			th_printf("\t%s",th_sprint_fp(params->avg_out_error[i],sbuf));
+			if (i<params->n_in-1)
+				th_printf(",\n");
+		}
+		th_printf("}; /* ref batch err */\n\n"); 
+		th_fpprintf("static intparts ref_batch_average_error_index=%s;\n",th_sprint_fp(params->average_error,sbuf));
+		th_printf("static int ref_batch_passes[] = {\n");
+		for (i=0; i<params->loops; i++) {
+			th_printf("\t%d",params->ref_passes[i]);
+			if (i<params->loops-1)
+				th_printf(",\n");
+		}
+		th_printf("}; /* ref batch passes */\n\n"); 
+		th_printf("presets_nnet[index].ref_batch_data=ref_batch_err_index;\npresets_nnet[index].ref_batch_passes=ref_batch_passes;\n");
+		th_printf("presets_nnet[index].ref_batch_average_error=ref_batch_average_error_index;\npresets_nnet[index].ref_batch_iterations=%d;\n",params->iterations);
+		th_printf("/**** END BATCH REFERENCE ****/\n");
+	} else if (params->gen_ref) {
+		char sbuf[256];
+		th_printf("/**** START DATASET ****/\n#include \"th_lib.h\"\n#include \"../nnet.h\"\n");
+		/* random patterns are generated again from the seed */
+		if (params->in_data) {
+			th_printf("static e_u8 in_data_index[]={\n"); 
+			for (i=0; i<params->n_in; i++) {
+				for (m=0; m<params->in_size; m++) {
+					val=params->in_pats[i*params->in_alloc+m]>FPCONST(0.5);
+					th_printf("%d,",val);
+					if (((m+1)%params->d_x)==0) th_printf("\n");
+				}
+				for (m=0; m<params->out_size; m++) {
+					val=params->out_pats[i*params->out_size+m]>FPCONST(0.5);
+					th_printf("%d,",val);
+				}
+				th_printf("\n");
 			}
-			th_printf("\n");
+			th_printf("}; //ref input data\n\n"); 
 		}
-		th_printf("}; //ref input data\n\n"); 
 		th_printf("static intparts ref_err_index[]={\n"); 
 		for (i=0; i<params->n_in; i++) {
 			th_printf("\t%s",th_sprint_fp(params->avg_out_error[i],sbuf));
@@ -231,7 +425,13 @@ int bmark_verify_nnet(void *in_params) {
 		th_printf("presets_nnet[index].d_out=%d;\n",params->d_out);
 		th_printf("presets_nnet[index].n_in=%d;\n",params->n_in);
 		th_printf("presets_nnet[index].loops=%d;\n",params->loops);
-		th_printf("fill_preset_nnet(in_data_index,&(presets_nnet[index]));\npresets_nnet[index].ref_passes=ref_passes;\npresets_nnet[index].ref_average_error=ref_average_error_index;\n");
+		if (params->mid_size!=MID_SIZE || params->init_wts || params->max_passes) {
+			th_printf("presets_nnet[index].mid_size=%d;\n",params->mid_size);
+			th_printf("presets_nnet[index].init_wts=%d;\n",params->init_wts);
+			th_printf("presets_nnet[index].max_passes=%d;\n",params->max_passes);
+		}
+		th_printf("fill_preset_nnet(%s,&(presets_nnet[index]));\npresets_nnet[index].ref_passes=ref_passes;\npresets_nnet[index].ref_average_error=ref_average_error_index;\n",
+			params->in_data ? "in_data_index" : "NULL");
 		th_printf("presets_nnet[index].ref_iterations=%d;\npresets_nnet[index].next_ridx=0;\n}\n",params->iterations);
 
 		th_printf("/**** END DATASET ****/\n");
@@ -274,14 +474,17 @@ while(nloops--)
 {
 	int learned = FALSE;
 	int req_passes=999999;
-	if (!params->gen_ref) req_passes = params->ref_passes[curloop++];
+	if (!params->gen_ref && params->ref_passes) req_passes = params->ref_passes[curloop++];
 	randomize_wts(params);
 	zero_changes(params);
 	params->pass_count=1;
 	numpasses = 0;
 	while (learned == FALSE)
 	{
-		for (patt=0; patt<params->n_in; patt++)
+		if (params->batch) {
+			batch_pass(params);
+			params->pass_count+=params->n_in;
+		} else for (patt=0; patt<params->n_in; patt++)
 		{
 			params->worst_error = FPCONST(0.0);      /* reset this every pass through data */
 			move_wt_changes(params);      /* move last pass's wt changes to momentum array */
@@ -290,8 +493,12 @@ while(nloops--)
 			params->pass_count++;
 		}
 		numpasses ++;
-		if (params->gen_ref) 
+		if (params->gen_ref || params->ref_passes==NULL) {
 			learned = check_out_error(params);
+			/* large nets train for a fixed number of passes */
+			if (params->max_passes && numpasses>=params->max_passes)
+				learned = TRUE;
+		}
 		else {
 			learned = (numpasses==req_passes) ? TRUE : FALSE;
 			check_out_error(params);
@@ -317,13 +524,15 @@ static void  do_mid_forward(int patt,nnet_params *params)
 {
 e_fp  sum;
 int     neurode, i;
+e_fp *in=params->in_pats+patt*params->in_alloc;
 
-for (neurode=0;neurode<MID_SIZE; neurode++)
+for (neurode=0;neurode<params->mid_size; neurode++)
 {
+	e_fp *wts=params->mid_wts+neurode*params->in_alloc;
 	sum = FPCONST(0.0);
-	for (i=0; i<IN_SIZE; i++)
+	for (i=0; i<params->in_size; i++)
 	{       /* compute weighted sum of input signals */
-		sum += params->mid_wts[neurode][i]*params->in_pats[patt][i];
+		sum += wts[i]*in[i];
 	}
 	/*
 	** apply sigmoid function f(x) = 1/(1+exp(-x)) to weighted sum
@@ -347,15 +556,16 @@ static void  do_out_forward(nnet_params *params)
 e_fp sum;
 int neurode, i;
 
-for (neurode=0; neurode<OUT_SIZE; neurode++)
+for (neurode=0; neurode<params->out_size; neurode++)
 {
+	e_fp *wts=params->out_wts+neurode*params->mid_size;
 	sum = FPCONST(0.0);
-	for (i=0; i<MID_SIZE; i++)
+	for (i=0; i<params->mid_size; i++)
 	{       /*
 		** compute weighted sum of input signals
 		** from middle layer
 		*/
-		sum += params->out_wts[neurode][i]*params->mid_out[i];
+		sum += wts[i]*params->mid_out[i];
 	}
 	/*
 	** Apply f(x) = 1/(1+exp(-x)) to weighted input
@@ -429,9 +639,9 @@ e_fp error,tot_error, sum;
 
 tot_error = FPCONST(0.0);
 sum = FPCONST(0.0);
-for (neurode=0; neurode<OUT_SIZE; neurode++)
+for (neurode=0; neurode<params->out_size; neurode++)
 {
-	params->out_error[neurode] = params->out_pats[patt][neurode] - params->out_out[neurode];
+	params->out_error[neurode] = params->out_pats[patt*params->out_size+neurode] - params->out_out[neurode];
 	/*
 	** while we're here, also compute magnitude
 	** of total error and worst error in this pass.
@@ -451,7 +661,7 @@ for (neurode=0; neurode<OUT_SIZE; neurode++)
 			tot_error = error; /* worst error this pattern */
 	}
 }
-params->avg_out_error[patt] = sum/OUT_SIZE;
+params->avg_out_error[patt] = sum/params->out_size;
 params->tot_out_error[patt] = tot_error;
 return;
 }
@@ -494,11 +704,11 @@ static void do_mid_error(nnet_params *params)
 e_fp sum;
 int neurode, i;
 
-for (neurode=0; neurode<MID_SIZE; neurode++)
+for (neurode=0; neurode<params->mid_size; neurode++)
 {
 	sum = FPCONST(0.0);
-	for (i=0; i<OUT_SIZE; i++)
-		sum += params->out_wts[i][neurode]*params->out_error[i];
+	for (i=0; i<params->out_size; i++)
+		sum += params->out_wts[i*params->mid_size+neurode]*params->out_error[i];
 
 	/*
 	** apply the derivative of the sigmoid here
@@ -523,21 +733,24 @@ static void adjust_out_wts(nnet_params *params)
 int weight, neurode;
 e_fp learn,delta,alph;
 
-learn = BETA;
+learn = BETA * params->out_rate;
 alph  = ALPHA;
-for (neurode=0; neurode<OUT_SIZE; neurode++)
+for (neurode=0; neurode<params->out_size; neurode++)
 {
-	for (weight=0; weight<MID_SIZE; weight++)
+	e_fp *wts=params->out_wts+neurode*params->mid_size;
+	e_fp *change=params->out_wt_change+neurode*params->mid_size;
+	e_fp *cum_change=params->out_wt_cum_change+neurode*params->mid_size;
+	for (weight=0; weight<params->mid_size; weight++)
 	{
 		/* standard delta rule */
 		delta = learn * params->out_error[neurode] * params->mid_out[weight];
 
 		/* now the momentum term */
-		delta += alph * params->out_wt_change[neurode][weight];
-		params->out_wts[neurode][weight] += delta;
+		delta += alph * change[weight];
+		wts[weight] += delta;
 
 		/* keep track of this pass's cum wt changes for next pass's momentum */
-		params->out_wt_cum_change[neurode][weight] += delta;
+		cum_change[weight] += delta;
 	}
 }
 return;
@@ -555,21 +768,26 @@ static void adjust_mid_wts(int patt,nnet_params *params)
 int weight, neurode;
 e_fp learn,alph,delta;
 
-learn = BETA;
+e_fp *in=params->in_pats+patt*params->in_alloc;
+
+learn = BETA * params->mid_rate;
 alph  = ALPHA;
-for (neurode=0; neurode<MID_SIZE; neurode++)
+for (neurode=0; neurode<params->mid_size; neurode++)
 {
-	for (weight=0; weight<IN_SIZE; weight++)
+	e_fp *wts=params->mid_wts+neurode*params->in_alloc;
+	e_fp *change=params->mid_wt_change+neurode*params->in_alloc;
+	e_fp *cum_change=params->mid_wt_cum_change+neurode*params->in_alloc;
+	for (weight=0; weight<params->in_size; weight++)
 	{
 		/* first the basic delta rule */
-		delta = learn * params->mid_error[neurode] * params->in_pats[patt][weight];
+		delta = learn * params->mid_error[neurode] * in[weight];
 
 		/* with the momentum term */
-		delta += alph * params->mid_wt_change[neurode][weight];
-		params->mid_wts[neurode][weight] += delta;
+		delta += alph * change[weight];
+		wts[weight] += delta;
 
 		/* keep track of this pass's cum wt changes for next pass's momentum */
-		params->mid_wt_cum_change[neurode][weight] += delta;
+		cum_change[weight] += delta;
 	}
 }
 return;
@@ -601,24 +819,24 @@ return;
 **/
 static void move_wt_changes(nnet_params *params)
 {
-int i,j;
+int i,j,k;
 
-for (i = 0; i<MID_SIZE; i++)
-	for (j = 0; j<IN_SIZE; j++)
+for (i = 0; i<params->mid_size; i++)
+	for (j = 0; j<params->in_size; j++)
 	{
-		params->mid_wt_change[i][j] = params->mid_wt_cum_change[i][j];
+		k = i*params->in_alloc+j;
+		params->mid_wt_change[k] = params->mid_wt_cum_change[k];
 		/*
 		** Zero it out for next pass accumulation.
 		*/
-		params->mid_wt_cum_change[i][j] = FPCONST(0.0);
+		params->mid_wt_cum_change[k] = FPCONST(0.0);
 	}
 
-for (i = 0; i<OUT_SIZE; i++)
-	for (j=0; j<MID_SIZE; j++)
-	{
-		params->out_wt_change[i][j] = params->out_wt_cum_change[i][j];
-		params->out_wt_cum_change[i][j] = FPCONST(0.0);
-	}
+for (i = 0; i<params->out_size*params->mid_size; i++)
+{
+	params->out_wt_change[i] = params->out_wt_cum_change[i];
+	params->out_wt_cum_change[i] = FPCONST(0.0);
+}
 
 return;
 }
@@ -683,22 +901,19 @@ static void zero_changes(nnet_params *params)
 {
 int i,j;
 
-for (i = 0; i<MID_SIZE; i++)
+for (i = 0; i<params->mid_size; i++)
 {
-	for (j=0; j<IN_SIZE; j++)
+	for (j=0; j<params->in_size; j++)
 	{
-		params->mid_wt_change[i][j] = FPCONST(0.0);
-		params->mid_wt_cum_change[i][j] = FPCONST(0.0);
+		params->mid_wt_change[i*params->in_alloc+j] = FPCONST(0.0);
+		params->mid_wt_cum_change[i*params->in_alloc+j] = FPCONST(0.0);
 	}
 }
 
-for (i = 0; i< OUT_SIZE; i++)
+for (i = 0; i< params->out_size*params->mid_size; i++)
 {
-	for (j=0; j<MID_SIZE; j++)
-	{
-		params->out_wt_change[i][j] = FPCONST(0.0);
-		params->out_wt_cum_change[i][j] = FPCONST(0.0);
-	}
+	params->out_wt_change[i] = FPCONST(0.0);
+	params->out_wt_cum_change[i] = FPCONST(0.0);
 }
 return;
 }
@@ -712,28 +927,37 @@ return;
 **
 ** NOTE: Had to make alterations to how the random numbers were
 ** created.  -- SG.
+** With init_wts set, the weights are centered instead and scaled by
+** 1/sqrt(fan in), so the sums of large layers stay in the range
+** where the sigmoid still learns.
 **/
 static void randomize_wts(nnet_params *params)
 {
 int neurode,i;
 e_fp value;
+e_fp mid_scale=FPCONST(2.0)/th_sqrt((e_fp)params->in_size);
+e_fp out_scale=FPCONST(2.0)/th_sqrt((e_fp)params->mid_size);
 
-for (neurode = 0; neurode<MID_SIZE; neurode++)
+for (neurode = 0; neurode<params->mid_size; neurode++)
 {
-	for(i=0; i<IN_SIZE; i++)
+	for(i=0; i<params->in_size; i++)
 	{
 	        /* value=(e_fp)abs_randwc(100000L); */
-		value=params->random_values[params->next_ridx++ & 0xff];
-		params->mid_wts[neurode][i] = value;
+		value=params->random_values[params->next_ridx++ % params->rand_size];
+		if (params->init_wts)
+			value=(value-FPCONST(0.5))*mid_scale;
+		params->mid_wts[neurode*params->in_alloc+i] = value;
 	}
 }
-for (neurode=0; neurode<OUT_SIZE; neurode++)
+for (neurode=0; neurode<params->out_size; neurode++)
 {
-	for(i=0; i<MID_SIZE; i++)
+	for(i=0; i<params->mid_size; i++)
 	{
-		value=params->random_values[params->next_ridx++ & 0xff];
+		value=params->random_values[params->next_ridx++ % params->rand_size];
 			/* original code had a bug in nnet init:	value=value/(e_fp)10000.0 - (e_fp) 0.5; */
-		params->out_wts[neurode][i] = value;
+		if (params->init_wts)
+			value=(value-FPCONST(0.5))*out_scale;
+		params->out_wts[neurode*params->mid_size+i] = value;
 	}
 }
 
@@ -812,15 +1036,182 @@ int             neurode, weight;
 }
 */
 
-void fill_preset_nnet(e_u8 *in_data, nnet_params *params) {
-	int in_idx=0,i,m;
-	int inpat_size=params->d_y * params->d_x;
-	for (i=0; i<params->n_in; i++) {
-		for (m=0; m<inpat_size; m++) {
-			params->in_pats[i][m] = in_data[in_idx++] ? FPCONST(0.9):FPCONST(0.1);
-		}
-		for (m=0; m<params->d_out; m++) {
-			params->out_pats[i][m] = in_data[in_idx++] ? FPCONST(1.0):FPCONST(0.0);
-		}
+/*******************
+** batch_setup() **
+********************
+** Lay out the patterns for mini batch training, one column per pattern.
+** Padding columns have zero inputs and are masked out of the errors.
+**/
+static void batch_setup(nnet_params *params)
+{
+int i,p;
+int ba=params->batch_alloc;
+
+for (p=0; p<ba; p++)
+{
+	for (i=0; i<params->in_size; i++)
+		params->b_in[i*ba+p] = (p<params->n_in) ? params->in_pats[p*params->in_alloc+i] : FPCONST(0.0);
+	for (i=0; i<params->out_size; i++)
+		params->b_target[i*ba+p] = (p<params->n_in) ? params->out_pats[p*params->out_size+i] : FPCONST(0.0);
+	params->b_valid[p] = (p<params->n_in) ? FPCONST(1.0) : FPCONST(0.0);
+}
+return;
+}
+
+/*******************
+** batch_sigmoid **
+********************
+** f(x) = 1/(1+exp(-x)) on a vector of values.
+** exp is computed inline so the whole vector is evaluated at once: x = k*ln2 + r with |r| <= ln2/2,
+** exp(r) from its Taylor series, and 2^k built in the exponent bits. The argument is clamped
+** to +-NNET_EXP_LIMIT, where the sigmoid is already 0 or 1 to working precision.
+**/
+#define NNET_EXP_LIMIT FPCONST(80.0)
+#if USE_FP32
+#define NNET_ROUND_MAGIC 12582912.0f		/* 1.5*2^23, adding it rounds to an integer in the low bits */
+#define NNET_EXP_BIAS 127
+#define NNET_EXP_SHIFT 23
+#define NNET_EXP_TERMS 8
+#define NNET_LN2_HI 0.693145751953125f
+#define NNET_LN2_LO 1.428606765330187045e-06f
+#else
+#define NNET_ROUND_MAGIC 6755399441055744.0	/* 1.5*2^52 */
+#define NNET_EXP_BIAS 1023
+#define NNET_EXP_SHIFT 52
+#define NNET_EXP_TERMS 13
+#define NNET_LN2_HI 6.93147180369123816490e-01
+#define NNET_LN2_LO 1.90821492927058770002e-10
+#endif
+#if NNET_GNU_VEC
+static nnet_vec batch_sigmoid(nnet_vec x)
+{
+const nnet_vec lim = (nnet_vec){0} + NNET_EXP_LIMIT;
+const nnet_vec magic = (nnet_vec){0} + NNET_ROUND_MAGIC;
+nnet_vec kf, r, p;
+nnet_ivec m, k;
+int n;
+
+x = -x;
+m = x > lim;
+x = (nnet_vec)((m & (nnet_ivec)lim) | (~m & (nnet_ivec)x));
+m = x < -lim;
+x = (nnet_vec)((m & (nnet_ivec)(-lim)) | (~m & (nnet_ivec)x));
+kf = x * FPCONST(1.44269504088896340736) + magic;
+k = (nnet_ivec)kf - (nnet_ivec)magic;
+kf = kf - magic;
+r = (x - kf * NNET_LN2_HI) - kf * NNET_LN2_LO;
+p = (nnet_vec){0} + FPCONST(1.0);
+for (n = NNET_EXP_TERMS-1; n > 0; n--)
+	p = p * r * (FPCONST(1.0)/(e_fp)n) + FPCONST(1.0);
+p = p * (nnet_vec)((k + NNET_EXP_BIAS) << NNET_EXP_SHIFT);
+return FPCONST(1.0)/(FPCONST(1.0)+p);
+}
+#else
+static nnet_vec batch_sigmoid(nnet_vec x)
+{
+return FPCONST(1.0)/(FPCONST(1.0)+th_exp(-x));
+}
+#endif
+
+/*******************
+** batch_pass() **
+********************
+** One pass of mini batch training over all patterns.
+** The forward pass computes both layers for every pattern as matrix products with the
+** current weights, and the backward pass accumulates the weight changes of all patterns
+** and applies them once, with the momentum of the previous pass.
+** Vectors run over patterns for the layer outputs and errors, and over inputs for the
+** middle layer weights.
+**/
+static void batch_pass(nnet_params *params)
+{
+int i, j, k, p;
+int ba=params->batch_alloc, ia=params->in_alloc;
+int in_size=params->in_size, mid_size=params->mid_size, out_size=params->out_size;
+e_fp mid_learn=BATCH_BETA*params->mid_rate, out_learn=BATCH_BETA*params->out_rate;
+nnet_vec acc, err, sum, mx, e;
+
+/* middle layer, mid_out = f(mid_wts * in) */
+for (j=0; j<mid_size; j++)
+{
+	e_fp *wts=params->mid_wts+j*ia;
+	for (p=0; p<ba; p+=NNET_VLEN)
+	{
+		acc = NNET_VEC(&params->b_in[p]) * wts[0];
+		for (i=1; i<in_size; i++)
+			acc += NNET_VEC(&params->b_in[i*ba+p]) * wts[i];
+		NNET_VEC(&params->b_mid_out[j*ba+p]) = batch_sigmoid(acc);
+	}
+}
+/* output layer, out_out = f(out_wts * mid_out), and the output errors */
+for (k=0; k<out_size; k++)
+{
+	e_fp *wts=params->out_wts+k*mid_size;
+	for (p=0; p<ba; p+=NNET_VLEN)
+	{
+		acc = NNET_VEC(&params->b_mid_out[p]) * wts[0];
+		for (j=1; j<mid_size; j++)
+			acc += NNET_VEC(&params->b_mid_out[j*ba+p]) * wts[j];
+		acc = batch_sigmoid(acc);
+		NNET_VEC(&params->b_out_out[k*ba+p]) = acc;
+		NNET_VEC(&params->b_out_error[k*ba+p]) = (NNET_VEC(&params->b_target[k*ba+p]) - acc) * NNET_VEC(&params->b_valid[p]);
+	}
+}
+/* error measures for check_out_error, as in do_out_error */
+for (p=0; p<params->n_in; p++)
+{
+	e_fp tot = FPCONST(0.0), asum = FPCONST(0.0);
+	for (k=0; k<out_size; k++)
+	{
+		e_fp error = params->b_out_error[k*ba+p];
+		if (error < FPCONST(0.0))
+			error = -error;
+		asum += error;
+		if (error > tot)
+			tot = error;
 	}
+	params->avg_out_error[p] = asum/out_size;
+	params->tot_out_error[p] = tot;
+}
+/* middle layer errors, f'(x) = f(x)(1 - f(x)) times the back propagated output errors */
+for (j=0; j<mid_size; j++)
+	for (p=0; p<ba; p+=NNET_VLEN)
+	{
+		sum = NNET_VEC(&params->b_out_error[p]) * params->out_wts[j];
+		for (k=1; k<out_size; k++)
+			sum += NNET_VEC(&params->b_out_error[k*ba+p]) * params->out_wts[k*mid_size+j];
+		mx = NNET_VEC(&params->b_mid_out[j*ba+p]);
+		NNET_VEC(&params->b_mid_error[j*ba+p]) = mx * (FPCONST(1.0) - mx) * sum;
+	}
+/* output weights, delta rule summed over the batch plus momentum */
+for (k=0; k<out_size; k++)
+	for (j=0; j<mid_size; j++)
+	{
+		e_fp delta = FPCONST(0.0);
+		for (p=0; p<params->n_in; p++)
+			delta += params->b_out_error[k*ba+p] * params->b_mid_out[j*ba+p];
+		delta = out_learn * delta + ALPHA * params->out_wt_change[k*mid_size+j];
+		params->out_wts[k*mid_size+j] += delta;
+		params->out_wt_change[k*mid_size+j] = delta;
+	}
+/* middle weights, vectors over the inputs of a neurode, padding inputs are always 0 */
+for (j=0; j<mid_size; j++)
+{
+	e_fp *error=params->b_mid_error+j*ba;
+	for (i=0; i<ia; i+=NNET_VLEN)
+	{
+		err = NNET_VEC(&params->in_pats[i]) * error[0];
+		for (p=1; p<params->n_in; p++)
+			err += NNET_VEC(&params->in_pats[p*ia+i]) * error[p];
+		e = mid_learn * err + ALPHA * NNET_VEC(&params->mid_wt_change[j*ia+i]);
+		NNET_VEC(&params->mid_wts[j*ia+i]) += e;
+		NNET_VEC(&params->mid_wt_change[j*ia+i]) = e;
+	}
+}
+return;
+}
+
+/* Patterns of a preset are filled in at define, once the topology is known */
+void fill_preset_nnet(e_u8 *in_data, nnet_params *params) {
+	params->in_data=in_data;
 }
@@ -15,43 +15,70 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 
 #include "th_cfg.h"
 
+/* default topology, the letters datasets */
 #define IN_SIZE 35
-#define IN_SIZE_FILLER (5)		/* filler for IN_SIZE array to make sure it is always divided by 8 elements */
-#define IN_SIZE_ALLOC (IN_SIZE + IN_SIZE_FILLER) 
 #define OUT_SIZE 8
 #define MAX_PATTERNS 26
 #define MID_SIZE 8              /* number of neurodes in middle layer */
-#define OUT_SIZE 8              /* number of neurodes in output layer */
 #define MARGIN FPCONST(0.1)              /* how near to 1,0 do we have to come to stop? */
 #define BETA FPCONST(0.09)               /* beta learning constant */
 #define ALPHA FPCONST(0.09)              /* momentum term constant */
+#ifndef BATCH_BETA
+#define BATCH_BETA FPCONST(0.06)         /* beta for mini batch, smaller since changes of all patterns add up in one step */
+#endif
 #define NSTOP FPCONST(0.1)                /* when worst_error less than STOP, training is done */
+#define NNET_ALLOC(n) (((n)+7)/8*8)	/* rows and arrays are rounded up to whole vectors of up to 8 values */
+#define NNET_RAND_SIZE 256			/* random values for the weights with the default init */
+#define NNET_RAND_SIZE_LARGE 65521	/* prime, so rows of large layers do not repeat the same weights */
 #define TRUE 1
 #define FALSE 0
 #define ERR -1
 
 typedef struct nnet_params_s {
-	_ALIGN_VAR(e_fp, in_pats[MAX_PATTERNS][IN_SIZE_ALLOC] );      /* input patterns */
-	_ALIGN_VAR(e_fp, out_pats[MAX_PATTERNS][OUT_SIZE] );    /* desired output patterns */
+	/* patterns, shared by all contexts */
+	e_fp *in_pats;      /* input patterns, n_in rows of in_alloc */
+	e_fp *out_pats;     /* desired output patterns, n_in rows of out_size */
+	e_fp *b_in;         /* mini batch input patterns, transposed, in_size rows of batch_alloc */
+	e_fp *b_target;     /* mini batch desired outputs, transposed, out_size rows of batch_alloc */
+	e_fp *b_valid;      /* mini batch 1 for patterns, 0 for padding */
+	e_fp *pats;         /* block holding the shared arrays */
 
-	_ALIGN_VAR(e_fp,  mid_wts[MID_SIZE][IN_SIZE_ALLOC] );     /* middle layer weights */
-	_ALIGN_VAR(e_fp,  out_wts[OUT_SIZE][MID_SIZE] );    /* output layer weights */
-	_ALIGN_VAR(e_fp,  mid_out[MID_SIZE] );              /* middle layer output */
-	_ALIGN_VAR(e_fp,  out_out[OUT_SIZE] );              /* output layer output */
-	_ALIGN_VAR(e_fp,  mid_error[MID_SIZE] );            /* middle layer errors */
-	_ALIGN_VAR(e_fp,  out_error[OUT_SIZE] );            /* output layer errors */
-	_ALIGN_VAR(e_fp,  mid_wt_change[MID_SIZE][IN_SIZE_ALLOC] ); /* storage for last wt change */
-	_ALIGN_VAR(e_fp,  out_wt_change[OUT_SIZE][MID_SIZE] ); /* storage for last wt change */
-	_ALIGN_VAR(e_fp,  out_wt_cum_change[OUT_SIZE][MID_SIZE] ); /* accumulated wt changes */
-	_ALIGN_VAR(e_fp,  mid_wt_cum_change[MID_SIZE][IN_SIZE_ALLOC] );  /* accumulated wt changes */
-	_ALIGN_VAR(e_fp,  tot_out_error[MAX_PATTERNS] );         /* measure of whether net is done */
+	/* network state, private to each context */
+	e_fp *mid_wts;            /* middle layer weights, mid_size rows of in_alloc */
+	e_fp *out_wts;            /* output layer weights, out_size rows of mid_size */
+	e_fp *mid_out;            /* middle layer output */
+	e_fp *out_out;            /* output layer output */
+	e_fp *mid_error;          /* middle layer errors */
+	e_fp *out_error;          /* output layer errors */
+	e_fp *mid_wt_change;      /* storage for last wt change */
+	e_fp *out_wt_change;      /* storage for last wt change */
+	e_fp *out_wt_cum_change;  /* accumulated wt changes */
+	e_fp *mid_wt_cum_change;  /* accumulated wt changes */
+	e_fp *tot_out_error;      /* measure of whether net is done */
+	e_fp *avg_out_error;      /* average error each pattern */
+	e_fp *b_mid_out;          /* mini batch middle layer output, mid_size rows of batch_alloc */
+	e_fp *b_out_out;          /* mini batch output layer output */
+	e_fp *b_mid_error;        /* mini batch middle layer errors */
+	e_fp *b_out_error;        /* mini batch output layer errors */
+	e_fp *state;              /* block holding the private arrays */
 
 	e_fp *random_values;	/* run dependent values	generated with int math */
+	e_u8 *in_data;	/* preset patterns, input then output bits of each pattern */
 
 	int d_x;
 	int d_y;
 	int d_out;
 	int n_in;
+	int mid_size;	/* neurodes in the middle layer, 0 for MID_SIZE */
+	int in_size;	/* d_x*d_y */
+	int out_size;	/* d_out */
+	int in_alloc;	/* in_size rounded up to whole vectors */
+	int batch_alloc;	/* n_in rounded up to whole vectors */
+	e_s32 init_wts;	/* 0 - weights in 0..1, 1 - centered and scaled by 1/sqrt(fan in) */
+	e_s32 max_passes;	/* 0 - train until learned, otherwise stop after this many passes */
+	e_u32 rand_size;	/* number of random_values */
+	e_fp mid_rate;	/* learning rate scale of each layer, default fan in over fan in */
+	e_fp out_rate;
 	e_s32 gen_ref;
 	e_s32 loops;
 	int iterations; // net iterations required for net to learn
@@ -60,7 +87,6 @@ typedef struct nnet_params_s {
 
 	e_fp  worst_error; /* worst error each pass through the data */
 	e_fp  average_error; /* average error each pass through the data */
-	e_fp  avg_out_error[MAX_PATTERNS]; /* average error each pattern */
 	
 	int ref_iterations;
 	int *ref_passes;
@@ -69,15 +95,23 @@ typedef struct nnet_params_s {
 	e_u32 minbits;
 	e_u32 seed; /* Make sure network randomization is repeatable by passing the seed as a creation parameter */
 	e_u32 next_ridx;
+
+	e_s32 batch; /* train on all patterns at once, one weight update per pass */
+	int ref_batch_iterations;
+	int *ref_batch_passes;
+	intparts ref_batch_average_error;
+	intparts *ref_batch_data;
 } nnet_params;
 
 /* When adding new data, replace "index" with current NUM_DATAS in generated data,	*
  * add proto and call init_preset_NUM_DATAS in init, and increase NUM_DATAS by 1	*/
-#define NUM_DATAS 2
+#define NUM_DATAS 4
 #define EXTRA_PASSES 10
 extern nnet_params presets_nnet[NUM_DATAS];
 void fill_preset_nnet(e_u8 *in_data, nnet_params *params);
 void init_preset_0();
 void init_preset_1();
+void init_preset_2();
+void init_preset_3();
  
 #endif
\ No newline at end of file
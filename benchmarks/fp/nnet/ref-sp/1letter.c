@@ -39,6 +39,21 @@ static int ref_passes[] = {
 	18,
 	18}; /* ref passes */
 
+static intparts ref_batch_err_1[]={
+	{0,-4,0x00000000,0x00aad5ca}/*8.341558277606964111e-02*/}; /* ref batch err */
+
+static intparts ref_batch_average_error_1={0,-4,0x00000000,0x00aad5ca}/*8.341558277606964111e-02*/;
+static int ref_batch_passes[] = {
+	34,
+	26,
+	28,
+	32,
+	27,
+	31,
+	28,
+	27,
+	27}; /* ref batch passes */
+
 void init_preset_1() {
 presets_nnet[1].seed=1936220537;
 presets_nnet[1].ref_data=ref_err_1;
@@ -52,5 +67,9 @@ presets_nnet[1].ref_passes=ref_passes;
 presets_nnet[1].ref_average_error=ref_average_error_1;
 presets_nnet[1].ref_iterations=18;
 presets_nnet[1].next_ridx=0;
+presets_nnet[1].ref_batch_data=ref_batch_err_1;
+presets_nnet[1].ref_batch_passes=ref_batch_passes;
+presets_nnet[1].ref_batch_average_error=ref_batch_average_error_1;
+presets_nnet[1].ref_batch_iterations=27;
 }
 /**** END DATASET ****/
@@ -0,0 +1,177 @@
+/*
+(C) 2014 EEMBC(R).  All rights reserved.                            
+
+All EEMBC Benchmark Software are products of EEMBC 
+and are provided under the terms of the EEMBC Benchmark License Agreements.  
+The EEMBC Benchmark Software are proprietary intellectual properties of EEMBC and its Members 
+and is protected under all applicable laws, including all applicable copyright laws.  
+If you received this EEMBC Benchmark Software without having 
+a currently effective EEMBC Benchmark License Agreement, you must discontinue use. 
+Please refer to LICENSE.md for the specific license agreement that pertains to this Benchmark Software.
+*/
+
+/**** START DATASET ****/
+#include "th_lib.h"
+#include "../nnet.h"
+static intparts ref_err_2[]={
+	{0,-2,0x00000000,0x00829c09}/*2.550967037677764893e-01*/,
+	{0,-2,0x00000000,0x0097db25}/*2.965938150882720947e-01*/,
+	{0,-2,0x00000000,0x0097a926}/*2.962123751640319824e-01*/,
+	{0,-2,0x00000000,0x00ac8c94}/*3.370100259780883789e-01*/,
+	{0,-2,0x00000000,0x00978b88}/*2.959864139556884766e-01*/,
+	{0,-2,0x00000000,0x00ac4839}/*3.364885151386260986e-01*/,
+	{0,-2,0x00000000,0x00abff6d}/*3.359331190586090088e-01*/,
+	{0,-2,0x00000000,0x00c07389}/*3.758814632892608643e-01*/,
+	{0,-2,0x00000000,0x0097e289}/*2.966502010822296143e-01*/,
+	{0,-2,0x00000000,0x00ac4ba9}/*3.365147411823272705e-01*/,
+	{0,-2,0x00000000,0x00ac03b6}/*3.359658122062683105e-01*/,
+	{0,-2,0x00000000,0x00c01eee}/*3.752359747886657715e-01*/,
+	{0,-2,0x00000000,0x00abbcaa}/*3.354237675666809082e-01*/,
+	{0,-2,0x00000000,0x00bfb1e2}/*3.744040131568908691e-01*/,
+	{0,-2,0x00000000,0x00bf5444}/*3.736897706985473633e-01*/,
+	{0,-2,0x00000000,0x00d301ec}/*4.121240377426147461e-01*/,
+	{0,-2,0x00000000,0x0099ad09}/*3.001482784748077393e-01*/,
+	{0,-2,0x00000000,0x00ad6a54}/*3.387018442153930664e-01*/,
+	{0,-2,0x00000000,0x00ad21a8}/*3.381474018096923828e-01*/,
+	{0,-2,0x00000000,0x00c08c6c}/*3.760713338851928711e-01*/,
+	{0,-2,0x00000000,0x00acd8c4}/*3.375912904739379883e-01*/,
+	{0,-2,0x00000000,0x00c01ebb}/*3.752344548702239990e-01*/,
+	{0,-2,0x00000000,0x00bfc062}/*3.745146393775939941e-01*/,
+	{0,-2,0x00000000,0x00d2c075}/*4.116245806217193604e-01*/,
+	{0,-2,0x00000000,0x00acd94c}/*3.375953435897827148e-01*/,
+	{0,-2,0x00000000,0x00bfcf9a}/*3.746307492256164551e-01*/,
+	{0,-2,0x00000000,0x00bf7165}/*3.739120066165924072e-01*/,
+	{0,-2,0x00000000,0x00d21c82}/*4.103737473487854004e-01*/,
+	{0,-2,0x00000000,0x00befeb3}/*3.730369508266448975e-01*/,
+	{0,-2,0x00000000,0x00d185ce}/*4.092239737510681152e-01*/,
+	{0,-2,0x00000000,0x00d112a0}/*4.083452224731445312e-01*/,
+	{0,-2,0x00000000,0x00e3551a}/*4.440086483955383301e-01*/,
+	{0,-2,0x00000000,0x009f5914}/*3.112264871597290039e-01*/,
+	{0,-2,0x00000000,0x00b1c2c0}/*3.471889495849609375e-01*/,
+	{0,-2,0x00000000,0x00b174dd}/*3.465947210788726807e-01*/,
+	{0,-2,0x00000000,0x00c38925}/*3.819057047367095947e-01*/,
+	{0,-2,0x00000000,0x00b12168}/*3.459579944610595703e-01*/,
+	{0,-2,0x00000000,0x00c3131b}/*3.810051381587982178e-01*/,
+	{0,-2,0x00000000,0x00c2b027}/*3.802501857280731201e-01*/,
+	{0,-2,0x00000000,0x00d45f6a}/*4.147904515266418457e-01*/,
+	{0,-2,0x00000000,0x00b10eda}/*3.458164334297180176e-01*/,
+	{0,-2,0x00000000,0x00c2b572}/*3.802905678749084473e-01*/,
+	{0,-2,0x00000000,0x00c252ad}/*3.795370161533355713e-01*/,
+	{0,-2,0x00000000,0x00d3b168}/*4.134628772735595703e-01*/,
+	{0,-2,0x00000000,0x00c1d7cd}/*3.785995543003082275e-01*/,
+	{0,-2,0x00000000,0x00d314fb}/*4.122694432735443115e-01*/,
+	{0,-2,0x00000000,0x00d29e67}/*4.113647639751434326e-01*/,
+	{0,-2,0x00000000,0x00e39a90}/*4.445385932922363281e-01*/,
+	{0,-2,0x00000000,0x00b206e2}/*3.477087616920471191e-01*/,
+	{0,-2,0x00000000,0x00c312de}/*3.810033202171325684e-01*/,
+	{0,-2,0x00000000,0x00c2ae80}/*3.802375793457031250e-01*/,
+	{0,-2,0x00000000,0x00d36e28}/*4.129498004913330078e-01*/,
+	{0,-2,0x00000000,0x00c22fbf}/*3.792705237865447998e-01*/,
+	{0,-2,0x00000000,0x00d2cefc}/*4.117354154586791992e-01*/,
+	{0,-2,0x00000000,0x00d256e6}/*4.108192324638366699e-01*/,
+	{0,-2,0x00000000,0x00e2b6db}/*4.428013265132904053e-01*/,
+	{0,-2,0x00000000,0x00c1c7aa}/*3.784764409065246582e-01*/,
+	{0,-2,0x00000000,0x00d22015}/*4.104010164737701416e-01*/,
+	{0,-2,0x00000000,0x00d1a825}/*4.094859659671783447e-01*/,
+	{0,-2,0x00000000,0x00e1bbec}/*4.408868551254272461e-01*/,
+	{0,-2,0x00000000,0x00d10376}/*4.082295298576354980e-01*/,
+	{0,-2,0x00000000,0x00e0f802}/*4.393921494483947754e-01*/,
+	{0,-2,0x00000000,0x00e06d2a}/*4.383328557014465332e-01*/,
+	{0,-2,0x00000000,0x00f023e3}/*4.690237939357757568e-01*/}; /* ref err */
+
+static intparts ref_average_error_2={0,-2,0x00000000,0x00bfe747}/*3.748113811016082764e-01*/;
+static int ref_passes[] = {
+	10}; /* ref passes */
+
+static intparts ref_batch_err_2[]={
+	{0,-3,0x00000000,0x008721c9}/*1.319648176431655884e-01*/,
+	{0,-3,0x00000000,0x00daadf2}/*2.135541737079620361e-01*/,
+	{0,-3,0x00000000,0x00daadf2}/*2.135541737079620361e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-3,0x00000000,0x00daadf2}/*2.135541737079620361e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00c0e326}/*3.767330050468444824e-01*/,
+	{0,-3,0x00000000,0x00daadf2}/*2.135541737079620361e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00c0e325}/*3.767329752445220947e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00c0e325}/*3.767329752445220947e-01*/,
+	{0,-2,0x00000000,0x00c0e325}/*3.767329752445220947e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-3,0x00000000,0x00daadf3}/*2.135541886091232300e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-1,0x00000000,0x008a37a7}/*5.399116873741149902e-01*/,
+	{0,-3,0x00000000,0x00daadf2}/*2.135541737079620361e-01*/,
+	{0,-2,0x00000000,0x00971d0f}/*2.951435744762420654e-01*/,
+	{0,-2,0x00000000,0x00971d0f}/*2.951435744762420654e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00971d0f}/*2.951435744762420654e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-2,0x00000000,0x00971d0f}/*2.951435744762420654e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-2,0x00000000,0x00eaa93a}/*4.583223462104797363e-01*/,
+	{0,-1,0x00000000,0x008a37a7}/*5.399116873741149902e-01*/,
+	{0,-2,0x00000000,0x00971d10}/*2.951436042785644531e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa938}/*4.583222866058349609e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa938}/*4.583222866058349609e-01*/,
+	{0,-2,0x00000000,0x00eaa938}/*4.583222866058349609e-01*/,
+	{0,-1,0x00000000,0x008a37a7}/*5.399116873741149902e-01*/,
+	{0,-2,0x00000000,0x00c0e324}/*3.767329454421997070e-01*/,
+	{0,-2,0x00000000,0x00eaa938}/*4.583222866058349609e-01*/,
+	{0,-2,0x00000000,0x00eaa938}/*4.583222866058349609e-01*/,
+	{0,-1,0x00000000,0x008a37a7}/*5.399116873741149902e-01*/,
+	{0,-2,0x00000000,0x00eaa938}/*4.583222866058349609e-01*/,
+	{0,-1,0x00000000,0x008a37a7}/*5.399116873741149902e-01*/,
+	{0,-1,0x00000000,0x008a37a7}/*5.399116873741149902e-01*/,
+	{0,-1,0x00000000,0x009f1ab1}/*6.215010285377502441e-01*/}; /* ref batch err */
+
+static intparts ref_batch_average_error_2={0,-2,0x00000000,0x00c0e325}/*3.767329752445220947e-01*/;
+static int ref_batch_passes[] = {
+	10}; /* ref batch passes */
+
+void init_preset_2() {
+presets_nnet[2].seed=17431;
+presets_nnet[2].ref_data=ref_err_2;
+presets_nnet[2].d_x=16;
+presets_nnet[2].d_y=16;
+presets_nnet[2].d_out=8;
+presets_nnet[2].n_in=64;
+presets_nnet[2].loops=1;
+presets_nnet[2].mid_size=1024;
+presets_nnet[2].init_wts=1;
+presets_nnet[2].max_passes=10;
+fill_preset_nnet(NULL,&(presets_nnet[2]));
+presets_nnet[2].ref_passes=ref_passes;
+presets_nnet[2].ref_average_error=ref_average_error_2;
+presets_nnet[2].ref_iterations=10;
+presets_nnet[2].next_ridx=0;
+presets_nnet[2].ref_batch_data=ref_batch_err_2;
+presets_nnet[2].ref_batch_passes=ref_batch_passes;
+presets_nnet[2].ref_batch_average_error=ref_batch_average_error_2;
+presets_nnet[2].ref_batch_iterations=10;
+}
+/**** END DATASET ****/
@@ -0,0 +1,113 @@
+/*
+(C) 2014 EEMBC(R).  All rights reserved.                            
+
+All EEMBC Benchmark Software are products of EEMBC 
+and are provided under the terms of the EEMBC Benchmark License Agreements.  
+The EEMBC Benchmark Software are proprietary intellectual properties of EEMBC and its Members 
+and is protected under all applicable laws, including all applicable copyright laws.  
+If you received this EEMBC Benchmark Software without having 
+a currently effective EEMBC Benchmark License Agreement, you must discontinue use. 
+Please refer to LICENSE.md for the specific license agreement that pertains to this Benchmark Software.
+*/
+
+/**** START DATASET ****/
+#include "th_lib.h"
+#include "../nnet.h"
+static intparts ref_err_3[]={
+	{0,-3,0x00000000,0x009801fe}/*1.484450995922088623e-01*/,
+	{0,-3,0x00000000,0x00f14cf0}/*2.356450557708740234e-01*/,
+	{0,-3,0x00000000,0x00f14c26}/*2.356420457363128662e-01*/,
+	{0,-2,0x00000000,0x00a5456d}/*3.227953016757965088e-01*/,
+	{0,-3,0x00000000,0x00f15312}/*2.356684505939483643e-01*/,
+	{0,-2,0x00000000,0x00a545ab}/*3.227971494197845459e-01*/,
+	{0,-2,0x00000000,0x00a543c7}/*3.227827250957489014e-01*/,
+	{0,-2,0x00000000,0x00d1daa8}/*4.098713397979736328e-01*/,
+	{0,-3,0x00000000,0x00f16a4d}/*2.357570677995681763e-01*/,
+	{0,-2,0x00000000,0x00a54a3f}/*3.228320777416229248e-01*/,
+	{0,-2,0x00000000,0x00a54966}/*3.228256106376647949e-01*/,
+	{0,-2,0x00000000,0x00d1d85f}/*4.098539054393768311e-01*/,
+	{0,-2,0x00000000,0x00a54a51}/*3.228326141834259033e-01*/,
+	{0,-2,0x00000000,0x00d1d57d}/*4.098319113254547119e-01*/,
+	{0,-2,0x00000000,0x00d1d23c}/*4.098070859909057617e-01*/,
+	{0,-2,0x00000000,0x00fe57cd}/*4.967636168003082275e-01*/,
+	{0,-3,0x00000000,0x00f1b79f}/*2.360520213842391968e-01*/,
+	{0,-2,0x00000000,0x00a5614d}/*3.230079710483551025e-01*/,
+	{0,-2,0x00000000,0x00a55f87}/*3.229944407939910889e-01*/,
+	{0,-2,0x00000000,0x00d1dfab}/*4.099095761775970459e-01*/,
+	{0,-2,0x00000000,0x00a560eb}/*3.230050504207611084e-01*/,
+	{0,-2,0x00000000,0x00d1dc38}/*4.098832607269287109e-01*/,
+	{0,-2,0x00000000,0x00d1d91d}/*4.098595678806304932e-01*/,
+	{0,-2,0x00000000,0x00fe4dcd}/*4.966873228549957275e-01*/,
+	{0,-2,0x00000000,0x00a5680f}/*3.230595290660858154e-01*/,
+	{0,-2,0x00000000,0x00d1db06}/*4.098741412162780762e-01*/,
+	{0,-2,0x00000000,0x00d1d79f}/*4.098481833934783936e-01*/,
+	{0,-2,0x00000000,0x00fe444b}/*4.966147840023040771e-01*/,
+	{0,-2,0x00000000,0x00d1d3b0}/*4.098181724548339844e-01*/,
+	{0,-2,0x00000000,0x00fe3c32}/*4.965530037879943848e-01*/,
+	{0,-2,0x00000000,0x00fe3794}/*4.965177774429321289e-01*/,
+	{0,-1,0x00000000,0x00954cae}/*5.832012891769409180e-01*/}; /* ref err */
+
+static intparts ref_average_error_3={0,-2,0x00000000,0x00bb895e}/*3.662824034690856934e-01*/;
+static int ref_passes[] = {
+	4}; /* ref passes */
+
+static intparts ref_batch_err_3[]={
+	{0,-3,0x00000000,0x0096d96a}/*1.473137438297271729e-01*/,
+	{0,-3,0x00000000,0x00f0b02c}/*2.350470423698425293e-01*/,
+	{0,-3,0x00000000,0x00f0b02c}/*2.350470423698425293e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-3,0x00000000,0x00f0b02c}/*2.350470423698425293e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00d22eda}/*4.105136990547180176e-01*/,
+	{0,-3,0x00000000,0x00f0b02c}/*2.350470423698425293e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00d22ed9}/*4.105136692523956299e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00d22ed9}/*4.105136692523956299e-01*/,
+	{0,-2,0x00000000,0x00d22ed9}/*4.105136692523956299e-01*/,
+	{0,-2,0x00000000,0x00ff1a3a}/*4.982469677925109863e-01*/,
+	{0,-3,0x00000000,0x00f0b02e}/*2.350470721721649170e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00d22ed8}/*4.105136394500732422e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00d22ed8}/*4.105136394500732422e-01*/,
+	{0,-2,0x00000000,0x00d22ed8}/*4.105136394500732422e-01*/,
+	{0,-2,0x00000000,0x00ff1a3a}/*4.982469677925109863e-01*/,
+	{0,-2,0x00000000,0x00a54378}/*3.227803707122802734e-01*/,
+	{0,-2,0x00000000,0x00d22ed8}/*4.105136394500732422e-01*/,
+	{0,-2,0x00000000,0x00d22ed8}/*4.105136394500732422e-01*/,
+	{0,-2,0x00000000,0x00ff1a3a}/*4.982469677925109863e-01*/,
+	{0,-2,0x00000000,0x00d22ed8}/*4.105136394500732422e-01*/,
+	{0,-2,0x00000000,0x00ff1a3a}/*4.982469677925109863e-01*/,
+	{0,-2,0x00000000,0x00ff1a3a}/*4.982469677925109863e-01*/,
+	{0,-1,0x00000000,0x009602cd}/*5.859802365303039551e-01*/}; /* ref batch err */
+
+static intparts ref_batch_average_error_3={0,-2,0x00000000,0x00bbb92c}/*3.666471242904663086e-01*/;
+static int ref_batch_passes[] = {
+	4}; /* ref batch passes */
+
+void init_preset_3() {
+presets_nnet[3].seed=28711;
+presets_nnet[3].ref_data=ref_err_3;
+presets_nnet[3].d_x=32;
+presets_nnet[3].d_y=32;
+presets_nnet[3].d_out=8;
+presets_nnet[3].n_in=32;
+presets_nnet[3].loops=1;
+presets_nnet[3].mid_size=2048;
+presets_nnet[3].init_wts=1;
+presets_nnet[3].max_passes=4;
+fill_preset_nnet(NULL,&(presets_nnet[3]));
+presets_nnet[3].ref_passes=ref_passes;
+presets_nnet[3].ref_average_error=ref_average_error_3;
+presets_nnet[3].ref_iterations=4;
+presets_nnet[3].next_ridx=0;
+presets_nnet[3].ref_batch_data=ref_batch_err_3;
+presets_nnet[3].ref_batch_passes=ref_batch_passes;
+presets_nnet[3].ref_batch_average_error=ref_batch_average_error_3;
+presets_nnet[3].ref_batch_iterations=4;
+}
+/**** END DATASET ****/
@@ -264,6 +264,46 @@ static int ref_passes[] = {
 	694,
 	325}; /* ref passes */
 
+static intparts ref_batch_err_0[]={
+	{0,-10,0x00000000,0x00e59990}/*1.751707866787910461e-03*/,
+	{0,-8,0x00000000,0x0080583b}/*3.916767891496419907e-03*/,
+	{0,-8,0x00000000,0x00ed1c9b}/*7.236076053231954575e-03*/,
+	{0,-8,0x00000000,0x00ef158d}/*7.296270225197076797e-03*/,
+	{0,-7,0x00000000,0x008f5646}/*8.748596534132957458e-03*/,
+	{0,-8,0x00000000,0x00bab3e1}/*5.697712767869234085e-03*/,
+	{0,-7,0x00000000,0x00a70b86}/*1.019561849534511566e-02*/,
+	{0,-9,0x00000000,0x00d2460b}/*3.208520589396357536e-03*/,
+	{0,-9,0x00000000,0x00a61a2d}/*2.534519182518124580e-03*/,
+	{0,-9,0x00000000,0x0098717a}/*2.326099667698144913e-03*/,
+	{0,-8,0x00000000,0x0087dadc}/*4.145963117480278015e-03*/,
+	{0,-9,0x00000000,0x00a3a7f8}/*2.497194334864616394e-03*/,
+	{0,-9,0x00000000,0x00d0f4cc}/*3.188419155776500702e-03*/,
+	{0,-9,0x00000000,0x00e7de22}/*3.538020420819520950e-03*/,
+	{0,-6,0x00000000,0x00876bd2}/*1.653090491890907288e-02*/,
+	{0,-8,0x00000000,0x00e3cf85}/*6.952228490263223648e-03*/,
+	{0,-8,0x00000000,0x00d664f6}/*6.542797200381755829e-03*/,
+	{0,-9,0x00000000,0x00f3b9c6}/*3.718958701938390732e-03*/,
+	{0,-9,0x00000000,0x00e20ca6}/*3.449240233749151230e-03*/,
+	{0,-9,0x00000000,0x008b9cef}/*2.130325650796294212e-03*/,
+	{0,-7,0x00000000,0x008699a2}/*8.215339854359626770e-03*/,
+	{0,-8,0x00000000,0x0081ac91}/*3.957339096814393997e-03*/,
+	{0,-8,0x00000000,0x00ef3b56}/*7.300774566829204559e-03*/,
+	{0,-8,0x00000000,0x0091a5fc}/*4.444835707545280457e-03*/,
+	{0,-9,0x00000000,0x00b32402}/*2.733469475060701370e-03*/,
+	{0,-8,0x00000000,0x00df0b6d}/*6.806781981140375137e-03*/}; /* ref batch err */
+
+static intparts ref_batch_average_error_0={0,-8,0x00000000,0x00af4397}/*5.348633509129285812e-03*/;
+static int ref_batch_passes[] = {
+	786,
+	553,
+	777,
+	573,
+	482,
+	479,
+	789,
+	704,
+	806}; /* ref batch passes */
+
 void init_preset_0() {
 presets_nnet[0].seed=21672;
 presets_nnet[0].ref_data=ref_err_0;
@@ -277,5 +317,9 @@ presets_nnet[0].ref_passes=ref_passes;
 presets_nnet[0].ref_average_error=ref_average_error_0;
 presets_nnet[0].ref_iterations=325;
 presets_nnet[0].next_ridx=0;
+presets_nnet[0].ref_batch_data=ref_batch_err_0;
+presets_nnet[0].ref_batch_passes=ref_batch_passes;
+presets_nnet[0].ref_batch_average_error=ref_batch_average_error_0;
+presets_nnet[0].ref_batch_iterations=806;
 }
 /**** END DATASET ****/
@@ -0,0 +1,177 @@
+/*
+(C) 2014 EEMBC(R).  All rights reserved.                            
+
+All EEMBC Benchmark Software are products of EEMBC 
+and are provided under the terms of the EEMBC Benchmark License Agreements.  
+The EEMBC Benchmark Software are proprietary intellectual properties of EEMBC and its Members 
+and is protected under all applicable laws, including all applicable copyright laws.  
+If you received this EEMBC Benchmark Software without having 
+a currently effective EEMBC Benchmark License Agreement, you must discontinue use. 
+Please refer to LICENSE.md for the specific license agreement that pertains to this Benchmark Software.
+*/
+
+/**** START DATASET ****/
+#include "th_lib.h"
+#include "../nnet.h"
+static intparts ref_err_2[]={
+	{0,-2,0x001ec847,0x11624c1d}/*4.809739751592035373e-01*/,
+	{0,-2,0x001be271,0x576567ac}/*4.356959680059115936e-01*/,
+	{0,-2,0x001c4052,0x23ab9c48}/*4.414258335440917058e-01*/,
+	{0,-2,0x001a01a9,0xa4fe90ae}/*4.063514815591230400e-01*/,
+	{0,-2,0x001a974b,0xec24ae37}/*4.154844099127532053e-01*/,
+	{0,-2,0x0019512d,0x489bbd1a}/*3.955796441141089526e-01*/,
+	{0,-2,0x0018b8c7,0x4862d4ea}/*3.862779814620141972e-01*/,
+	{0,-2,0x00188222,0x16d89018}/*3.829426978211372123e-01*/,
+	{0,-2,0x0018d49c,0x1acf91c5}/*3.879766713928599065e-01*/,
+	{0,-2,0x00187a5c,0x06ef99fc}/*3.824682300313779759e-01*/,
+	{0,-2,0x0017b93a,0xa6767560}/*3.706804872143347751e-01*/,
+	{0,-2,0x0017f626,0xb628515f}/*3.743988779908899445e-01*/,
+	{0,-2,0x00174db2,0xc3e4c804}/*3.641173279785336891e-01*/,
+	{0,-2,0x0017919a,0xdb87959f}/*3.682620185703288640e-01*/,
+	{0,-2,0x00171a83,0xd997d58c}/*3.609933495457304797e-01*/,
+	{0,-2,0x001749a4,0xf4d5194f}/*3.638698950711800051e-01*/,
+	{0,-2,0x001939bb,0xa5479bf0}/*3.941487421092793042e-01*/,
+	{0,-2,0x00184902,0x69b9fbec}/*3.794561417088846422e-01*/,
+	{0,-2,0x00180bef,0xde60c967}/*3.757285758648749030e-01*/,
+	{0,-2,0x00181f3a,0xf2e58cff}/*3.769061443365017694e-01*/,
+	{0,-2,0x001763ca,0x450114bf}/*3.654657052869189626e-01*/,
+	{0,-2,0x0017b0e6,0x04b0b050}/*3.701720281412734792e-01*/,
+	{0,-2,0x0016ad1a,0x1b3244b2}/*3.543153062428913147e-01*/,
+	{0,-2,0x00166ec0,0x077eb04c}/*3.505096505348361813e-01*/,
+	{0,-2,0x001727ec,0xe6272eb4}/*3.618118522251549951e-01*/,
+	{0,-2,0x00175884,0xa3f50609}/*3.647777176994116410e-01*/,
+	{0,-2,0x00170925,0x2d184e95}/*3.599331798916208247e-01*/,
+	{0,-2,0x0016568f,0x4e6f5cd8}/*3.490331903426073801e-01*/,
+	{0,-2,0x00166ff8,0x8e400b99}/*3.505841626321682392e-01*/,
+	{0,-2,0x00165aec,0x6f6afcc7}/*3.492995346131916867e-01*/,
+	{0,-2,0x00165f98,0xe0186193}/*3.495847881727282558e-01*/,
+	{0,-2,0x00144a04,0x0432c399}/*3.170175591467852549e-01*/,
+	{0,-2,0x001b3626,0xacf13efa}/*4.251801194086365365e-01*/,
+	{0,-2,0x001a9eed,0xeb77cbec}/*4.159502791873694871e-01*/,
+	{0,-2,0x001a29b3,0x62cc8973}/*4.087952103456224395e-01*/,
+	{0,-2,0x0019d837,0x2eab381a}/*4.038217502355806454e-01*/,
+	{0,-2,0x0019e807,0xbec5121d}/*4.047870028482821181e-01*/,
+	{0,-2,0x0019d33a,0x46999d56}/*4.035173119977647493e-01*/,
+	{0,-2,0x001912d4,0x7133e98c}/*3.917742829795762827e-01*/,
+	{0,-2,0x0018f3f6,0x18a737e2}/*3.898902168992873785e-01*/,
+	{0,-2,0x001a4223,0x5f678642}/*4.102867538150328786e-01*/,
+	{0,-2,0x0018d4ef,0xd0b67f0f}/*3.879966295444185476e-01*/,
+	{0,-2,0x0018867f,0x19091914}/*3.832090134132084547e-01*/,
+	{0,-2,0x00183f85,0x366c7bee}/*3.788769752008523950e-01*/,
+	{0,-2,0x001814a6,0xc5bd4657}/*3.762604647682556425e-01*/,
+	{0,-2,0x00174db8,0x3ee13a32}/*3.641186346111765504e-01*/,
+	{0,-2,0x0016abee,0x3b7fe0c2}/*3.542438107538253833e-01*/,
+	{0,-2,0x00158bf4,0xeb5fe2fa}/*3.366672800616893335e-01*/,
+	{0,-2,0x001a09cc,0xf97ea1ab}/*4.068481861563905677e-01*/,
+	{0,-2,0x0018fb76,0x9fbe5f8c}/*3.903481063839471243e-01*/,
+	{0,-2,0x0018a37a,0xe6f6c526}/*3.849780326373369865e-01*/,
+	{0,-2,0x00178091,0x24127eac}/*3.672221042888661469e-01*/,
+	{0,-2,0x0017d0fc,0xf776be47}/*3.721306244505950267e-01*/,
+	{0,-2,0x0017c799,0x47821f41}/*3.715575407336367264e-01*/,
+	{0,-2,0x00170e03,0x975c6713}/*3.602303484091048946e-01*/,
+	{0,-2,0x00162431,0xcf1dd0f7}/*3.459591410276198764e-01*/,
+	{0,-2,0x0017b676,0xf4fa53ca}/*3.705117599832276065e-01*/,
+	{0,-2,0x00172745,0xf5c2dbbc}/*3.617720508586292905e-01*/,
+	{0,-2,0x0016dc04,0xbea37e36}/*3.571788655953896940e-01*/,
+	{0,-2,0x0014d73f,0xbea4b412}/*3.256377565147100528e-01*/,
+	{0,-2,0x00155c3b,0x353a23c9}/*3.337543506427747553e-01*/,
+	{0,-2,0x0015063b,0x04672a43}/*3.285052817342696829e-01*/,
+	{0,-2,0x00138afc,0xeb61a97a}/*3.053581522605309795e-01*/,
+	{0,-2,0x001225ec,0x5e34c0ce}/*2.835646553021548000e-01*/}; /* ref err */
+
+static intparts ref_average_error_2={0,-2,0x0017fcb7,0x8dfc325b}/*3.747996222089448604e-01*/;
+static int ref_passes[] = {
+	10}; /* ref passes */
+
+static intparts ref_batch_err_2[]={
+	{0,-1,0x0010e8ab,0x0e438666}/*5.284018782223938171e-01*/,
+	{0,-2,0x001e05e7,0x3fb331b5}/*4.691103097982492476e-01*/,
+	{0,-2,0x001efa73,0x30576199}/*4.840362522204713636e-01*/,
+	{0,-2,0x001b4424,0xd91b54fb}/*4.260341758902794207e-01*/,
+	{0,-2,0x001e6e88,0x3b0ffb13}/*4.754963471204273762e-01*/,
+	{0,-2,0x001b6d75,0x4b63171c}/*4.285557972146862848e-01*/,
+	{0,-2,0x001b4c23,0xd063ebfa}/*4.265222106038774053e-01*/,
+	{0,-2,0x001874c8,0xbafd7984}/*3.821279359889546701e-01*/,
+	{0,-2,0x001e8798,0xcbb93d51}/*4.770261754501535223e-01*/,
+	{0,-2,0x001b79fb,0x3858807e}/*4.293201494456367895e-01*/,
+	{0,-2,0x001b3e0d,0x3e0d12e4}/*4.256623369185901229e-01*/,
+	{0,-2,0x001872fa,0x64cda07c}/*3.820177063375991278e-01*/,
+	{0,-2,0x001b401e,0x8566c81d}/*4.257885267971930898e-01*/,
+	{0,-2,0x00187021,0x160708a4}/*3.818438258277956354e-01*/,
+	{0,-2,0x001841fb,0x42c615d5}/*3.790271904075244724e-01*/,
+	{0,-2,0x00157f53,0x01eafeb4}/*3.358962553720445943e-01*/,
+	{0,-2,0x001e4ef5,0x32da87f5}/*4.735692021005200592e-01*/,
+	{0,-2,0x001b43a0,0xe893972a}/*4.260027190451746160e-01*/,
+	{0,-2,0x001b6163,0x7d34e335}/*4.278191302033065857e-01*/,
+	{0,-2,0x0018583c,0x7627e614}/*3.803855089059606787e-01*/,
+	{0,-2,0x001b52d9,0x88f82c84}/*4.269317472068865360e-01*/,
+	{0,-2,0x00186c51,0x446ab819}/*3.816111724980842390e-01*/,
+	{0,-2,0x0017f353,0x508ab63c}/*3.742264067212521805e-01*/,
+	{0,-2,0x00150c7e,0x76ad008d}/*3.288875731414087622e-01*/,
+	{0,-2,0x001b3ecb,0xd35d2743}/*4.257077755070108327e-01*/,
+	{0,-2,0x00186685,0x7120d3a4}/*3.812574009673943554e-01*/,
+	{0,-2,0x00186fb3,0xc269360c}/*3.818177603287444821e-01*/,
+	{0,-2,0x00154a2c,0x00aa8790}/*3.326520926003633249e-01*/,
+	{0,-2,0x0018410d,0xd9f549d7}/*3.789705875871311469e-01*/,
+	{0,-2,0x00154654,0xa49bd04f}/*3.324176414018937264e-01*/,
+	{0,-2,0x00159975,0x14698360}/*3.374912928903111009e-01*/,
+	{0,-2,0x0011b000,0x789e4513}/*2.763672998344912091e-01*/,
+	{0,-2,0x001e0aa1,0x6fd8967a}/*4.693988411184829568e-01*/,
+	{0,-2,0x001b407d,0x137ceedd}/*4.258110704720204365e-01*/,
+	{0,-2,0x001b3f1f,0x7316eefc}/*4.257277130052299352e-01*/,
+	{0,-2,0x0018720e,0x3a7b4182}/*3.819614001377190649e-01*/,
+	{0,-2,0x001b6646,0x1429ef13}/*4.281172940170431818e-01*/,
+	{0,-2,0x0018641e,0x251dcbf7}/*3.811107027497082078e-01*/,
+	{0,-2,0x00186a8d,0x64fb6d50}/*3.815034376290968865e-01*/,
+	{0,-2,0x00159df6,0xa37945e5}/*3.377663227484773434e-01*/,
+	{0,-2,0x001b73ac,0xb19190b1}/*4.289352163380142913e-01*/,
+	{0,-2,0x001870d0,0x4c65a408}/*3.818855997147356796e-01*/,
+	{0,-2,0x00186f39,0x5d9ef996}/*3.817885793941057093e-01*/,
+	{0,-2,0x0015a9aa,0x8e7e27cc}/*3.384806052714537383e-01*/,
+	{0,-2,0x00186c42,0xf160f51d}/*3.816077573026904202e-01*/,
+	{0,-2,0x0015583e,0x84e6ad88}/*3.335109994756852991e-01*/,
+	{0,-2,0x00151577,0xc841fcc0}/*3.294352965967384250e-01*/,
+	{0,-2,0x0011dcdf,0x3a55ef68}/*2.791059560474793422e-01*/,
+	{0,-2,0x001b12f3,0x8ee97f28}/*4.230317016244833361e-01*/,
+	{0,-2,0x0018791e,0x5fae34e6}/*3.823924955730276798e-01*/,
+	{0,-2,0x00185841,0x0db9d2e8}/*3.803866037408583090e-01*/,
+	{0,-2,0x001515d8,0xbfcfec30}/*3.294584153333657284e-01*/,
+	{0,-2,0x00181d32,0x07fd249d}/*3.767819479003920446e-01*/,
+	{0,-2,0x0015b156,0x574b0aa2}/*3.389488079521162378e-01*/,
+	{0,-2,0x0015576c,0xd20f058e}/*3.334610034326822570e-01*/,
+	{0,-2,0x0012474c,0xe46bc481}/*2.856018286393649519e-01*/,
+	{0,-2,0x00185175,0x79c802eb}/*3.799718560476736395e-01*/,
+	{0,-2,0x0015b0ba,0xb3b11b30}/*3.389117007067623533e-01*/,
+	{0,-2,0x0015aa50,0x4923a9dd}/*3.385201181651192326e-01*/,
+	{0,-2,0x0011e271,0x055b2ba9}/*2.794458916002278692e-01*/,
+	{0,-2,0x0014e7a8,0x53fce0cd}/*3.266392536347780262e-01*/,
+	{0,-2,0x0012966f,0xd784ad9f}/*2.904319386168143224e-01*/,
+	{0,-2,0x0011adf8,0x29f07666}/*2.762432488978902034e-01*/,
+	{0,-3,0x001d3571,0x4c765d9d}/*2.281934378959079857e-01*/}; /* ref batch err */
+
+static intparts ref_batch_average_error_2={0,-2,0x0018514a,0xeb50f9fd}/*3.799617097864994020e-01*/;
+static int ref_batch_passes[] = {
+	10}; /* ref batch passes */
+
+void init_preset_2() {
+presets_nnet[2].seed=17431;
+presets_nnet[2].ref_data=ref_err_2;
+presets_nnet[2].d_x=16;
+presets_nnet[2].d_y=16;
+presets_nnet[2].d_out=8;
+presets_nnet[2].n_in=64;
+presets_nnet[2].loops=1;
+presets_nnet[2].mid_size=1024;
+presets_nnet[2].init_wts=1;
+presets_nnet[2].max_passes=10;
+fill_preset_nnet(NULL,&(presets_nnet[2]));
+presets_nnet[2].ref_passes=ref_passes;
+presets_nnet[2].ref_average_error=ref_average_error_2;
+presets_nnet[2].ref_iterations=10;
+presets_nnet[2].next_ridx=0;
+presets_nnet[2].ref_batch_data=ref_batch_err_2;
+presets_nnet[2].ref_batch_passes=ref_batch_passes;
+presets_nnet[2].ref_batch_average_error=ref_batch_average_error_2;
+presets_nnet[2].ref_batch_iterations=10;
+}
+/**** END DATASET ****/
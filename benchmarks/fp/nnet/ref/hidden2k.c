@@ -0,0 +1,113 @@
+/*
+(C) 2014 EEMBC(R).  All rights reserved.                            
+
+All EEMBC Benchmark Software are products of EEMBC 
+and are provided under the terms of the EEMBC Benchmark License Agreements.  
+The EEMBC Benchmark Software are proprietary intellectual properties of EEMBC and its Members 
+and is protected under all applicable laws, including all applicable copyright laws.  
+If you received this EEMBC Benchmark Software without having 
+a currently effective EEMBC Benchmark License Agreement, you must discontinue use. 
+Please refer to LICENSE.md for the specific license agreement that pertains to this Benchmark Software.
+*/
+
+/**** START DATASET ****/
+#include "th_lib.h"
+#include "../nnet.h"
+static intparts ref_err_3[]={
+	{0,-2,0x0014e703,0x80fd3d62}/*3.265999564800577959e-01*/,
+	{0,-2,0x001351d3,0xd20a7dd4}/*3.018693495923490122e-01*/,
+	{0,-2,0x0015b4bd,0x5cd14ca4}/*3.391564756795537594e-01*/,
+	{0,-2,0x0014c1e1,0xda47223c}/*3.243336326236521128e-01*/,
+	{0,-2,0x0014fa05,0x672e2b84}/*3.277600772495861126e-01*/,
+	{0,-2,0x00138f3c,0x08516bd7}/*3.056173402052854704e-01*/,
+	{0,-2,0x0013eb53,0x7c9ca438}/*3.112381665146730647e-01*/,
+	{0,-2,0x0014e532,0xbfd141ae}/*3.264891503540877649e-01*/,
+	{0,-2,0x00164aa0,0xe0aa9830}/*3.483049577720320755e-01*/,
+	{0,-2,0x001556d3,0xed30be55}/*3.334245506584683771e-01*/,
+	{0,-2,0x00155914,0x275fc31a}/*3.335619339477929879e-01*/,
+	{0,-2,0x00152a7b,0xd1447f7f}/*3.307179969433419742e-01*/,
+	{0,-2,0x0013d5c1,0x4fc69421}/*3.099215773639248384e-01*/,
+	{0,-2,0x0014e902,0x864dd814}/*3.267217933238282246e-01*/,
+	{0,-2,0x0014bf38,0x8715fb15}/*3.241711920926929058e-01*/,
+	{0,-2,0x0014bac1,0x5f9f450f}/*3.238986429033312020e-01*/,
+	{0,-2,0x00177686,0x22ff1b85}/*3.666091291201428182e-01*/,
+	{0,-2,0x00166000,0x7c8a3843}/*3.496094909868398548e-01*/,
+	{0,-2,0x001623a2,0x88ddac4c}/*3.459249817448764031e-01*/,
+	{0,-2,0x00161dc6,0x56f60577}/*3.455673073986739730e-01*/,
+	{0,-2,0x0015f344,0x52a4df34}/*3.429728324003804563e-01*/,
+	{0,-2,0x00156ee5,0x895b07f2}/*3.348935929644759613e-01*/,
+	{0,-2,0x00154b00,0x7b81c53e}/*3.327027517435289239e-01*/,
+	{0,-2,0x0013c20b,0x939318ad}/*3.087185803564221342e-01*/,
+	{0,-2,0x00158203,0xab753462}/*3.360604452507854889e-01*/,
+	{0,-2,0x00152b94,0x93ee6d09}/*3.307849354402639386e-01*/,
+	{0,-2,0x0014f8a2,0x9a4c2adc}/*3.276754862605864016e-01*/,
+	{0,-2,0x0013ab2d,0x09938f69}/*3.073227494735336074e-01*/,
+	{0,-2,0x00148836,0xfa50e58c}/*3.208138889782155001e-01*/,
+	{0,-2,0x001364e0,0x961a0cfb}/*3.030320611798768549e-01*/,
+	{0,-2,0x0012d0fc,0x5a0d91b2}/*2.940054778503294886e-01*/,
+	{0,-2,0x0012978f,0x3c5b7e8b}/*2.905004586627703556e-01*/}; /* ref err */
+
+static intparts ref_average_error_3={0,-2,0x0014dca9,0x896f00ae}/*3.259681551098861929e-01*/;
+static int ref_passes[] = {
+	4}; /* ref passes */
+
+static intparts ref_batch_err_3[]={
+	{0,-2,0x0013cfc2,0xbc156119}/*3.095557057145171265e-01*/,
+	{0,-2,0x0012c0f0,0x5ccdedc3}/*2.930260568898256923e-01*/,
+	{0,-2,0x0015f191,0xd9dbae1b}/*3.428692462464099644e-01*/,
+	{0,-2,0x00152a23,0xd601ad53}/*3.306970205219005865e-01*/,
+	{0,-2,0x0015ae62,0x10e091a9}/*3.387684979263903551e-01*/,
+	{0,-2,0x001400a1,0x41b411ea}/*3.125384465822934610e-01*/,
+	{0,-2,0x0014a1da,0x199a15fc}/*3.223786592501196591e-01*/,
+	{0,-2,0x0015e07d,0x5127a448}/*3.418267529037319896e-01*/,
+	{0,-2,0x00170d7d,0x1166d680}/*3.601982755602435304e-01*/,
+	{0,-2,0x00162ae5,0x491e9f46}/*3.463681425150649806e-01*/,
+	{0,-2,0x00168dfe,0x6ef84371}/*3.524166186990021488e-01*/,
+	{0,-2,0x0016168c,0xd0cbf7ed}/*3.451263464957026739e-01*/,
+	{0,-2,0x001481a3,0xf89d6978}/*3.204126289253035331e-01*/,
+	{0,-2,0x0015f4d1,0xe313f9b3}/*3.430676190909267009e-01*/,
+	{0,-2,0x00165b31,0x384f0aae}/*3.493159341707422483e-01*/,
+	{0,-2,0x0016674b,0x939a428d}/*3.500546399527955654e-01*/,
+	{0,-2,0x0016e275,0x9a4e7928}/*3.575719839954154544e-01*/,
+	{0,-2,0x0015fac6,0xd27a815d}/*3.434311919645745559e-01*/,
+	{0,-2,0x00160675,0xdb0b3a27}/*3.441443099117428850e-01*/,
+	{0,-2,0x001648f5,0x134a20c5}/*3.482029617666849153e-01*/,
+	{0,-2,0x00161a86,0xa1333fe5}/*3.453690122814790375e-01*/,
+	{0,-2,0x0015cb9e,0x57297394}/*3.405528880301116335e-01*/,
+	{0,-2,0x001679ad,0xbe9be1cd}/*3.511766778388192844e-01*/,
+	{0,-2,0x00152083,0x0b364096}/*3.301093682757793024e-01*/,
+	{0,-2,0x001578ba,0xb0b15d63}/*3.354937291637353769e-01*/,
+	{0,-2,0x0016084e,0x16edd105}/*3.442568992534378869e-01*/,
+	{0,-2,0x0015d365,0x821feb81}/*3.410276194332980126e-01*/,
+	{0,-2,0x00151983,0xd331ec98}/*3.296823084307987095e-01*/,
+	{0,-2,0x0015aaf6,0xb4ba8457}/*3.385597958495671356e-01*/,
+	{0,-2,0x00151015,0xc24021bc}/*3.291067502000506462e-01*/,
+	{0,-2,0x0014d4d6,0xeeb982f4}/*3.254906970305875280e-01*/,
+	{0,-2,0x001516b8,0x92d2a645}/*3.295117791954889630e-01*/}; /* ref batch err */
+
+static intparts ref_batch_average_error_3={0,-2,0x001595a9,0x77d60357}/*3.372596426270794701e-01*/;
+static int ref_batch_passes[] = {
+	4}; /* ref batch passes */
+
+void init_preset_3() {
+presets_nnet[3].seed=28711;
+presets_nnet[3].ref_data=ref_err_3;
+presets_nnet[3].d_x=32;
+presets_nnet[3].d_y=32;
+presets_nnet[3].d_out=8;
+presets_nnet[3].n_in=32;
+presets_nnet[3].loops=1;
+presets_nnet[3].mid_size=2048;
+presets_nnet[3].init_wts=1;
+presets_nnet[3].max_passes=4;
+fill_preset_nnet(NULL,&(presets_nnet[3]));
+presets_nnet[3].ref_passes=ref_passes;
+presets_nnet[3].ref_average_error=ref_average_error_3;
+presets_nnet[3].ref_iterations=4;
+presets_nnet[3].next_ridx=0;
+presets_nnet[3].ref_batch_data=ref_batch_err_3;
+presets_nnet[3].ref_batch_passes=ref_batch_passes;
+presets_nnet[3].ref_batch_average_error=ref_batch_average_error_3;
+presets_nnet[3].ref_batch_iterations=4;
+}
+/**** END DATASET ****/
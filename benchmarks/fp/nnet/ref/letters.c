@@ -264,6 +264,46 @@ static int ref_passes[] = {
 	363,
 	453}; /* ref passes */
 
+static intparts ref_batch_err_0[]={
+	{0,-7,0x001cf6bc,0x55cc7d97}/*1.414248596989757349e-02*/,
+	{0,-8,0x001f0291,0x246af9a0}/*7.570807420675867982e-03*/,
+	{0,-8,0x001d5caa,0x1e18c706}/*7.168449899426004510e-03*/,
+	{0,-7,0x001a796f,0x0f2b9b40}/*1.292692914053150677e-02*/,
+	{0,-8,0x001c1fc1,0xa0eb38de}/*6.866222726513463923e-03*/,
+	{0,-8,0x001be621,0xfc4f4602}/*6.811268573942099239e-03*/,
+	{0,-8,0x001255d1,0xaf9641bb}/*4.476374707693182679e-03*/,
+	{0,-6,0x0012ecb2,0xa613fb81}/*1.848105562839519669e-02*/,
+	{0,-8,0x001b4196,0x3f7d3296}/*6.654345422998494616e-03*/,
+	{0,-7,0x00144ec0,0x7e58b082}/*9.915832381999448858e-03*/,
+	{0,-7,0x0012f533,0x87a1b820}/*9.256746842051966073e-03*/,
+	{0,-6,0x00129d51,0xa5efecce}/*1.817824912357651063e-02*/,
+	{0,-6,0x001007ae,0x1699882a}/*1.565429699838475491e-02*/,
+	{0,-5,0x0011002b,0x7b0bbbee}/*3.320442082428330666e-02*/,
+	{0,-6,0x001bc3cb,0x062467a0}/*2.711407876004268136e-02*/,
+	{0,-6,0x00130cde,0xb5546e6e}/*1.860378247975662952e-02*/,
+	{0,-8,0x001ddf32,0x668faf66}/*7.292935254536425313e-03*/,
+	{0,-7,0x00110109,0xfe9c4eae}/*8.302763064001208310e-03*/,
+	{0,-8,0x00116295,0x86a5cf45}/*4.244407735644111120e-03*/,
+	{0,-9,0x00113420,0x1ab8e88d}/*2.100050643801648718e-03*/,
+	{0,-6,0x001ee673,0xe9ebcd40}/*3.017598262063114767e-02*/,
+	{0,-9,0x001f5b1b,0xada3a733}/*3.827623423707482344e-03*/,
+	{0,-7,0x001dd947,0x17212835}/*1.457458056770031575e-02*/,
+	{0,-10,0x0018375e,0x49ef9ee3}/*1.478044585150266972e-03*/,
+	{0,-8,0x0018badf,0x2724c3d0}/*6.037589732202655601e-03*/,
+	{0,-8,0x001e7f37,0xb74700d7}/*7.445542946186565168e-03*/}; /* ref batch err */
+
+static intparts ref_batch_average_error_0={0,-7,0x0017d3fc,0xc521e8ba}/*1.163480259514347928e-02*/;
+static int ref_batch_passes[] = {
+	772,
+	754,
+	903,
+	927,
+	648,
+	737,
+	800,
+	587,
+	542}; /* ref batch passes */
+
 void init_preset_0() {
 presets_nnet[0].seed=21672;
 presets_nnet[0].ref_data=ref_err_0;
@@ -277,5 +317,9 @@ presets_nnet[0].ref_passes=ref_passes;
 presets_nnet[0].ref_average_error=ref_average_error_0;
 presets_nnet[0].ref_iterations=453;
 presets_nnet[0].next_ridx=0;
+presets_nnet[0].ref_batch_data=ref_batch_err_0;
+presets_nnet[0].ref_batch_passes=ref_batch_passes;
+presets_nnet[0].ref_batch_average_error=ref_batch_average_error_0;
+presets_nnet[0].ref_batch_iterations=542;
 }
 /**** END DATASET ****/
@@ -124,6 +124,37 @@ int al_thread_create(al_thread_t * thread, void *(*start_routine)(void *), void
 int al_thread_join(al_thread_t thread, void **thread_return);
 #endif /* of not using native pthread */
 
+/* Atomic primitives
+	Used by the harness for lock free scheduling and statistics.
+	al_atomic_add returns the value before the add, al_atomic_cas returns non zero if the swap took place.
+
+	Porting:
+	If the toolchain does not provide gcc style __sync builtins, define HAVE_ATOMIC_BUILTINS to 0 
+	and a mutex protected implementation from <al_smp.c> will be used instead.
+*/
+#if HAVE_ATOMIC_BUILTINS
+	#define al_atomic_add(_ptr,_val) __sync_fetch_and_add((_ptr),(_val))
+	#define al_atomic_cas(_ptr,_old,_new) __sync_bool_compare_and_swap((_ptr),(_old),(_new))
+	#define al_memory_barrier() __sync_synchronize()
+#else
+	#define al_atomic_add(_ptr,_val) al_atomic_add_locked((void *)(_ptr),(size_t)(_val),sizeof(*(_ptr)))
+	#define al_atomic_cas(_ptr,_old,_new) al_atomic_cas_locked((void *)(_ptr),(size_t)(_old),(size_t)(_new),sizeof(*(_ptr)))
+	#define al_memory_barrier() al_memory_barrier_locked()
+/* Function: al_atomic_add_locked
+	Add val to the integer of size sz at ptr, and return the previous value.
+*/
+size_t al_atomic_add_locked(void *ptr, size_t val, size_t sz);
+/* Function: al_atomic_cas_locked
+	Replace the integer of size sz at ptr with newval if it is equal to oldval. 
+	Return non zero if the value was replaced.
+*/
+int al_atomic_cas_locked(void *ptr, size_t oldval, size_t newval, size_t sz);
+/* Function: al_memory_barrier_locked
+	Full memory barrier.
+*/
+void al_memory_barrier_locked(void);
+#endif
+
 /* Function : al_timer_create
 	TODO : Create a new timer.
 	The timer will signal after _millisecs_ passed.  
@@ -146,11 +177,18 @@ typedef struct mith_iextend_s {
 	Extended information for new threads created
 */
 typedef struct mith_textend_s {
-	/* item, kernel and sub_item ids, currently to be used for affinity */
+	/* item, kernel, context and sub_item ids, currently to be used for affinity */
 	e_u32	item_id;
 	e_u32	kernel_id;
 	e_u32	sub_item_id;
+	e_u32	context_id;
 } mith_textend;
+/* Function: al_item_textend
+	Fill the item, kernel and context ids of tex with those of the work item 
+	executing on the calling thread, as passed to <al_item_setaffinity>, and set its sub_item_id.
+	Work items call it before <al_thread_create_ex>, so sub threads are placed next to the item.
+*/
+void al_item_textend(mith_textend *tex, e_u32 sub_item_id);
 /* Function: al_thread_create_ex
 	Create a new thread, potentially setting affinity.
 	This function is used by some work items to allow affinity on sub threads created by the work item.
@@ -190,8 +228,30 @@ typedef struct hardware_info_s {
 	char *description_string;
 	/* this structure may be extended with info regarding specific processor capabilities,
 	   and other platform specific information */
+	int affinity;			/* placement policy for work items, see <al_affinity_t> */
+	int num_cpus;			/* number of logical processors in cpu_order */
+	int *cpu_order;			/* logical processors in placement order for the selected policy */
+	int *cpu_node;			/* numa node of each logical processor, indexed by processor number */
 } hardware_info_t;
 
+/* Enum: al_affinity_t
+	Placement policies for work items, selected with "affinity=<policy>" in the hardware description (-P=).
+	All policies other then the default require the processor topology (see HAVE_SYSFS_TOPOLOGY).
+
+	AL_AFFINITY_DEFAULT - (default) context n runs on processor n % num_processors.
+	AL_AFFINITY_COMPACT - (compact) fill all hardware threads of a core, then all cores of a package, then the next package.
+	AL_AFFINITY_SCATTER - (scatter) spread contexts round robin across packages, using hardware thread siblings last.
+	AL_AFFINITY_PHYSCORE - (physcore) one context per physical core, hardware thread siblings are never used.
+	AL_AFFINITY_STICKY - (sticky) executions of the same work item always run on the same physical core, regardless of context.
+*/
+typedef enum {
+	AL_AFFINITY_DEFAULT=0,
+	AL_AFFINITY_COMPACT,
+	AL_AFFINITY_SCATTER,
+	AL_AFFINITY_PHYSCORE,
+	AL_AFFINITY_STICKY
+} al_affinity_t;
+
 /* Variable: hardware_info
 	Global value, set before any threads are created.
 	Once actual execution starts, this structure must be read only 
@@ -200,6 +260,7 @@ extern hardware_info_t hardware_info;
 
 /* Function: al_set_hardware_info
 	Set hardware specific information from a string.
+	Recognized flags are "cores=<n>" and "affinity=<policy>" (see <al_affinity_t>).
 
 	Porting:
 	This function must be ported to specific hardware if intending to use 
@@ -99,6 +99,12 @@ extern "C" {
 	void	*al_fcreate(const char *filename, const char *mode, char *data, size_t size) ;
 	int 	al_unlink   (const char *filename);
 
+	/* Shared input mappings (see <mith_input_share>) */
+	void	*al_shared_map(const void *src, size_t len, int *handle);
+	void	al_shared_unmap(void *p, size_t len, int handle);
+	void	*al_private_map(const void *shared, size_t len, int handle);
+	void	al_private_unmap(void *p, size_t len, int handle);
+
 	typedef struct intparts_s {
 		e_s8 sign;
 		e_s16 exp;
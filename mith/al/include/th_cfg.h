@@ -671,9 +671,39 @@ different tool chain configurations.
 #ifndef HAVE_PTHREAD_SELF
 #define HAVE_PTHREAD_SELF 0
 #endif
+#ifndef HAVE_SYSFS_TOPOLOGY
+#define HAVE_SYSFS_TOPOLOGY 0
+#endif
 #ifndef USE_SINGLE_CONTEXT
 #define USE_SINGLE_CONTEXT 0
 #endif
+/* Define HAVE_ATOMIC_BUILTINS to 0 if the toolchain does not support gcc style __sync builtins.
+	The harness will then fall back to a mutex protected implementation (see <al_smp.c>) */
+#ifndef HAVE_ATOMIC_BUILTINS
+#if defined(__GNUC__)
+#define HAVE_ATOMIC_BUILTINS 1
+#else
+#define HAVE_ATOMIC_BUILTINS 0
+#endif
+#endif
+/* Define HAVE_MMAP_COW to 1 on linux to back shared inputs with a memfd mapping.
+	The shared view is then mapped read only, and private copies are copy on write with page granularity. */
+#ifndef HAVE_MMAP_COW
+#define HAVE_MMAP_COW 0
+#endif
+/* Define HAVE_THREAD_LOCAL to 0 if the toolchain does not support thread local storage with __thread. */
+#ifndef HAVE_THREAD_LOCAL
+#if defined(__GNUC__)
+#define HAVE_THREAD_LOCAL 1
+#else
+#define HAVE_THREAD_LOCAL 0
+#endif
+#endif
+#if HAVE_THREAD_LOCAL
+#define TH_THREAD_LOCAL __thread
+#else
+#define TH_THREAD_LOCAL
+#endif
 #if USE_SINGLE_CONTEXT
 #define MAX_CONTEXTS 1
 #undef HAVE_PTHREAD
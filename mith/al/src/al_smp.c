@@ -18,12 +18,22 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 	Also see pthread documentation for expected behavior of this API which is a subset of pthreads API.
 */
 
+#if (HAVE_PTHREAD_SETAFFINITY_NP==1) && !defined(_GNU_SOURCE)
+/* cpu_set_t and pthread_setaffinity_np are gnu extensions */
+#define _GNU_SOURCE
+#endif
 #if (HAVE_PTHREAD==1)
 #include <pthread.h>
 #endif
 #if HAVE_PTHREAD_SETAFFINITY_NP==1
 #include <sched.h>
 #endif
+#if HAVE_SYSFS_TOPOLOGY
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 #include "th_lib.h"
 #include "al_smp.h"
 
@@ -132,16 +142,285 @@ int al_thread_join(al_thread_t al_thread, void **thread_return) {
 }
 #endif
 
+#if !HAVE_ATOMIC_BUILTINS
+/* Fallback for toolchains without atomic builtins: serialize all atomic operations on a single mutex. */
+static al_mutex_t al_atomic_mutex;
+static int al_atomic_mutex_ready=0;
+
+static void al_atomic_lock(void) {
+	/* first use happens from the main thread while setting up the workload */
+	if (!al_atomic_mutex_ready) {
+		al_mutex_init(&al_atomic_mutex);
+		al_atomic_mutex_ready=1;
+	}
+	al_mutex_lock(&al_atomic_mutex);
+}
+
+static size_t al_atomic_read(void *ptr, size_t sz) {
+	switch (sz) {
+		case 1: return *(e_u8 *)ptr;
+		case 2: return *(e_u16 *)ptr;
+		case 4: return *(e_u32 *)ptr;
+		default: return *(size_t *)ptr;
+	}
+}
+
+static void al_atomic_write(void *ptr, size_t val, size_t sz) {
+	switch (sz) {
+		case 1: *(e_u8 *)ptr=(e_u8)val; break;
+		case 2: *(e_u16 *)ptr=(e_u16)val; break;
+		case 4: *(e_u32 *)ptr=(e_u32)val; break;
+		default: *(size_t *)ptr=val; break;
+	}
+}
+
+size_t al_atomic_add_locked(void *ptr, size_t val, size_t sz) {
+	size_t prev;
+	al_atomic_lock();
+	prev=al_atomic_read(ptr,sz);
+	al_atomic_write(ptr,prev+val,sz);
+	al_mutex_unlock(&al_atomic_mutex);
+	return prev;
+}
+
+int al_atomic_cas_locked(void *ptr, size_t oldval, size_t newval, size_t sz) {
+	int swapped=0;
+	al_atomic_lock();
+	if (al_atomic_read(ptr,sz)==oldval) {
+		al_atomic_write(ptr,newval,sz);
+		swapped=1;
+	}
+	al_mutex_unlock(&al_atomic_mutex);
+	return swapped;
+}
+
+void al_memory_barrier_locked(void) {
+	al_atomic_lock();
+	al_mutex_unlock(&al_atomic_mutex);
+}
+#endif
+
+#if HAVE_SYSFS_TOPOLOGY
+/* Topology discovery from sysfs (linux).
+	AL_SYSFS_ROOT can be redefined to read a captured topology from another location. */
+#ifndef AL_SYSFS_ROOT
+#define AL_SYSFS_ROOT "/sys/devices/system"
+#endif
+#define AL_MAX_CPUS 1024
+#define AL_MAX_NODES 64
+
+typedef struct al_cpu_topo_s {
+	int cpu;		/* logical processor number */
+	int package;	/* physical package (socket) */
+	int core;		/* core id, unique within a package */
+	int core_rank;	/* index of the core within its package */
+	int smt;		/* index of the hardware thread within its core */
+	int node;		/* numa node */
+} al_cpu_topo;
+
+static int al_read_sysfs_line(const char *path, char *buf, int size) {
+	FILE *f=fopen(path,"r");
+	if (f==NULL)
+		return 0;
+	if (fgets(buf,size,f)==NULL) {
+		fclose(f);
+		return 0;
+	}
+	fclose(f);
+	return 1;
+}
+static int al_read_sysfs_int(const char *path, int *val) {
+	char buf[32];
+	if (!al_read_sysfs_line(path,buf,sizeof(buf)))
+		return 0;
+	*val=atoi(buf);
+	return 1;
+}
+/* parse a sysfs cpu list (e.g. "0-3,8-11") and mark each processor found with val */
+static int al_parse_cpulist(const char *list, int *marks, int val) {
+	const char *p=list;
+	int found=0;
+	while (*p>='0' && *p<='9') {
+		int first=(int)strtol(p,(char **)&p,10);
+		int last=first,cpu;
+		if (*p=='-')
+			last=(int)strtol(p+1,(char **)&p,10);
+		for (cpu=first; cpu<=last && cpu<AL_MAX_CPUS; cpu++) {
+			marks[cpu]=val;
+			found++;
+		}
+		if (*p==',')
+			p++;
+	}
+	return found;
+}
+static int al_cmp_compact(const void *a, const void *b) {
+	const al_cpu_topo *x=(const al_cpu_topo *)a, *y=(const al_cpu_topo *)b;
+	if (x->package!=y->package) return x->package-y->package;
+	if (x->core_rank!=y->core_rank) return x->core_rank-y->core_rank;
+	return x->smt-y->smt;
+}
+static int al_cmp_scatter(const void *a, const void *b) {
+	const al_cpu_topo *x=(const al_cpu_topo *)a, *y=(const al_cpu_topo *)b;
+	if (x->smt!=y->smt) return x->smt-y->smt;
+	if (x->core_rank!=y->core_rank) return x->core_rank-y->core_rank;
+	return x->package-y->package;
+}
+/* Function: al_discover_topology
+	Read packages, cores, hardware threads and numa nodes of all online processors from sysfs,
+	and fill the placement order in <hardware_info> for the selected policy.
+
+	Returns:
+	Number of online processors found, 0 if the topology is not available.
+*/
+static int al_discover_topology(int policy) {
+	char path[256],buf[4096];
+	int *online,*node;
+	al_cpu_topo *topo;
+	int i,j,n=0,nnodes;
+
+	if (!al_read_sysfs_line(AL_SYSFS_ROOT "/cpu/online",buf,sizeof(buf)))
+		return 0;
+	online=(int *)th_calloc(AL_MAX_CPUS,sizeof(int));
+	node=(int *)th_calloc(AL_MAX_CPUS,sizeof(int));
+	al_parse_cpulist(buf,online,1);
+	for (nnodes=0; nnodes<AL_MAX_NODES; nnodes++) {
+		th_sprintf(path,AL_SYSFS_ROOT "/node/node%d/cpulist",nnodes);
+		/* node numbers may have gaps, e.g. with memory only or offline nodes */
+		if (!al_read_sysfs_line(path,buf,sizeof(buf)))
+			continue;
+		al_parse_cpulist(buf,node,nnodes);
+	}
+	topo=(al_cpu_topo *)th_calloc(AL_MAX_CPUS,sizeof(al_cpu_topo));
+	for (i=0; i<AL_MAX_CPUS; i++) {
+		if (!online[i])
+			continue;
+		topo[n].cpu=i;
+		topo[n].node=node[i];
+		th_sprintf(path,AL_SYSFS_ROOT "/cpu/cpu%d/topology/physical_package_id",i);
+		if (!al_read_sysfs_int(path,&topo[n].package))
+			topo[n].package=0;
+		th_sprintf(path,AL_SYSFS_ROOT "/cpu/cpu%d/topology/core_id",i);
+		if (!al_read_sysfs_int(path,&topo[n].core))
+			topo[n].core=i;
+		n++;
+	}
+	/* hardware thread index within a core, and core index within a package */
+	for (i=0; i<n; i++) {
+		int lower_cores=0;
+		for (j=0; j<n; j++) {
+			if (topo[j].package!=topo[i].package)
+				continue;
+			if (topo[j].core==topo[i].core && topo[j].cpu<topo[i].cpu)
+				topo[i].smt++;
+			/* count distinct lower core ids, each counted on its first hardware thread */
+			if (topo[j].core<topo[i].core) {
+				int k,first=1;
+				for (k=0; k<j; k++)
+					if (topo[k].package==topo[j].package && topo[k].core==topo[j].core)
+						first=0;
+				lower_cores+=first;
+			}
+		}
+		topo[i].core_rank=lower_cores;
+	}
+	qsort(topo,n,sizeof(al_cpu_topo),(policy==AL_AFFINITY_SCATTER) ? al_cmp_scatter : al_cmp_compact);
+	hardware_info.cpu_order=(int *)th_calloc(n,sizeof(int));
+	hardware_info.num_cpus=0;
+	for (i=0; i<n; i++) {
+		/* physical core based policies only place on the first hardware thread of each core */
+		if ((policy==AL_AFFINITY_PHYSCORE || policy==AL_AFFINITY_STICKY) && topo[i].smt>0)
+			continue;
+		hardware_info.cpu_order[hardware_info.num_cpus++]=topo[i].cpu;
+	}
+	hardware_info.cpu_node=node;
+	th_free(topo);
+	th_free(online);
+	return n;
+}
+/* Function: al_bind_local_node
+	Prefer memory from the numa node of cpu for all further allocations of the calling thread,
+	so that data initialized by a work item lands on the node it executes on.
+*/
+static void al_bind_local_node(int cpu) {
+#if defined(SYS_set_mempolicy)
+	unsigned long mask[AL_MAX_NODES/(8*sizeof(unsigned long))+1];
+	int nd;
+	if (hardware_info.cpu_node==NULL)
+		return;
+	nd=hardware_info.cpu_node[cpu];
+	th_memset(mask,0,sizeof(mask));
+	mask[nd/(8*sizeof(unsigned long))] |= 1UL<<(nd%(8*sizeof(unsigned long)));
+	/* 1 is MPOL_PREFERRED, avoid requiring numaif.h */
+	syscall(SYS_set_mempolicy,1,mask,(unsigned long)(AL_MAX_NODES+1));
+#endif
+}
+#endif /* HAVE_SYSFS_TOPOLOGY */
+
+#if HAVE_PTHREAD_SETAFFINITY_NP
+/* Function: al_affinity_cpu
+	Select the processor for a work item or sub thread according to the placement policy.
+
+	Parameters:
+	item_id - serial id of the work item, used by the sticky policy
+	context_id - context executing the work item
+	sub_item_id - 0 for the work item itself, or the id of a sub thread of the work item.
+		Sub threads take the processors following the one of the item,
+		so that a team does not end up on a single processor.
+*/
+static int al_affinity_cpu(int item_id, e_u32 context_id, e_u32 sub_item_id) {
+	e_u32 idx=context_id+sub_item_id;
+	if (hardware_info.cpu_order==NULL || hardware_info.num_cpus<=0)
+		return (int)(idx % hardware_info.num_processors);
+	if (hardware_info.affinity==AL_AFFINITY_STICKY)
+		idx+=(e_u32)item_id;
+	return hardware_info.cpu_order[idx % hardware_info.num_cpus];
+}
+#endif
 
 void al_set_hardware_info(char *pdescription) {
 	e_s32 tmp;
-	th_parse_buf_flag(pdescription,"cores=",&tmp);
-	hardware_info.num_processors=tmp;
+	char *policy;
+	int have_cores=th_parse_buf_flag(pdescription,"cores=",&tmp);
+	if (have_cores)
+		hardware_info.num_processors=tmp;
 	hardware_info.description_string=pdescription;
+	if (th_get_buf_flag(pdescription,"affinity=",&policy)) {
+		if (th_strncmp(policy,"compact",7)==0)
+			hardware_info.affinity=AL_AFFINITY_COMPACT;
+		else if (th_strncmp(policy,"scatter",7)==0)
+			hardware_info.affinity=AL_AFFINITY_SCATTER;
+		else if (th_strncmp(policy,"physcore",8)==0)
+			hardware_info.affinity=AL_AFFINITY_PHYSCORE;
+		else if (th_strncmp(policy,"sticky",6)==0)
+			hardware_info.affinity=AL_AFFINITY_STICKY;
+		else
+			th_log(TH_WARNING,"Unknown affinity policy, using default placement.");
+	}
+	if (hardware_info.affinity!=AL_AFFINITY_DEFAULT) {
+#if HAVE_SYSFS_TOPOLOGY
+		int online=al_discover_topology(hardware_info.affinity);
+		if (online>0 && !have_cores)
+			hardware_info.num_processors=online;
+		if (online==0)
+#endif
+		{
+			th_log(TH_WARNING,"Processor topology not available, using default placement.");
+			hardware_info.affinity=AL_AFFINITY_DEFAULT;
+		}
+	}
 }
 
 hardware_info_t hardware_info={1,NULL};
 
+/* ids of the work item executing on this thread, see <al_item_setaffinity> */
+static TH_THREAD_LOCAL mith_textend al_cur_item;
+
+void al_item_textend(mith_textend *tex, e_u32 sub_item_id) {
+	*tex=al_cur_item;
+	tex->sub_item_id=sub_item_id;
+}
+
 /* Function: al_thread_create_ex
 	Create a new thread, using extra information to set specific hardware related parameters.
 	This function is used by some work items to allow affinity on sub threads created by the work item.
@@ -161,7 +440,6 @@ int al_thread_create_ex(al_thread_t * pThread, void *(*start_routine)(void *), v
 int retval=al_thread_create(pThread,start_routine,arg);
 #if HAVE_PTHREAD_SETAFFINITY_NP
 	cpu_set_t mask;
-	unsigned long masksum = 0;
 
 	if (retval<0)
 		return retval;
@@ -169,7 +447,7 @@ int retval=al_thread_create(pThread,start_routine,arg);
 	CPU_ZERO(&mask);
 	
 	if (tex->sub_item_id>=0) {
-		CPU_SET(tex->sub_item_id % hardware_info.num_processors, &mask);
+		CPU_SET(al_affinity_cpu(tex->item_id,tex->context_id,tex->sub_item_id), &mask);
 		retval=pthread_setaffinity_np(*pThread, sizeof(mask),&mask);
 	}
 #else
@@ -190,6 +468,10 @@ int retval=al_thread_create(pThread,start_routine,arg);
 
 	Default implementation:
 	Assign different affinity to each context created by the harness up to num_processors.
+	If a placement policy was selected with the hardware description (see <al_affinity_t>),
+	processors are assigned in the order defined by the policy, and the memory policy
+	of the context is set to prefer the numa node of that processor, 
+	so that allocations done by the item init function are local.
 
 	Porting:
 	This function needs to be ported if affinity for work items is desired.
@@ -198,17 +480,21 @@ int retval=al_thread_create(pThread,start_routine,arg);
 */
 int al_item_setaffinity(int kernel_id, int instance_id, int item_id, e_u32 context_id) {
 	int retval=0;
+	al_cur_item.item_id=(e_u32)item_id;
+	al_cur_item.kernel_id=(e_u32)kernel_id;
+	al_cur_item.context_id=context_id;
 #if HAVE_PTHREAD_SETAFFINITY_NP && HAVE_PTHREAD_SELF
 /* sample implementation that puts each context in a different affinity */
 	cpu_set_t mask;
-	unsigned long masksum = 0;
+	int cpu=al_affinity_cpu(item_id,context_id,0);
 	CPU_ZERO(&mask);
 	
-	CPU_SET(context_id % hardware_info.num_processors, &mask);
-	/* or alternatively, make sure each item has an affinity to a specific core
-	CPU_SET(item_id % hardware_info.num_processors, &mask);
-	*/
+	CPU_SET(cpu, &mask);
 	retval=pthread_setaffinity_np(pthread_self(), sizeof(mask),&mask);
+#if HAVE_SYSFS_TOPOLOGY
+	if (hardware_info.affinity!=AL_AFFINITY_DEFAULT)
+		al_bind_local_node(cpu);
+#endif
 #else
 	retval=kernel_id+instance_id+item_id+context_id;
 #endif
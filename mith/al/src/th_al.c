@@ -56,6 +56,11 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #include "th_lib.h" /* for th_log */
 #include "th_al.h"
 #include "al_smp.h"
+#if HAVE_MMAP_COW
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
 #if	EE_POWERTAG && HOST_EXAMPLE_CODE && !defined(_MSC_VER)
 #include <fcntl.h>
 #include <termios.h>
@@ -673,6 +678,99 @@ void	*al_fcreate(const char *filename, const char *mode, char *data, size_t size
 	return th_fopen(filename,mode);
 }
 
+/* Function: al_shared_map
+	Create a read only mapping holding a copy of src, to be shared by all contexts.
+
+	Parameters:
+	src - data to copy into the mapping
+	len - size of data
+	handle - set to a platform specific handle that is needed to create private views 
+
+	Default implementation:
+	With HAVE_MMAP_COW, the data is placed in a memfd and mapped read only, 
+	so that writes to the shared view fault. Otherwise an aligned heap copy is used.
+
+	Returns:
+	Pointer to the shared view, NULL on failure.
+*/
+void	*al_shared_map(const void *src, size_t len, int *handle) {
+	void *p;
+#if HAVE_MMAP_COW
+	int fd=(int)syscall(SYS_memfd_create,"mith_input",0);
+	*handle=-1;
+	if (fd>=0 && ftruncate(fd,(off_t)len)==0) {
+		p=mmap(NULL,len,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+		if (p!=MAP_FAILED) {
+			th_memcpy(p,src,len);
+			munmap(p,len);
+			p=mmap(NULL,len,PROT_READ,MAP_SHARED,fd,0);
+			if (p!=MAP_FAILED) {
+				*handle=fd;
+				return p;
+			}
+		}
+	}
+	if (fd>=0)
+		close(fd);
+	th_log(TH_WARNING,"Could not map shared input, using a heap copy");
+#else
+	*handle=-1;
+#endif
+	p=malloc_aligned(len,ALIGN_BOUNDARY);
+	if (p!=NULL)
+		th_memcpy(p,src,len);
+	return p;
+}
+/* Function: al_shared_unmap
+	Release a mapping created by <al_shared_map>
+*/
+void	al_shared_unmap(void *p, size_t len, int handle) {
+#if HAVE_MMAP_COW
+	if (handle>=0) {
+		munmap(p,len);
+		close(handle);
+		return;
+	}
+#endif
+	len=len+handle; /* avoid warnings */
+	free_aligned(p);
+}
+/* Function: al_private_map
+	Create a private writable view of a shared mapping. 
+	
+	Default implementation:
+	With HAVE_MMAP_COW, the view is a private copy on write mapping of the shared memfd, 
+	so only pages actually written are copied. Otherwise a heap copy is used.
+
+	Returns:
+	Pointer to the private view, NULL on failure.
+*/
+void	*al_private_map(const void *shared, size_t len, int handle) {
+	void *p;
+#if HAVE_MMAP_COW
+	if (handle>=0) {
+		p=mmap(NULL,len,PROT_READ|PROT_WRITE,MAP_PRIVATE,handle,0);
+		return (p!=MAP_FAILED) ? p : NULL;
+	}
+#endif
+	p=th_malloc(len);
+	if (p!=NULL)
+		th_memcpy(p,shared,len);
+	return p;
+}
+/* Function: al_private_unmap
+	Release a view created by <al_private_map>
+*/
+void	al_private_unmap(void *p, size_t len, int handle) {
+#if HAVE_MMAP_COW
+	if (handle>=0) {
+		munmap(p,len);
+		return;
+	}
+#endif
+	len=len+handle; /* avoid warnings */
+	th_free(p);
+}
 
 /** Function: al_fsize
 	Non Standard routine to return file size.
@@ -26,6 +26,38 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
  */
 #define MITH_MAX_NAME 256
 
+/* Structure: mith_hist_t
+	Histogram of execution times of a work item on a single context.
+	
+	Buckets are log scale: the first MITH_HIST_SUB buckets hold single ticks, 
+	and each following power of 2 range is split into MITH_HIST_SUB buckets,
+	which keeps the relative error of each bucket under 1/MITH_HIST_SUB.
+	Each context only updates its own histogram, so no locking is needed when recording.
+*/
+#define MITH_HIST_SUB_BITS 4
+#define MITH_HIST_SUB (1<<MITH_HIST_SUB_BITS)
+#define MITH_HIST_BUCKETS ((sizeof(size_t)*CHAR_BIT-MITH_HIST_SUB_BITS+1)*MITH_HIST_SUB)
+typedef struct mith_hist_s {
+	e_u32 counts[MITH_HIST_BUCKETS];
+	e_u32 n;
+	size_t max;
+#if FLOAT_SUPPORT
+	double sum;
+	double sumsq;
+#endif
+} mith_hist_t;
+
+/* Structure: mith_input_t
+	Input buffer that is created once and read by all contexts executing an item.
+	Kernels that only read their input use data directly instead of copying it in init,
+	kernels that modify their input in place get a private view with <mith_input_private>.
+*/
+typedef struct mith_input_s {
+	void *data;		/* shared view, must not be written to */
+	size_t len;
+	int handle;		/* platform handle backing the shared view, see <al_shared_map> */
+} mith_input_t;
+
 /* Structure: ee_work_item_t
 	This structure holds all of the information about a work item.
 	
@@ -61,6 +93,9 @@ typedef struct ee_work_item_s {
 	e_s32 chain_uid;				/* Each item is associated with a specific chain, identified by chain_uid */
 	e_u32 connect_idx[MAX_CONNECTIONS];		/* Mapping helpers to access actual connections */
 	e_s32 next_idx;
+	/* Execution time distribution */
+	mith_hist_t *hist;				/* one histogram per context */
+	unsigned int hist_contexts;		/* number of histograms in hist */
 } ee_work_item_t;
 
 typedef struct chain_info_s {
@@ -98,8 +133,25 @@ typedef struct ee_workload_s {
 	int mcl;					/* max chain length */
 	int num_chains;				/* number of chains in item list (==#items/mcl) */
 	/* end of sync related info */
+	e_u32 *steals;				/* items stolen by each context, only when using the work stealing scheduler */
+#if USE_TH_ARENA
+	th_arena_stats *arena_stats;	/* allocation statistics of each context arena */
+#endif
 } ee_workload;
 
+/* Enum: mith_sched_t
+	Schedulers available to distribute work items to contexts.
+	
+	MITH_SCHED_DEFAULT - contexts extract the next item from the workload under a global mutex.
+	MITH_SCHED_STEAL - item executions are split up front into per context deques, 
+		contexts that run out of work steal from other contexts. No locks are taken to schedule or record items.
+		Not available for workloads containing chains.
+*/
+typedef enum {
+	MITH_SCHED_DEFAULT=0,
+	MITH_SCHED_STEAL
+} mith_sched_t;
+
 /* Function: mith_wl_init
 	Allocate and initialize a workload that contains num_items */
 ee_workload *mith_wl_init(int num_items);
@@ -130,9 +182,32 @@ int mith_wl_add(ee_workload *workload, ee_work_item_t *item);
 	Reset a workload and prepare to run num_iterations of workload */
 int mith_wl_reset(ee_workload *workload,unsigned int num_iterations, 
 				  unsigned int num_contexts, unsigned int oversubscribe_allowed);
+/* Function: mith_hist_add
+	Record an execution time in a histogram */
+void mith_hist_add(mith_hist_t *hist, size_t ticks);
+/* Function: mith_hist_percentile
+	Return the execution time (in ticks) below which pct percent of the executions 
+	recorded in num_hist histograms fall. */
+size_t mith_hist_percentile(mith_hist_t *hist, unsigned int num_hist, e_u32 pct);
+/* Function: mith_input_share
+	Copy len bytes of src into a new shared input. Call outside of timing, e.g. from define_params. */
+mith_input_t *mith_input_share(const void *src, size_t len);
+/* Function: mith_input_release
+	Release a shared input once no context uses it, e.g. from the item clean function. */
+void mith_input_release(mith_input_t *input);
+/* Function: mith_input_private
+	Writable copy of a shared input for a single execution, released with <mith_input_private_free>. */
+void *mith_input_private(mith_input_t *input);
+/* Function: mith_input_private_free
+	Release a view returned by <mith_input_private>. */
+void mith_input_private_free(mith_input_t *input, void *p);
 /* Function: mith_wl_get_next
 	Helper to get the next item from a workload */
 struct ee_work_item_s *mith_wl_get_next(ee_workload *workload);
+/* Function: mith_set_scheduler
+	Select the scheduler used by <mith_main> by name ("default" or "steal").
+	Returns 0 if the name is not recognized. */
+int mith_set_scheduler(char *name);
 /* Function: mith_main
 	Description: 
 	main function that fires off work items. 
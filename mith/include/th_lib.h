@@ -486,4 +486,39 @@ extern size_t th_malloc_total;
 extern size_t th_malloc_max;
 #endif
 
+/* Flag: USE_TH_ARENA
+	Serve th_malloc/th_calloc/th_realloc/th_strdup from a per context arena while a work item executes.
+	Each context owns an arena made of TH_ARENA_CHUNK sized chunks. Allocations are a pointer bump,
+	th_free only releases the most recent allocation, and all memory of the item is released 
+	in O(1) with <th_arena_reset> after the item fini_func.
+	Every block, libc ones included, carries a header naming its arena, so memory from these 
+	functions must only be released with th_free/th_realloc.
+	Memory allocated from an arena must be released by the context that allocated it, 
+	and must not be kept past the fini_func of the item.
+*/
+#ifndef USE_TH_ARENA
+#define USE_TH_ARENA 0
+#endif
+#ifndef TH_ARENA_CHUNK
+#define TH_ARENA_CHUNK (1024*1024)
+#endif
+#if USE_TH_ARENA
+/* Struct: th_arena_stats
+	Allocation statistics of an arena. Only updated by the owning context, so no locks are needed.
+*/
+typedef struct th_arena_stats_s {
+	size_t allocs;		/* number of allocations served */
+	size_t frees;		/* number of frees of arena memory */
+	size_t peak;		/* max bytes in use during a single item execution */
+	size_t reserved;	/* bytes held in chunks */
+	size_t resets;		/* number of item executions released */
+} th_arena_stats;
+typedef struct th_arena_s th_arena;
+th_arena *th_arena_create(size_t chunk_size);
+void th_arena_destroy(th_arena *arena);
+void th_arena_attach(th_arena *arena);
+void th_arena_reset(th_arena *arena);
+void th_arena_get_stats(th_arena *arena, th_arena_stats *stats);
+#endif
+
 #endif /*THLIB_H_FILE*/ 
@@ -45,6 +45,7 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 #endif	
 
 #define th_pow_64 pow
+#define th_sqrt_64 sqrt
 
 /* Route to math functions for SP configuration */
 #if USE_FP32
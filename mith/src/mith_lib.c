@@ -16,6 +16,9 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
  */
 
 #include "th_lib.h"
+#if FLOAT_SUPPORT
+#include "th_math.h"
+#endif
 #include "th_al.h"
 #include "al_smp.h"
 #include "mith_sync.h"
@@ -23,12 +26,25 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
 
 e_u32 verify_output=1;
 e_u32 reporting_threshold=TH_INFO;
+e_u32 mith_scheduler=MITH_SCHED_DEFAULT;
 
 int mith_report_results(ee_workload *workload, size_t total_time, e_u32 num_contexts, unsigned int num_workers);
 /* Struct : mith_context_t
 	This structure contains data pertaining to an 
 	execution context that can run benchmarks.
 */
+/* Struct : mith_deque_t
+	Range of item executions owned by a context when using the work stealing scheduler.
+	Execution n is an execution of item (n % max_idx) in workload iteration (n / max_idx).
+	The owner takes executions from the bottom, other contexts steal from the top.
+	Padded so that deques of different contexts do not share a cache line.
+*/
+typedef struct mith_deque_s {
+	volatile long top;
+	volatile long bottom;
+	char pad[(ALIGN_BOUNDARY>2*sizeof(long)) ? ALIGN_BOUNDARY-2*sizeof(long) : 1];
+} mith_deque_t;
+
 typedef struct mith_context_s {
 	al_thread_t thread;
 	al_mutex_t mutex;
@@ -40,6 +56,13 @@ typedef struct mith_context_s {
 	int inv;
 	void *params;
 	ee_workload *workload;
+	/* work stealing scheduler only */
+	mith_deque_t *deques;
+	e_u32 num_contexts;
+	e_u32 steals;
+#if USE_TH_ARENA
+	th_arena *arena;	/* allocations of items executing on this context */
+#endif
 	/* future extensions: affinity? */
 } mith_context_t;
 /* DEBUG : This global is for debugging purposes only. */
@@ -87,6 +110,66 @@ void print_memstat(char *s, char *m,float val) {
 }
 #endif
 
+/* Function: mith_exec_item
+	Initialize, execute, verify and clean up a single execution of a work item on a context.
+	The time spent in the benchmark function is left in mycontext->time,
+	and results reported by the benchmark are left in benchin.
+
+	Returns:
+	Non zero if the execution failed verification.
+*/
+static Bool mith_exec_item(mith_context_t *mycontext, ee_work_item_t *item, TCDef *benchin, ee_connection **connection) {
+	Bool failed;
+#if THDEBUG
+	char logbuf[256];
+#endif
+	al_item_setaffinity(item->kernel_id,item->instance_id,item->uid,mycontext->id);
+#if USE_TH_ARENA
+	/* chained items pass data between contexts, so they keep using libc allocations */
+	if (item->chain_id<0)
+		th_arena_attach(mycontext->arena);
+#endif
+#if REPORT_THMALLOC_STATS
+	print_memstat("Total allocated memory before init",item->shortname,(float)th_malloc_total);
+#endif
+	mycontext->params=item->init_func(item->params); /* prepare for run */
+#if REPORT_THMALLOC_STATS
+	print_memstat("Total allocated memory after init",item->shortname,(float)th_malloc_total);
+#endif
+	th_memcpy(benchin,item->tcdef,sizeof(TCDef));
+	benchin->connection=connection;
+	mycontext->time=al_signal_now(); 
+	/* execute the work item - params are saved on a per context basis */
+	item->bench_func(benchin,mycontext->params);
+	/* note time it took for item to execute */
+	mycontext->time=al_signal_now()-mycontext->time;
+#if THDEBUG
+	th_sprintf(logbuf," * completed [%d]%s[%d] in %d",item->uid,item->shortname,mycontext->inv,mycontext->id);
+	th_log(TH_INFO,logbuf);
+#endif
+	/* verify output */
+	if (verify_output) {
+		failed = (Bool)(item->veri_func(mycontext->params)<=0);
+	} else {
+		failed = (benchin->CRC==benchin->expected_CRC) ? 0 : 1;
+	}
+	/* cleanup and prepare for next run */
+#if REPORT_THMALLOC_STATS
+	print_memstat("Total allocated memory before fini",item->shortname,(float)th_malloc_total);
+#endif
+	item->fini_func(mycontext->params);
+#if USE_TH_ARENA
+	if (item->chain_id<0) {
+		th_arena_attach(NULL);
+		th_arena_reset(mycontext->arena);
+	}
+#endif
+#if REPORT_THMALLOC_STATS
+	print_memstat("Total allocated memory after fini",item->shortname,(float)th_malloc_total);
+#endif
+	return failed;
+}
+
 /* Function: bench_thread 
 	This is intended to be called as a thread.
 	It will continously extract items to process from the workload,
@@ -142,39 +225,8 @@ void *bench_thread(void *inarg) {
 			al_mutex_unlock(&chain_mutex[0]);
 		}
 		if (item->init_func!=NULL) { /* some items may be fake, just for chains */
-			al_item_setaffinity(item->kernel_id,item->instance_id,item->uid,mycontext->id);
-#if REPORT_THMALLOC_STATS
-			print_memstat("Total allocated memory before init",item->shortname,(float)th_malloc_total);
-#endif
-			mycontext->params=item->init_func(item->params); /* prepare for run */
-#if REPORT_THMALLOC_STATS
-			print_memstat("Total allocated memory after init",item->shortname,(float)th_malloc_total);
-#endif
-			th_memcpy(&benchin,item->tcdef,sizeof(TCDef));
-			benchin.connection=connection;
-			mycontext->time=al_signal_now(); 
-			/* execute the work item - params are saved on a per context basis */
-			item->bench_func(&benchin,mycontext->params);
-			/* note time it took for item to execute */
-			mycontext->time=al_signal_now()-mycontext->time;
-#if THDEBUG
-	th_sprintf(logbuf," * completed [%d]%s[%d] in %d",item->uid,item->shortname,mycontext->inv,mycontext->id);
-	th_log(TH_INFO,logbuf);
-#endif
-			/* verify output */
-			if (verify_output) {
-				failed = (Bool)(item->veri_func(mycontext->params)<=0);
-			} else {
-				failed = (benchin.CRC==benchin.expected_CRC) ? 0 : 1;
-			}
-			/* cleanup and prepare for next run */
-#if REPORT_THMALLOC_STATS
-			print_memstat("Total allocated memory before fini",item->shortname,(float)th_malloc_total);
-#endif
-			item->fini_func(mycontext->params);
-#if REPORT_THMALLOC_STATS
-			print_memstat("Total allocated memory after fini",item->shortname,(float)th_malloc_total);
-#endif
+			failed=mith_exec_item(mycontext,item,&benchin,connection);
+			mith_hist_add(&item->hist[mycontext->id],mycontext->time);
 		}
 		/* cleanup and wait for chain to end */
 		if (item->chain_id>=0) { 
@@ -215,6 +267,123 @@ void *bench_thread(void *inarg) {
 	return retval;
 }
 
+/* Function: mith_deque_pop
+	Take the next execution from the bottom of the deque owned by this context.
+	Only the last execution in the deque can race with thieves, 
+	and that race is resolved by a CAS on top.
+
+	Returns:
+	Index of the execution, or -1 if the deque is empty.
+*/
+static long mith_deque_pop(mith_deque_t *q) {
+	long b=q->bottom-1;
+	long t;
+	q->bottom=b;
+	al_memory_barrier();
+	t=q->top;
+	if (t<b)
+		return b;
+	if (t==b) {
+		long ret=al_atomic_cas(&q->top,t,t+1) ? b : -1;
+		q->bottom=t+1;
+		return ret;
+	}
+	q->bottom=t;
+	return -1;
+}
+/* Function: mith_deque_steal
+	Take an execution from the top of a deque owned by another context.
+
+	Returns:
+	Index of the execution, -1 if the deque is empty, or -2 if another context won the race.
+*/
+static long mith_deque_steal(mith_deque_t *q) {
+	long t=q->top;
+	long b;
+	al_memory_barrier();
+	b=q->bottom;
+	if (t>=b)
+		return -1;
+	if (al_atomic_cas(&q->top,t,t+1))
+		return t;
+	return -2;
+}
+
+/* Function: bench_thread_steal 
+	Thread function for the work stealing scheduler (<MITH_SCHED_STEAL>).
+	Executes items from the deque owned by this context, and once that is empty
+	steals from the other contexts, visiting them in order starting from the next context.
+	The thread exits after a full pass over all other deques finds no work.
+
+	Item statistics are updated with atomic operations. 
+	Results reported by the benchmark are copied to the item by the context that completes the last execution.
+*/
+void *bench_thread_steal(void *inarg) {
+	mith_context_t *mycontext=(mith_context_t *)inarg;
+	ee_workload *workload=mycontext->workload;
+	TCDef benchin;
+	ee_work_item_t *item;
+	Bool failed;
+	long task;
+	e_u32 i;
+#if THDEBUG
+	char logbuf[256];
+#endif
+	while (1) {
+		task=mith_deque_pop(&mycontext->deques[mycontext->id]);
+		if (task<0) {
+			int retry=1;
+			while (task<0 && retry) {
+				retry=0;
+				for (i=1; i<mycontext->num_contexts; i++) {
+					task=mith_deque_steal(&mycontext->deques[(mycontext->id+i)%mycontext->num_contexts]);
+					if (task>=0)
+						break;
+					if (task==-2)
+						retry=1;
+				}
+			}
+			if (task<0)
+				break; /* all deques are empty, and no new work is ever added */
+			mycontext->steals++;
+		}
+		item=workload->load[task%workload->max_idx];
+		mycontext->inv=(int)(task/workload->max_idx);
+		al_atomic_add(&item->assigned,1);
+		failed=mith_exec_item(mycontext,item,&benchin,NULL);
+		mith_hist_add(&item->hist[mycontext->id],mycontext->time);
+		mycontext->params = NULL;
+		al_atomic_add(&item->failed,failed);
+		al_atomic_add(&item->time,mycontext->time);
+		if (al_atomic_add(&item->finished,1)+1==item->required) {
+			item->tcdef->actual_iterations=benchin.actual_iterations;
+			item->tcdef->v1=benchin.v1;
+			item->tcdef->v2=benchin.v2;
+			item->tcdef->v3=benchin.v3;
+			item->tcdef->v4=benchin.v4;
+#if FP_KERNELS_SUPPORT
+			for (i=0; i<4; i++) 
+				item->tcdef->dbl_data[i]=benchin.dbl_data[i];
+#endif
+		}
+	}
+#if THDEBUG
+	th_sprintf(logbuf," * all done in %d, stole %d",mycontext->id,mycontext->steals);
+	th_log(TH_INFO,logbuf);
+#endif
+	return NULL;
+}
+
+int mith_set_scheduler(char *name) {
+	if (th_strcmp(name,"default")==0)
+		mith_scheduler=MITH_SCHED_DEFAULT;
+	else if (th_strcmp(name,"steal")==0)
+		mith_scheduler=MITH_SCHED_STEAL;
+	else
+		return 0;
+	return 1;
+}
+
 static int RunBigEndian()
 {
    short word = 0x4321;
@@ -245,6 +414,8 @@ size_t mith_main_loop(ee_workload *workload, unsigned int num_iterations, unsign
 	size_t total_time;
 	e_u32 i;
 	mith_context_t *context;
+	mith_deque_t *deques=NULL;
+	void *(*thread_func)(void *)=bench_thread;
 	void *context_ret; /* potentially can be used to collect thread pool stats */
 #if SINGLE_CONTEXT
 	num_contexts=1;
@@ -288,6 +459,26 @@ size_t mith_main_loop(ee_workload *workload, unsigned int num_iterations, unsign
 		al_mutex_init(&context[i].mutex);
 		context[i].id=i;
 		context[i].workload=workload;
+#if USE_TH_ARENA
+		context[i].arena=th_arena_create(TH_ARENA_CHUNK);
+#endif
+	}
+	if (mith_scheduler==MITH_SCHED_STEAL) {
+		if (workload->mcl>1) {
+			th_log(TH_WARNING,"Work stealing scheduler does not support chains, using default scheduler.");
+		} else {
+			/* split all executions evenly between contexts, keeping executions of each context contiguous */
+			long total_execs=(long)workload->max_idx*(long)num_iterations;
+			deques=(mith_deque_t *)th_aligned_malloc(num_contexts*sizeof(mith_deque_t),ALIGN_BOUNDARY);
+			for (i=0; i<num_contexts; i++) {
+				deques[i].top=(long)(((e_u64)total_execs*i)/num_contexts);
+				deques[i].bottom=(long)(((e_u64)total_execs*(i+1))/num_contexts);
+				context[i].deques=deques;
+				context[i].num_contexts=num_contexts;
+				context[i].steals=0;
+			}
+			thread_func=bench_thread_steal;
+		}
 	}
 	th_log(TH_INFO,"Starting Run...");
 
@@ -296,7 +487,7 @@ size_t mith_main_loop(ee_workload *workload, unsigned int num_iterations, unsign
 	al_signal_start();
 	/* create the thread pool */
 	for (i=0; i<num_contexts; i++)
-		al_thread_create(&(context[i].thread),bench_thread,(void *)(&context[i]));
+		al_thread_create(&(context[i].thread),thread_func,(void *)(&context[i]));
 	/* and wait until threads are all done executing */
 	for (i=0; i<num_contexts; i++)
 		al_thread_join((context[i].thread),&context_ret);
@@ -308,6 +499,19 @@ size_t mith_main_loop(ee_workload *workload, unsigned int num_iterations, unsign
 	for (i=0; (i<num_contexts); i++) {
 		al_mutex_destroy(&context[i].mutex);
 	}
+	if (deques) {
+		workload->steals=(e_u32 *)th_calloc(num_contexts,sizeof(e_u32));
+		for (i=0; i<num_contexts; i++)
+			workload->steals[i]=context[i].steals;
+		th_aligned_free(deques);
+	}
+#if USE_TH_ARENA
+	workload->arena_stats=(th_arena_stats *)th_calloc(num_contexts,sizeof(th_arena_stats));
+	for (i=0; i<num_contexts; i++) {
+		th_arena_get_stats(context[i].arena,&workload->arena_stats[i]);
+		th_arena_destroy(context[i].arena);
+	}
+#endif
 	th_free(context);
 
 	return total_time;
@@ -405,6 +609,45 @@ void mith_log_tcdef(const char * component, TCDef *tcdef, size_t total_item_time
 	mith_log_dbl(component,"repeats/sec",(double)tcdef->actual_iterations/secs);
 #endif
 }
+/* log the distribution of execution times of an item */
+void mith_log_hist(const char * component, ee_work_item_t *item) {
+	e_u32 i;
+	size_t max=0;
+#if FLOAT_SUPPORT
+	double tps=(double)al_ticks_per_sec();
+	double n=0.0,sum=0.0,sumsq=0.0,mean,var;
+#endif
+	for (i=0; i<item->hist_contexts; i++) {
+		if (item->hist[i].max>max)
+			max=item->hist[i].max;
+#if FLOAT_SUPPORT
+		n+=(double)item->hist[i].n;
+		sum+=item->hist[i].sum;
+		sumsq+=item->hist[i].sumsq;
+#endif
+	}
+#if FLOAT_SUPPORT
+	if (n==0.0)
+		return;
+	mith_log_dbl(component,"p50(secs)",(double)mith_hist_percentile(item->hist,item->hist_contexts,50)/tps);
+	mith_log_dbl(component,"p90(secs)",(double)mith_hist_percentile(item->hist,item->hist_contexts,90)/tps);
+	mith_log_dbl(component,"p99(secs)",(double)mith_hist_percentile(item->hist,item->hist_contexts,99)/tps);
+	mith_log_dbl(component,"max(secs)",(double)max/tps);
+	/* jitter is reported as the standard deviation of execution time */
+	mean=sum/n;
+	var=sumsq/n-mean*mean;
+	if (var<0.0) /* rounding */
+		var=0.0;
+	mith_log_dbl(component,"jitter(secs)",th_sqrt_64(var)/tps);
+	if (mean>0.0)
+		mith_log_dbl(component,"jitter(%)",100.0*th_sqrt_64(var)/mean);
+#else
+	mith_log(component,"p50(ticks)",mith_hist_percentile(item->hist,item->hist_contexts,50));
+	mith_log(component,"p90(ticks)",mith_hist_percentile(item->hist,item->hist_contexts,90));
+	mith_log(component,"p99(ticks)",mith_hist_percentile(item->hist,item->hist_contexts,99));
+	mith_log(component,"max(ticks)",max);
+#endif
+}
 /* Function: mith_report_results
 	Description:
 	Log a full workload 
@@ -442,6 +685,28 @@ int mith_report_results(ee_workload *workload, size_t total_time, e_u32 num_cont
 	mith_log(wname,"contexts",num_contexts);
 	if (num_workers>0)
 		mith_log_u(wname,"workers",num_workers);
+	if (workload->steals) {
+		size_t total_steals=0;
+		th_printf("-- %s:scheduler=steal\n",wname);
+		for (i=0; i<num_contexts; i++) {
+			mith_log_iu(wname,"steals",i,workload->steals[i]);
+			total_steals+=workload->steals[i];
+		}
+		mith_log_u(wname,"steals",total_steals);
+	}
+#if USE_TH_ARENA
+	if (workload->arena_stats) {
+		size_t total_allocs=0;
+		for (i=0; i<num_contexts; i++) {
+			mith_log_iu(wname,"arena_allocs",i,workload->arena_stats[i].allocs);
+			mith_log_iu(wname,"arena_frees",i,workload->arena_stats[i].frees);
+			mith_log_iu(wname,"arena_peak(bytes)",i,workload->arena_stats[i].peak);
+			mith_log_iu(wname,"arena_reserved(bytes)",i,workload->arena_stats[i].reserved);
+			total_allocs+=workload->arena_stats[i].allocs;
+		}
+		mith_log_u(wname,"arena_allocs",total_allocs);
+	}
+#endif
 	mith_log(wname,"iterations",workload->iterations);
 #if FLOAT_SUPPORT
 	secs=(double)total_time/(double)al_ticks_per_sec();
@@ -491,6 +756,13 @@ int mith_report_results(ee_workload *workload, size_t total_time, e_u32 num_cont
 		#endif
 	#endif
 	}
+	/* distribution of execution times for each item */
+	for (i=0; i<workload->max_idx ; i++)
+	{
+		ee_work_item_t *item=workload->load[i];
+		if (item->hist)
+			mith_log_hist(item->shortname,item);
+	}
 	#if DEBUG_ACCURATE_BITS
 		mith_log("sig_exp","min",acc_summary.sig_exp.min);
 		mith_log("sig_exp","max",acc_summary.sig_exp.max);
@@ -15,6 +15,7 @@ Please refer to LICENSE.md for the specific license agreement that pertains to t
  */
 
 #include "th_lib.h"
+#include "th_al.h"
 #include "al_smp.h"
 #include "mith_sync.h"
 #include "mith_workload.h"
@@ -49,6 +50,8 @@ int mith_wl_destroy(ee_workload *workload) {
 	e_u32 i;
 	for (i=0; i<workload->max_idx; i++) {
 		if (workload->load[i] != NULL) {
+			if (workload->load[i]->hist)
+				th_free(workload->load[i]->hist);
 			th_free(workload->load[i]->tcdef);
 			th_free(workload->load[i]);
 			workload->load[i]=NULL;
@@ -83,6 +86,16 @@ int mith_wl_destroy(ee_workload *workload) {
 		th_free(workload->connection_protos);
 		workload->connection_protos=NULL;
 	}
+	if (workload->steals) {
+		th_free(workload->steals);
+		workload->steals=NULL;
+	}
+#if USE_TH_ARENA
+	if (workload->arena_stats) {
+		th_free(workload->arena_stats);
+		workload->arena_stats=NULL;
+	}
+#endif
 	th_free(workload);
 	return 1;
 }
@@ -141,6 +154,16 @@ int mith_wl_reset(ee_workload *workload,unsigned int num_iterations,
 	e_u32 i;
 	workload->next_idx=0;
 	workload->iterations=num_iterations;
+	if (workload->steals) {
+		th_free(workload->steals);
+		workload->steals=NULL;
+	}
+#if USE_TH_ARENA
+	if (workload->arena_stats) {
+		th_free(workload->arena_stats);
+		workload->arena_stats=NULL;
+	}
+#endif
 	if ((int)num_contexts < workload->mcl) {
 		th_exit(TH_ERROR,"This workload contains a chain that cannot be instantiated with currently defined number of contexts!");
 		return 0;
@@ -151,6 +174,10 @@ int mith_wl_reset(ee_workload *workload,unsigned int num_iterations,
 			workload->load[i]->assigned=0;
 			workload->load[i]->finished=0;
 			workload->load[i]->time=0;
+			if (workload->load[i]->hist)
+				th_free(workload->load[i]->hist);
+			workload->load[i]->hist=(mith_hist_t *)th_calloc(num_contexts,sizeof(mith_hist_t));
+			workload->load[i]->hist_contexts=num_contexts;
 			/* Currently MITH is ignoring number of contexts actually consumed by each item.
 			if (workload->load[i]->num_contexts > num_contexts) {
 				if (oversubscribe_allowed)
@@ -216,8 +243,129 @@ int mith_wl_reset(ee_workload *workload,unsigned int num_iterations,
 	}
 	return 1;
 }
+/* Function: mith_input_share
+	Description:
+	Create an input that all contexts can read without copying it.
+	The data is copied once into a shared view provided by <al_shared_map>, 
+	which is read only where the platform allows it.
+*/
+mith_input_t *mith_input_share(const void *src, size_t len) {
+	mith_input_t *input=(mith_input_t *)th_calloc(1,sizeof(mith_input_t));
+	if (input==NULL)
+		th_exit(THE_OUT_OF_MEMORY,"Cannot Allocate Memory %s:%d", __FILE__,__LINE__);
+	input->len=len;
+	input->data=al_shared_map(src,len,&input->handle);
+	if (input->data==NULL)
+		th_exit(THE_OUT_OF_MEMORY,"Cannot map shared input %s:%d", __FILE__,__LINE__);
+	return input;
+}
+/* Function: mith_input_release
+	Description:
+	Release a shared input and its backing memory.
+*/
+void mith_input_release(mith_input_t *input) {
+	if (input==NULL)
+		return;
+	al_shared_unmap(input->data,input->len,input->handle);
+	th_free(input);
+}
 /*Functions that can happen while multiple threads are running*/
 
+/* Function: mith_input_private
+	Description:
+	Writable view of a shared input, for kernels that modify their input in place.
+	Where supported the view is copy on write (see <al_private_map>), so only pages that are
+	written get copied.
+	
+	Thread Safety:
+	Any number of contexts may create private views of the same input concurrently.
+*/
+void *mith_input_private(mith_input_t *input) {
+	void *p=al_private_map(input->data,input->len,input->handle);
+	if (p==NULL)
+		th_exit(THE_OUT_OF_MEMORY,"Cannot map private input %s:%d", __FILE__,__LINE__);
+	return p;
+}
+/* Function: mith_input_private_free
+	Description:
+	Release a view returned by <mith_input_private>.
+*/
+void mith_input_private_free(mith_input_t *input, void *p) {
+	if (p!=NULL)
+		al_private_unmap(p,input->len,input->handle);
+}
+
+/* Function: mith_hist_bucket
+	Map a time in ticks to a log scale bucket in <mith_hist_t>.
+*/
+static e_u32 mith_hist_bucket(size_t ticks) {
+	e_u32 msb=0;
+	size_t v=ticks;
+	if (ticks<MITH_HIST_SUB)
+		return (e_u32)ticks;
+	while (v>>=1)
+		msb++;
+	return (msb-MITH_HIST_SUB_BITS+1)*MITH_HIST_SUB + (e_u32)((ticks>>(msb-MITH_HIST_SUB_BITS))&(MITH_HIST_SUB-1));
+}
+/* Function: mith_hist_value
+	Representative value of a bucket, the middle of the range of ticks it holds.
+*/
+static size_t mith_hist_value(e_u32 bucket) {
+	e_u32 msb;
+	size_t low,width;
+	if (bucket<MITH_HIST_SUB)
+		return bucket;
+	msb=bucket/MITH_HIST_SUB-1+MITH_HIST_SUB_BITS;
+	width=(size_t)1<<(msb-MITH_HIST_SUB_BITS);
+	low=(size_t)(MITH_HIST_SUB+bucket%MITH_HIST_SUB)*width;
+	return low+width/2;
+}
+/* Function: mith_hist_add
+	Record an execution time.
+
+	Thread Safety:
+	Only the context owning the histogram may call this function, no locking is done.
+*/
+void mith_hist_add(mith_hist_t *hist, size_t ticks) {
+	hist->counts[mith_hist_bucket(ticks)]++;
+	hist->n++;
+	if (ticks>hist->max)
+		hist->max=ticks;
+#if FLOAT_SUPPORT
+	hist->sum+=(double)ticks;
+	hist->sumsq+=(double)ticks*(double)ticks;
+#endif
+}
+/* Function: mith_hist_percentile
+	Merge the histograms of all contexts and find the execution time below which 
+	pct percent of the executions fall. The result is limited to the longest execution recorded.
+
+	Thread Safety:
+	Only call once all contexts are done.
+*/
+size_t mith_hist_percentile(mith_hist_t *hist, unsigned int num_hist, e_u32 pct) {
+	e_u32 b,c;
+	size_t n=0,target,seen=0,max=0,val;
+	for (c=0; c<num_hist; c++) {
+		n+=hist[c].n;
+		if (hist[c].max>max)
+			max=hist[c].max;
+	}
+	if (n==0)
+		return 0;
+	target=(n*pct+99)/100;
+	if (target==0)
+		target=1;
+	for (b=0; b<MITH_HIST_BUCKETS; b++) {
+		for (c=0; c<num_hist; c++)
+			seen+=hist[c].counts[b];
+		if (seen>=target)
+			break;
+	}
+	val=mith_hist_value(b);
+	return (val>max) ? max : val;
+}
+
 /* Function: mith_wl_get_next
 	Description:
 	This function detects the next item that still has executions required.
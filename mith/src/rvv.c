@@ -1,3 +1,4 @@
+#if USE_RVV
 #include "rvv.h"
 
 void* vec_memcpy(void *s1, const void *s2, size_t n) {
@@ -30,3 +31,4 @@ void* vec_memmove(void *s1, const void *s2, size_t n) {
     return vec_memcpy(s1, s2, n);
   }
 }
+#endif
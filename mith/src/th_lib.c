@@ -744,6 +744,203 @@ void free( void* ptr )
 }
 #endif
 
+#if USE_TH_ARENA
+#include "al_smp.h"
+#if !HAVE_THREAD_LOCAL && !USE_SINGLE_CONTEXT
+#error "USE_TH_ARENA requires thread local storage (HAVE_THREAD_LOCAL) or USE_SINGLE_CONTEXT"
+#endif
+/* Each block handed out by th_malloc/th_calloc/th_realloc/th_strdup is preceded by a header 
+	holding the requested size and the arena it came from, NULL for libc blocks. 
+	th_free and th_realloc find the owner of a block in O(1), also once the arena was detached.
+	The header keeps blocks aligned to TH_ARENA_ALIGN. */
+#define TH_ARENA_ALIGN 16
+#define TH_ARENA_HDR TH_ARENA_ALIGN
+
+typedef struct th_arena_hdr_s {
+	size_t size;
+	th_arena *arena;
+} th_arena_hdr;
+
+#define TH_ARENA_BLOCK(p) ((th_arena_hdr *)((char *)(p)-TH_ARENA_HDR))
+
+typedef struct th_arena_chunk_s {
+	struct th_arena_chunk_s *next;
+	char *data;		/* aligned start of usable memory */
+	size_t size;	/* usable bytes */
+	size_t used;	/* bytes handed out */
+} th_arena_chunk;
+
+struct th_arena_s {
+	th_arena_chunk *head;
+	th_arena_chunk *cur;	/* chunk serving allocations */
+	size_t chunk_size;
+	char *last;				/* most recent allocation, can be freed or grown in place */
+	size_t in_use;			/* bytes handed out since last reset */
+	th_arena_stats stats;
+};
+
+/* arena serving allocations of the calling thread, NULL when allocations should go to libc */
+static TH_THREAD_LOCAL th_arena *th_cur_arena=NULL;
+
+static th_arena_chunk *th_arena_new_chunk(th_arena *arena, size_t size) {
+	th_arena_chunk *c=(th_arena_chunk *)malloc(sizeof(th_arena_chunk)+size+TH_ARENA_ALIGN);
+	if (c==NULL)
+		th_exit(THE_OUT_OF_MEMORY,"Arena chunk allocation failed!\n");
+	c->next=NULL;
+	c->data=(char *)(((size_t)(c+1)+TH_ARENA_ALIGN-1) & ~(size_t)(TH_ARENA_ALIGN-1));
+	c->size=size;
+	c->used=0;
+	arena->stats.reserved+=size;
+	return c;
+}
+
+/* Function: th_arena_create
+	Create an arena, reserving the first chunk up front so that no chunk is allocated while timing 
+	the first item unless it needs more then chunk_size bytes.
+*/
+th_arena *th_arena_create(size_t chunk_size) {
+	th_arena *arena=(th_arena *)calloc(1,sizeof(th_arena));
+	if (arena==NULL)
+		th_exit(THE_OUT_OF_MEMORY,"Arena allocation failed!\n");
+	arena->chunk_size=(chunk_size>0) ? chunk_size : TH_ARENA_CHUNK;
+	arena->head=th_arena_new_chunk(arena,arena->chunk_size);
+	arena->cur=arena->head;
+	return arena;
+}
+
+/* Function: th_arena_destroy
+	Release all chunks of an arena. 
+*/
+void th_arena_destroy(th_arena *arena) {
+	th_arena_chunk *c,*next;
+	if (arena==NULL)
+		return;
+	for (c=arena->head; c!=NULL; c=next) {
+		next=c->next;
+		free(c);
+	}
+	free(arena);
+}
+
+/* Function: th_arena_attach
+	Serve further allocations of the calling thread from arena. 
+	Pass NULL to go back to libc allocations.
+*/
+void th_arena_attach(th_arena *arena) {
+	th_cur_arena=arena;
+}
+
+/* Function: th_arena_reset
+	Release all memory allocated from the arena in O(1). 
+	Chunks are kept and reused by following allocations.
+*/
+void th_arena_reset(th_arena *arena) {
+	arena->cur=arena->head;
+	arena->head->used=0;
+	arena->last=NULL;
+	arena->in_use=0;
+	arena->stats.resets++;
+}
+
+/* Function: th_arena_get_stats
+	Copy the statistics of an arena. Only valid once the owning context stopped allocating.
+*/
+void th_arena_get_stats(th_arena *arena, th_arena_stats *stats) {
+	th_memcpy(stats,&arena->stats,sizeof(th_arena_stats));
+}
+
+/* move to the next chunk that can hold need bytes, adding a chunk if none is available */
+static th_arena_chunk *th_arena_next_chunk(th_arena *arena, size_t need) {
+	th_arena_chunk *c=arena->cur->next;
+	while (c!=NULL && c->size<need)
+		c=c->next;
+	if (c==NULL) {
+		c=th_arena_new_chunk(arena,(need>arena->chunk_size) ? need : arena->chunk_size);
+		c->next=arena->cur->next;
+		arena->cur->next=c;
+	}
+	c->used=0;
+	arena->cur=c;
+	return c;
+}
+
+static void *th_arena_alloc(th_arena *arena, size_t size) {
+	size_t need=TH_ARENA_HDR+((size+TH_ARENA_ALIGN-1) & ~(size_t)(TH_ARENA_ALIGN-1));
+	th_arena_chunk *c=arena->cur;
+	char *p;
+	if (c->used+need > c->size)
+		c=th_arena_next_chunk(arena,need);
+	p=c->data+c->used;
+	c->used+=need;
+	((th_arena_hdr *)p)->size=size;
+	((th_arena_hdr *)p)->arena=arena;
+	p+=TH_ARENA_HDR;
+	arena->last=p;
+	arena->in_use+=need;
+	if (arena->in_use>arena->stats.peak)
+		arena->stats.peak=arena->in_use;
+	arena->stats.allocs++;
+	return p;
+}
+
+#define TH_ARENA_BLOCK_NEED(p) (TH_ARENA_HDR+((TH_ARENA_BLOCK(p)->size+TH_ARENA_ALIGN-1) & ~(size_t)(TH_ARENA_ALIGN-1)))
+
+/* Only the thread the arena is attached to may reclaim a block, a free from any other thread 
+	(helper threads, or blocks of another context) is counted and the block is left for the next reset. */
+static void th_arena_free(th_arena *arena, char *p) {
+	al_atomic_add(&arena->stats.frees,1);
+	if (arena==th_cur_arena && p==arena->last) {
+		size_t need=TH_ARENA_BLOCK_NEED(p);
+		arena->cur->used-=need;
+		arena->in_use-=need;
+		arena->last=NULL;
+	}
+}
+
+static void *th_arena_realloc(th_arena *arena, char *p, size_t size) {
+	size_t old=TH_ARENA_BLOCK(p)->size;
+	void *ret;
+	if (p==arena->last) {
+		/* grow or shrink the most recent block in place */
+		size_t old_need=TH_ARENA_BLOCK_NEED(p);
+		size_t need=TH_ARENA_HDR+((size+TH_ARENA_ALIGN-1) & ~(size_t)(TH_ARENA_ALIGN-1));
+		th_arena_chunk *c=arena->cur;
+		if (c->used-old_need+need <= c->size) {
+			c->used=c->used-old_need+need;
+			arena->in_use=arena->in_use-old_need+need;
+			if (arena->in_use>arena->stats.peak)
+				arena->stats.peak=arena->in_use;
+			TH_ARENA_BLOCK(p)->size=size;
+			return p;
+		}
+	}
+	ret=th_arena_alloc(arena,size);
+	th_memcpy(ret,p,(old<size) ? old : size);
+	al_atomic_add(&arena->stats.frees,1);
+	return ret;
+}
+
+/* libc blocks get a header too, with no arena */
+static void *th_libc_alloc(void *p, size_t size) {
+	th_arena_hdr *h=(th_arena_hdr *)p;
+	if (h==NULL)
+		return NULL;
+	h->size=size;
+	h->arena=NULL;
+	return (char *)h+TH_ARENA_HDR;
+}
+#define th_libc_malloc(size) th_libc_alloc(malloc(TH_ARENA_HDR+(size)),size)
+#define th_libc_calloc(nmemb,size) th_libc_alloc(calloc(1,TH_ARENA_HDR+(nmemb)*(size)),(nmemb)*(size))
+#define th_libc_realloc(p,size) ((p)==NULL ? th_libc_malloc(size) : \
+	th_libc_alloc(realloc(TH_ARENA_BLOCK(p),TH_ARENA_HDR+(size)),size))
+#define th_libc_free(p) free(TH_ARENA_BLOCK(p))
+#else
+#define th_libc_malloc(size) malloc(size)
+#define th_libc_calloc(nmemb,size) calloc(nmemb,size)
+#define th_libc_realloc(p,size) realloc(p,size)
+#define th_libc_free(p) free(p)
+#endif
+
 /**
  * function: th_malloc_x
  *
@@ -779,7 +976,11 @@ void *th_malloc_x( size_t size, const char *file, int line )
 	   /* avoid warnings since we are not using these */
 	   file=file; 
 	   line=line;
-   p=malloc( size); /* file, line );*/
+#if USE_TH_ARENA
+	if (th_cur_arena)
+		return th_arena_alloc(th_cur_arena,size);
+#endif
+   p=th_libc_malloc( size); /* file, line );*/
 #if REPORT_THMALLOC_STATS
 	if (size==0) {
 		th_printf("Malloc of 0 from %s:%d\n",file,line);
@@ -916,7 +1117,14 @@ void *th_calloc_x( size_t nmemb, size_t size, const char *file, int line )
 	/* avoid warnings since we are not using these */
 	   file=file; 
 	   line=line;
-	p=calloc( nmemb, size); /*, file, line );*/
+#if USE_TH_ARENA
+	if (th_cur_arena) {
+		p=th_arena_alloc(th_cur_arena,nmemb*size);
+		th_memset(p,0,nmemb*size);
+		return p;
+	}
+#endif
+	p=th_libc_calloc( nmemb, size); /*, file, line );*/
 #if THDEBUG>2
    if (p==NULL)
 	   th_printf("calloc failed from %s:%d\n",file,line);
@@ -964,7 +1172,22 @@ void *th_realloc_x( void *ptr, size_t size, const char *file, int line )
 	/* avoid warnings since we are not using these */
 	   file=file; 
 	   line=line;
-	   ret=realloc( ptr, size);
+#if USE_TH_ARENA
+	if (ptr==NULL && th_cur_arena)
+		return th_arena_alloc(th_cur_arena,size);
+	if (ptr!=NULL && TH_ARENA_BLOCK(ptr)->arena!=NULL) {
+		th_arena *owner=TH_ARENA_BLOCK(ptr)->arena;
+		size_t old=TH_ARENA_BLOCK(ptr)->size;
+		if (owner==th_cur_arena)
+			return th_arena_realloc(owner,ptr,size);
+		/* the arena of the block is no longer attached, move the block */
+		ret=th_malloc_x(size,file,line);
+		th_memcpy(ret,ptr,(old<size) ? old : size);
+		th_arena_free(owner,ptr);
+		return ret;
+	}
+#endif
+	   ret=th_libc_realloc( ptr, size);
 #if REPORT_THMALLOC_STATS
 	if (th_malloc_sizes==NULL)
 		init_thmalloc_stats();
@@ -1014,7 +1237,17 @@ char *th_strdup_x( const char *string, const char *file, int line ){
 	/* avoid warnings since we are not using these */
 	   file=file; 
 	   line=line;
+#if USE_TH_ARENA
+	{
+		size_t len=th_strlen(string)+1;
+		char *p=th_cur_arena ? th_arena_alloc(th_cur_arena,len) : th_libc_malloc(len);
+		if (p!=NULL)
+			th_memcpy(p,string,len);
+		return p;
+	}
+#else
 	return strdup( string); /*, file, line )*/
+#endif
 }
 /** Function: Test Harness free()
  *
@@ -1045,6 +1278,14 @@ void th_free_x( void *block, const char *file, int line ) {
 #if THDEBUG>2
 	th_printf("Free %08x from %s:%d\n",block,file,line);
 #endif
+#if USE_TH_ARENA
+	if (block==NULL)
+		return;
+	if (TH_ARENA_BLOCK(block)->arena!=NULL) {
+		th_arena_free(TH_ARENA_BLOCK(block)->arena,block);
+		return;
+	}
+#endif
 #if REPORT_THMALLOC_STATS
 	if (th_malloc_sizes==NULL)
 		init_thmalloc_stats();
@@ -1055,7 +1296,7 @@ void th_free_x( void *block, const char *file, int line ) {
 	}
 	al_mutex_unlock(&th_malloc_mutex);
 #endif
-	free ( block ); /*, file, line );*/
+	th_libc_free ( block ); /*, file, line );*/
 }
 
 
@@ -55,6 +55,8 @@ endif
 #Flag: PLATFORM_DEFINES 
 #	Use PLATFORM_DEFINES to set platform specific compiler flags. E.g. set the timer resolution to millisecs with TIMER_RES_DIVIDER=1000
 #	Or add HAVE_PTHREAD_SETAFFINITY_NP=1 HAVE_PTHREAD_SELF=1 to enable affinity (must port the relevant functions in <mith/al/src/al_smp.c>.
+#	Add HAVE_SYSFS_TOPOLOGY=1 as well to enable the topology aware placement policies (run with -P=affinity=compact|scatter|physcore|sticky).
+#	Add HAVE_MMAP_COW=1 to map shared inputs read only, with copy on write private views (see <mith_input_share>).
 PLATFORM_DEFINES = EE_SIZEOF_INT=4 EE_SIZEOF_LONG=8
 
 # Flag: CMD_SEP
@@ -74,6 +74,7 @@ int main(int argc, char *argv[])
 	   overrides for num_iterations, num_contexts,
 	   and bench iterations for all items */
 	{ e_s32 stmp;
+	char *sched_name;
 	th_parse_flag_unsigned(argc,argv,"-i",&workload->iterations);
 	th_parse_flag_unsigned(argc,argv,"-c",&num_contexts);
 	th_parse_flag_unsigned(argc,argv,"-w",&num_workers);
@@ -81,6 +82,8 @@ int main(int argc, char *argv[])
 	th_parse_flag_unsigned(argc,argv,"-o",&oversubscribe_allowed);
 	th_parse_flag_unsigned(argc,argv,"-v",&verify_output);
 	th_parse_flag_unsigned(argc,argv,"-V",&reporting_threshold);
+	if (th_get_flag(argc,argv,"-S=",&sched_name) && !mith_set_scheduler(sched_name))
+		th_exit(TH_ERROR,"Unknown scheduler %s",sched_name);
 	if (th_parse_flag(argc,argv,"-pgo=",&stmp)) 
 		pgo_training_run=stmp;
 	}
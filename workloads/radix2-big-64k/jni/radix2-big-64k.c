@@ -67,6 +67,7 @@ jstring Java_com_eembc_coremark_Scenario1_radix2big64k(JNIEnv* env, jobject thiz
 	char dataname_buf[MITH_MAX_NAME];
 	char *dataname;
 	char *hardware_desc;
+	char *sched_name;
 	int orig_dataname=1;
 	void *retval;
 	unsigned i;
@@ -125,6 +126,8 @@ jstring Java_com_eembc_coremark_Scenario1_radix2big64k(JNIEnv* env, jobject thiz
 	th_parse_flag_unsigned(argc,argv,"-o",&oversubscribe_allowed);
 	th_parse_flag_unsigned(argc,argv,"-v",&verify_output);
 	th_parse_flag_unsigned(argc,argv,"-V",&reporting_threshold);
+	if (th_get_flag(argc,argv,"-S=",&sched_name) && !mith_set_scheduler(sched_name))
+		th_exit(TH_ERROR,"Unknown scheduler %s",sched_name);
 	/* check command line for hardware specific information */
 	if (th_get_flag(argc,argv,"-P=",&hardware_desc)) {
 		al_set_hardware_info(hardware_desc);